@@ -0,0 +1,108 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "freebusyindex.h"
+#include "freebusymultiqueryjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+QDateTime time(int hour, int minute = 0)
+{
+    return QDateTime({2018, 4, 1}, {hour, minute, 0}, QTimeZone::UTC);
+}
+
+}
+
+class FreeBusyMultiQueryJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testQuery()
+    {
+        FakeNetworkAccessManager::Scenario scenario(QUrl(QStringLiteral("https://www.googleapis.com/calendar/v3/freeBusy?prettyPrint=false")),
+                                                    QNetworkAccessManager::PostOperation,
+                                                    R"({
+                                                        "items": [{"id": "room1"}, {"id": "room2"}, {"id": "room3"}],
+                                                        "timeMax": "2018-04-01T18:00:00Z",
+                                                        "timeMin": "2018-04-01T08:00:00Z"
+                                                    })",
+                                                    200,
+                                                    R"({
+                                                        "kind": "calendar#freeBusy",
+                                                        "calendars": {
+                                                            "room1": {"busy": [{"start": "2018-04-01T10:00:00Z", "end": "2018-04-01T11:00:00Z"},
+                                                                               {"start": "2018-04-01T09:00:00Z", "end": "2018-04-01T10:30:00Z"}]},
+                                                            "room2": {"busy": [{"start": "2018-04-01T12:00:00Z", "end": "2018-04-01T13:00:00Z"}]},
+                                                            "room3": {"errors": [{"domain": "global", "reason": "notFound"}], "busy": []}
+                                                        }
+                                                    })");
+        scenario.responseHeaders = {{"Content-Type", "application/json; charset=UTF-8"}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new FreeBusyMultiQueryJob({QStringLiteral("room1"), QStringLiteral("room2"), QStringLiteral("room3"), QStringLiteral("room1")},
+                                             time(8),
+                                             time(18),
+                                             account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->failedIds(), QStringList{QStringLiteral("room3")});
+
+        const FreeBusyIndex busy = job->busy();
+        QCOMPARE(busy.calendars(), (QStringList{QStringLiteral("room1"), QStringLiteral("room2")}));
+        QCOMPARE(busy.busy(QStringLiteral("room1")), FreeBusyQueryJob::BusyRangeList{{time(9), time(11)}});
+        QCOMPARE(busy.busy(QStringLiteral("room2")), FreeBusyQueryJob::BusyRangeList{{time(12), time(13)}});
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testIndex()
+    {
+        FreeBusyIndex index;
+        QVERIFY(index.isEmpty());
+        index.insert(QStringLiteral("a"), {{time(9), time(10)}, {time(13), time(14)}});
+        index.insert(QStringLiteral("b"), {{time(9, 30), time(11)}, {time(11), time(12)}});
+        index.insert(QStringLiteral("c"), {});
+        QCOMPARE(index.calendars(), (QStringList{QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")}));
+
+        QCOMPARE(index.busy(QStringLiteral("b")), FreeBusyQueryJob::BusyRangeList{{time(9, 30), time(12)}});
+        QCOMPARE(index.mergedBusy(), (FreeBusyQueryJob::BusyRangeList{{time(9), time(12)}, {time(13), time(14)}}));
+
+        QCOMPARE(index.busyCalendarsAt(time(8)), QStringList());
+        QCOMPARE(index.busyCalendarsAt(time(9, 45)), (QStringList{QStringLiteral("a"), QStringLiteral("b")}));
+        // Ranges are half-open
+        QCOMPARE(index.busyCalendarsAt(time(10)), QStringList{QStringLiteral("b")});
+        QCOMPARE(index.busyCalendarsAt(time(12)), QStringList());
+
+        // 30 minutes fit right before the first busy range
+        QCOMPARE(index.firstFreeSlot(time(8), time(18), 30 * 60), time(8));
+        // The gap between 12:00 and 13:00 is too short
+        QCOMPARE(index.firstFreeSlot(time(9), time(18), 90 * 60), time(14));
+        QCOMPARE(index.firstFreeSlot(time(9), time(18), 60 * 60), time(12));
+        QCOMPARE(index.firstFreeSlot(time(10), time(15), 2 * 60 * 60), QDateTime());
+        QCOMPARE(index.firstFreeSlot(time(13, 30), time(16), 2 * 60 * 60), time(14));
+    }
+};
+
+QTEST_GUILESS_MAIN(FreeBusyMultiQueryJobTest)
+
+#include "freebusymultiqueryjobtest.moc"
@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "createjob.h"
+#include "private/gzip_p.h"
+#include "transferstatistics.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+
+QByteArray jsonData()
+{
+    QByteArray data = "{\"items\": [";
+    for (int i = 0; i < 100; ++i) {
+        data += "{\"kind\": \"test#item\", \"id\": \"" + QByteArray::number(i) + "\"},";
+    }
+    data.chop(1);
+    return data + "]}";
+}
+
+}
+
+class TestCreateJob : public CreateJob
+{
+    Q_OBJECT
+
+public:
+    TestCreateJob(const QByteArray &data, QObject *parent = nullptr)
+        : CreateJob(AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken")), parent)
+        , mData(data)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl), mData, QStringLiteral("application/json"));
+    }
+
+    QByteArray response() const
+    {
+        return mResponse;
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponse = rawData;
+        emitFinished();
+    }
+
+private:
+    QByteArray mData;
+    QByteArray mResponse;
+};
+
+class CompressionTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void init()
+    {
+        TransferStatistics::instance()->reset();
+    }
+
+    void testGzip()
+    {
+        const QByteArray data = jsonData();
+        const QByteArray compressed = Gzip::compress(data);
+        QVERIFY(!compressed.isEmpty());
+        QVERIFY(compressed.size() < data.size());
+        // gzip magic
+        QVERIFY(compressed.startsWith("\x1f\x8b"));
+        QCOMPARE(Gzip::decompress(compressed), data);
+
+        QVERIFY(Gzip::decompress("not compressed").isNull());
+        QVERIFY(Gzip::decompress(compressed.left(compressed.size() / 2)).isNull());
+    }
+
+    void testCompressedReply()
+    {
+        const QByteArray data = jsonData();
+        const QByteArray compressed = Gzip::compress(data);
+
+        FakeNetworkAccessManager::Scenario scenario(ResourceUrl, QNetworkAccessManager::PostOperation, "{}", KGAPI2::OK, compressed);
+        scenario.requestHeaders = {{"Accept-Encoding", "gzip"}, {"User-Agent", "libkgapi (gzip)"}};
+        scenario.responseHeaders = {{"Content-Encoding", "gzip"}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto job = new TestCreateJob("{}");
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), data);
+
+        auto stats = TransferStatistics::instance();
+        QCOMPARE(stats->compressedResponseBytes(), qint64(compressed.size()));
+        QCOMPARE(stats->decompressedResponseBytes(), qint64(data.size()));
+        QCOMPARE(stats->bytesSaved(), qint64(data.size() - compressed.size()));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testCompressedRequest_data()
+    {
+        QTest::addColumn<int>("threshold");
+        QTest::addColumn<bool>("compressed");
+
+        QTest::newRow("disabled") << -1 << false;
+        QTest::newRow("below threshold") << int(jsonData().size()) << false;
+        QTest::newRow("above threshold") << 1024 << true;
+    }
+
+    void testCompressedRequest()
+    {
+        QFETCH(int, threshold);
+        QFETCH(bool, compressed);
+
+        const QByteArray data = jsonData();
+        FakeNetworkAccessManager::Scenario scenario(ResourceUrl,
+                                                    QNetworkAccessManager::PostOperation,
+                                                    compressed ? Gzip::compress(data) : data,
+                                                    KGAPI2::OK,
+                                                    R"({"ok": true})");
+        if (compressed) {
+            scenario.requestHeaders = {{"Content-Encoding", "gzip"}};
+        }
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto job = new TestCreateJob(data);
+        job->setRequestCompressionThreshold(threshold);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        auto stats = TransferStatistics::instance();
+        QCOMPARE(stats->uncompressedRequestBytes(), compressed ? qint64(data.size()) : qint64(0));
+        QCOMPARE(stats->compressedRequestBytes() > 0, compressed);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(CompressionTest)
+
+#include "compressiontest.moc"
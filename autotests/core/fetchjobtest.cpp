@@ -4,14 +4,24 @@
  * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
  */
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
 #include <QObject>
+#include <QPointer>
+#include <QSignalSpy>
 #include <QTest>
+#include <QThread>
+
+#include <atomic>
 
 #include "fakenetworkaccessmanagerfactory.h"
 #include "testutils.h"
 
 #include "account.h"
 #include "fetchjob.h"
+#include "object.h"
 
 Q_DECLARE_METATYPE(QList<FakeNetworkAccessManager::Scenario>)
 
@@ -58,6 +68,161 @@ private:
     QByteArray mResponse;
 };
 
+class TestMultiFetchJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestMultiFetchJob(const QList<QUrl> &urls, QObject *parent = nullptr)
+        : FetchJob(parent)
+        , mUrls(urls)
+    {
+    }
+
+    TestMultiFetchJob(const QList<QUrl> &urls, const QUrl &batchUrl, QObject *parent = nullptr)
+        : FetchJob(parent)
+        , mUrls(urls)
+    {
+        setBatchUrl(batchUrl);
+    }
+
+    void start() override
+    {
+        for (const auto &url : std::as_const(mUrls)) {
+            enqueueRequest(QNetworkRequest(url));
+        }
+    }
+
+    QList<QByteArray> responses() const
+    {
+        return mResponses;
+    }
+
+    QList<bool> pendingDispatches() const
+    {
+        return mPendingDispatches;
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponses << rawData;
+        // Whether there were requests not yet sent when this reply was received
+        mPendingDispatches << FakeNetworkAccessManagerFactory::get()->hasScenario();
+    }
+
+private:
+    QList<QUrl> mUrls;
+    QList<QByteArray> mResponses;
+    QList<bool> mPendingDispatches;
+};
+
+class TestPagedFetchJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestPagedFetchJob(const QUrl &url, QObject *parent = nullptr)
+        : FetchJob(parent)
+        , mUrl(url)
+    {
+    }
+
+    void start() override
+    {
+        enablePipelinedPagination();
+        enqueueRequest(QNetworkRequest(mUrl));
+    }
+
+    QList<int> dispatchedRequests() const
+    {
+        return mDispatchedRequests;
+    }
+
+protected:
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override
+    {
+        ++mDispatched;
+        FetchJob::dispatchRequest(accessManager, request, data, contentType);
+    }
+
+    ObjectsList handleReplyWithItems(const QNetworkReply *, const QByteArray &) override
+    {
+        // How many requests had been sent when this page was being parsed
+        mDispatchedRequests << mDispatched;
+        return {ObjectPtr::create()};
+    }
+
+private:
+    QUrl mUrl;
+    int mDispatched = 0;
+    QList<int> mDispatchedRequests;
+};
+
+class TestThreadedFetchJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestThreadedFetchJob(const QUrl &url, QObject *parent = nullptr)
+        : FetchJob(parent)
+        , mUrl(url)
+    {
+        setParseInThreadPool(true);
+    }
+
+    void start() override
+    {
+        enablePipelinedPagination();
+        enqueueRequest(QNetworkRequest(mUrl));
+    }
+
+    bool parsedInJobThread() const
+    {
+        return mParsedInJobThread;
+    }
+
+    QStringList parsedFeeds() const
+    {
+        return mParsedFeeds;
+    }
+
+protected:
+    ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override
+    {
+        QThread *jobThread = thread();
+        parseItemsInThreadPool(
+            reply,
+            rawData,
+            [this, jobThread](const QByteArray &data, FeedData &feedData) {
+                const QJsonObject feed = QJsonDocument::fromJson(data).object();
+                // The first page takes the longest to parse, but its items must still come first
+                if (!feed.contains(QStringLiteral("delay"))) {
+                    QThread::msleep(100);
+                }
+                mParsedInJobThread = mParsedInJobThread || QThread::currentThread() == jobThread;
+                feedData.syncToken = feed.value(QStringLiteral("syncToken")).toString();
+
+                ObjectsList items;
+                const QJsonArray array = feed.value(QStringLiteral("items")).toArray();
+                for (const auto &item : array) {
+                    auto object = ObjectPtr::create();
+                    object->setEtag(item.toObject().value(QStringLiteral("id")).toString());
+                    items << object;
+                }
+                return items;
+            },
+            [this](const FeedData &feedData) {
+                mParsedFeeds << feedData.syncToken;
+            });
+        return {};
+    }
+
+private:
+    QUrl mUrl;
+    std::atomic<bool> mParsedInJobThread = false;
+    QStringList mParsedFeeds;
+};
+
 class FetchJobTest : public QObject
 {
     Q_OBJECT
@@ -138,6 +303,282 @@ private Q_SLOTS:
 
         QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
     }
+
+    void testConcurrentRequests_data()
+    {
+        QTest::addColumn<int>("maxConcurrentRequests");
+        QTest::addColumn<QList<bool>>("pendingDispatches");
+
+        QTest::newRow("sequential") << 1 << QList<bool>{true, true, false};
+        QTest::newRow("concurrent") << 3 << QList<bool>{false, false, false};
+    }
+
+    void testConcurrentRequests()
+    {
+        QFETCH(int, maxConcurrentRequests);
+        QFETCH(QList<bool>, pendingDispatches);
+
+        Scenarios scenarios;
+        QList<QUrl> urls;
+        QList<QByteArray> responses;
+        for (int i = 0; i < 3; ++i) {
+            const QString url = QStringLiteral("https://example.test/item/%1").arg(i);
+            urls << QUrl(url);
+            responses << QByteArray("Item ") + QByteArray::number(i);
+            scenarios << FakeNetworkAccessManager::Scenario{QUrl(url + QStringLiteral("?prettyPrint=false")),
+                                                            QNetworkAccessManager::GetOperation,
+                                                            {},
+                                                            200,
+                                                            responses.last(),
+                                                            false};
+        }
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto job = new TestMultiFetchJob(urls);
+        job->setMaxConcurrentRequests(maxConcurrentRequests);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->responses(), responses);
+        QCOMPARE(job->pendingDispatches(), pendingDispatches);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testBatchRequest()
+    {
+        QList<QUrl> urls;
+        QByteArray batchRequest;
+        for (int i = 0; i < 3; ++i) {
+            urls << QUrl(QStringLiteral("https://example.test/item/%1").arg(i));
+            batchRequest += "--batch_kgapi\r\n"
+                            "Content-Type: application/http\r\n"
+                            "Content-ID: <item-"
+                + QByteArray::number(i + 1)
+                + ">\r\n\r\n"
+                  "GET /item/"
+                + QByteArray::number(i)
+                + "?prettyPrint=false HTTP/1.1\r\n"
+                  "User-Agent: libkgapi (gzip)\r\n"
+                  "Accept-Encoding: gzip\r\n"
+                  "\r\n"
+                  "\r\n";
+        }
+        batchRequest += "--batch_kgapi--\r\n";
+
+        // Responses in a batch may arrive in any order
+        const QByteArray batchResponse =
+            "--batch_response\r\n"
+            "Content-Type: application/http\r\n"
+            "Content-ID: <response-item-2>\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "\r\n"
+            "Item 1\r\n"
+            "--batch_response\r\n"
+            "Content-Type: application/http\r\n"
+            "Content-ID: <response-item-1>\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "\r\n"
+            "Item 0\r\n"
+            "--batch_response\r\n"
+            "Content-Type: application/http\r\n"
+            "Content-ID: <response-item-3>\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "\r\n"
+            "Item 2\r\n"
+            "--batch_response--\r\n";
+
+        FakeNetworkAccessManager::Scenario scenario(QUrl(QStringLiteral("https://example.test/batch")),
+                                                    QNetworkAccessManager::PostOperation,
+                                                    batchRequest,
+                                                    200,
+                                                    batchResponse,
+                                                    false);
+        scenario.requestHeaders = {{"Content-Type", "multipart/mixed; boundary=batch_kgapi"}};
+        scenario.responseHeaders = {{"Content-Type", "multipart/mixed; boundary=batch_response"}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto job = new TestMultiFetchJob(urls, QUrl(QStringLiteral("https://example.test/batch")));
+        job->setMaxBatchSize(3);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->responses(), (QList<QByteArray>{"Item 0", "Item 1", "Item 2"}));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testPipelinedPagination()
+    {
+        const Scenarios scenarios{{QUrl(QStringLiteral("https://example.test/feed?q=test&prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"nextPageToken": "page2", "items": [{"id": "1"}]})",
+                                   false},
+                                  {QUrl(QStringLiteral("https://example.test/feed?q=test&pageToken=page2&prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"items": [{"id": "2", "nextPageToken": "nested"}], "nextPageToken": "page3"})",
+                                   false},
+                                  {QUrl(QStringLiteral("https://example.test/feed?q=test&pageToken=page3&prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"items": [{"id": "3"}]})",
+                                   false}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto job = new TestPagedFetchJob(QUrl(QStringLiteral("https://example.test/feed?q=test")));
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        // The next page must be on the wire before the current page is parsed
+        QCOMPARE(job->dispatchedRequests(), (QList<int>{2, 3, 3}));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testItemsAvailable_data()
+    {
+        QTest::addColumn<bool>("retainItems");
+
+        QTest::newRow("retain items") << true;
+        QTest::newRow("discard items") << false;
+    }
+
+    void testItemsAvailable()
+    {
+        QFETCH(bool, retainItems);
+
+        const Scenarios scenarios{{QUrl(QStringLiteral("https://example.test/feed?prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"nextPageToken": "page2", "items": [{"id": "1"}]})",
+                                   false},
+                                  {QUrl(QStringLiteral("https://example.test/feed?pageToken=page2&prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"items": [{"id": "2"}]})",
+                                   false}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto job = new TestPagedFetchJob(QUrl(QStringLiteral("https://example.test/feed")));
+        job->setRetainItems(retainItems);
+        QSignalSpy itemsSpy(job, &FetchJob::itemsAvailable);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        QCOMPARE(itemsSpy.size(), 2);
+        ObjectsList streamedItems;
+        for (const auto &args : std::as_const(itemsSpy)) {
+            QCOMPARE(args.at(0).value<Job *>(), job);
+            streamedItems << args.at(1).value<ObjectsList>();
+        }
+        QCOMPARE(streamedItems.size(), 2);
+        QCOMPARE(job->items(), retainItems ? streamedItems : ObjectsList());
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testParseInThreadPool()
+    {
+        const Scenarios scenarios{{QUrl(QStringLiteral("https://example.test/feed?prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"nextPageToken": "page2", "items": [{"id": "1"}, {"id": "2"}]})",
+                                   false},
+                                  {QUrl(QStringLiteral("https://example.test/feed?pageToken=page2&prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   R"({"delay": false, "items": [{"id": "3"}], "syncToken": "sync"})",
+                                   false}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto job = new TestThreadedFetchJob(QUrl(QStringLiteral("https://example.test/feed")));
+        QSignalSpy itemsSpy(job, &FetchJob::itemsAvailable);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!job->parsedInJobThread());
+
+        // Items are delivered in the order of the replies, after the FeedData of their reply
+        QStringList etags;
+        for (const auto &args : std::as_const(itemsSpy)) {
+            for (const auto &item : args.at(1).value<ObjectsList>()) {
+                etags << item->etag();
+            }
+        }
+        QCOMPARE(etags, (QStringList{QStringLiteral("1"), QStringLiteral("2"), QStringLiteral("3")}));
+        QCOMPARE(job->items().size(), 3);
+        QCOMPARE(job->parsedFeeds(), (QStringList{QString(), QStringLiteral("sync")}));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testConcurrentJobsShareManager()
+    {
+        const Scenarios scenarios{{QUrl(QStringLiteral("https://example.test/first?prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   "First",
+                                   false},
+                                  {QUrl(QStringLiteral("https://example.test/second?prettyPrint=false")),
+                                   QNetworkAccessManager::GetOperation,
+                                   {},
+                                   200,
+                                   "Second",
+                                   false}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto first = new TestFetchJob(QUrl(QStringLiteral("https://example.test/first")));
+        auto second = new TestFetchJob(QUrl(QStringLiteral("https://example.test/second")));
+        QVERIFY(execJob(first));
+        if (second->isRunning()) {
+            QVERIFY(execJob(second));
+        }
+
+        // Each reply must be delivered only to the job that has sent the request
+        QCOMPARE(first->response(), QByteArray("First"));
+        QCOMPARE(second->response(), QByteArray("Second"));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testDeleteAbortsRequests()
+    {
+        const QUrl url(QStringLiteral("https://example.test/slow?prettyPrint=false"));
+        FakeNetworkAccessManager::Scenario scenario{url, QNetworkAccessManager::GetOperation, {}, 200, "Slow", false};
+        scenario.delay = 60 * 1000;
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto job = new TestFetchJob(QUrl(QStringLiteral("https://example.test/slow")));
+        QTRY_VERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QPointer<QNetworkReply> reply;
+        const auto replies = NetworkAccessManagerFactory::instance()->sharedNetworkAccessManager()->findChildren<QNetworkReply *>();
+        for (auto candidate : replies) {
+            if (candidate->url() == url) {
+                reply = candidate;
+            }
+        }
+        QVERIFY(reply);
+        QVERIFY(!reply->isFinished());
+
+        // The manager is shared, so the request must not outlive the job
+        delete job;
+        QVERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::OperationCanceledError);
+        QTRY_VERIFY(reply.isNull());
+    }
 };
 
 QTEST_GUILESS_MAIN(FetchJobTest)
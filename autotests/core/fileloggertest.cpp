@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "fetchjob.h"
+#include "private/filelogger_p.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+
+}
+
+class TestLoggedJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestLoggedJob(const AccountPtr &account, QObject *parent = nullptr)
+        : FetchJob(account, parent)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl));
+    }
+
+protected:
+    ObjectsList handleReplyWithItems(const QNetworkReply *, const QByteArray &) override
+    {
+        return {};
+    }
+};
+
+class FileLoggerTest : public QObject
+{
+    Q_OBJECT
+private:
+    QList<QJsonObject> readLog()
+    {
+        FileLogger::self()->flush();
+
+        QFile file(mDir.filePath(QStringLiteral("session.log.")) + QString::number(QCoreApplication::applicationPid()));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+
+        QList<QJsonObject> records;
+        const auto lines = file.readAll().split('\n');
+        for (const auto &line : lines) {
+            if (!line.isEmpty()) {
+                records << QJsonDocument::fromJson(line).object();
+            }
+        }
+        return records;
+    }
+
+    QTemporaryDir mDir;
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY(mDir.isValid());
+        // The logger reads the environment only once, when it's first used
+        qputenv("KGAPI_SESSION_LOGFILE", mDir.filePath(QStringLiteral("session.log")).toLocal8Bit());
+        qputenv("KGAPI_SESSION_LOG_MAX_BODY", "64");
+        QVERIFY(FileLogger::self()->isEnabled());
+
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testRequestAndReply()
+    {
+        const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {FakeNetworkAccessManager::Scenario(ResourceUrl, QNetworkAccessManager::GetOperation, {}, KGAPI2::OK, R"({"kind": "test#resource"})")});
+        auto job = new TestLoggedJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        const auto records = readLog();
+        QVERIFY(records.size() >= 2);
+        const auto request = records.at(records.size() - 2);
+        const auto reply = records.last();
+
+        QCOMPARE(request.value(QStringLiteral("type")).toString(), QStringLiteral("request"));
+        QCOMPARE(request.value(QStringLiteral("url")).toString(), ResourceUrl.toString());
+        QCOMPARE(request.value(QStringLiteral("headers")).toObject().value(QStringLiteral("Authorization")).toString(), QStringLiteral("Bearer <redacted>"));
+
+        QCOMPARE(reply.value(QStringLiteral("type")).toString(), QStringLiteral("reply"));
+        QCOMPARE(reply.value(QStringLiteral("id")), request.value(QStringLiteral("id")));
+        QCOMPARE(reply.value(QStringLiteral("method")).toString(), QStringLiteral("GET"));
+        QCOMPARE(reply.value(QStringLiteral("status")).toInt(), int(KGAPI2::OK));
+        QCOMPARE(reply.value(QStringLiteral("body")).toString(), QStringLiteral(R"({"kind": "test#resource"})"));
+    }
+
+    void testRedactedBody()
+    {
+        QNetworkRequest request(QUrl(QStringLiteral("https://oauth2.googleapis.com/token")));
+        FileLogger::self()->logRequest(request, "client_id=id&client_secret=secret&refresh_token=token");
+
+        const auto record = readLog().last();
+        QCOMPARE(record.value(QStringLiteral("body")).toString(), QStringLiteral("client_id=id&client_secret=<redacted>&refresh_token=<redacted>"));
+
+        FileLogger::self()->logRequest(request, R"({"access_token": "token", "expires_in": 3599})");
+        QCOMPARE(readLog().last().value(QStringLiteral("body")).toString(), QStringLiteral(R"({"access_token": "<redacted>", "expires_in": 3599})"));
+    }
+
+    void testTruncatedBody()
+    {
+        const QByteArray body(100, 'a');
+        FileLogger::self()->logRequest(QNetworkRequest(ResourceUrl), body);
+
+        const auto record = readLog().last();
+        QCOMPARE(record.value(QStringLiteral("size")).toInt(), 100);
+        QCOMPARE(record.value(QStringLiteral("body")).toString(), QString::fromLatin1(body.left(64)));
+        QVERIFY(record.value(QStringLiteral("truncated")).toBool());
+    }
+
+    void testBinaryBody()
+    {
+        const QByteArray body("\x1f\x8b\x08\x00\xff", 5);
+        FileLogger::self()->logRequest(QNetworkRequest(ResourceUrl), body);
+
+        const auto record = readLog().last();
+        QVERIFY(!record.contains(QStringLiteral("body")));
+        QCOMPARE(QByteArray::fromBase64(record.value(QStringLiteral("bodyBase64")).toString().toLatin1()), body);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileLoggerTest)
+
+#include "fileloggertest.moc"
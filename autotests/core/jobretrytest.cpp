@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "job.h"
+
+Q_DECLARE_METATYPE(QList<FakeNetworkAccessManager::Scenario>)
+
+using Scenarios = QList<FakeNetworkAccessManager::Scenario>;
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+
+FakeNetworkAccessManager::Scenario scenario(QNetworkAccessManager::Operation method, int responseCode, const QByteArray &response = {})
+{
+    return FakeNetworkAccessManager::Scenario(ResourceUrl, method, method == QNetworkAccessManager::PostOperation ? "data" : "", responseCode, response, false);
+}
+
+FakeNetworkAccessManager::Scenario networkError(QNetworkAccessManager::Operation method, QNetworkReply::NetworkError error)
+{
+    auto s = scenario(method, 0);
+    s.networkError = error;
+    return s;
+}
+
+}
+
+class TestRetryJob : public Job
+{
+    Q_OBJECT
+
+public:
+    explicit TestRetryJob(QNetworkAccessManager::Operation method, QObject *parent = nullptr)
+        : Job(parent)
+        , mMethod(method)
+    {
+        setRetryDelay(10);
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(QUrl(QStringLiteral("https://www.googleapis.com/test/resource"))), "data");
+    }
+
+    QByteArray response() const
+    {
+        return mResponse;
+    }
+
+protected:
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &) override
+    {
+        if (mMethod == QNetworkAccessManager::PostOperation) {
+            accessManager->post(request, data);
+        } else {
+            accessManager->get(request);
+        }
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponse = rawData;
+        emitFinished();
+    }
+
+private:
+    QNetworkAccessManager::Operation mMethod;
+    QByteArray mResponse;
+};
+
+class TestMultiRetryJob : public Job
+{
+    Q_OBJECT
+
+public:
+    explicit TestMultiRetryJob(int count, QObject *parent = nullptr)
+        : Job(parent)
+        , mCount(count)
+    {
+        setRetryDelay(10);
+    }
+
+    void start() override
+    {
+        for (int i = 0; i < mCount; ++i) {
+            enqueueRequest(QNetworkRequest(QUrl(QStringLiteral("https://www.googleapis.com/test/item/%1").arg(i))));
+        }
+    }
+
+    QList<QByteArray> responses() const
+    {
+        return mResponses;
+    }
+
+protected:
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &, const QString &) override
+    {
+        accessManager->get(request);
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponses << rawData;
+    }
+
+private:
+    int mCount;
+    QList<QByteArray> mResponses;
+};
+
+class JobRetryTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testRetry_data()
+    {
+        const auto Get = QNetworkAccessManager::GetOperation;
+        const auto Post = QNetworkAccessManager::PostOperation;
+
+        QTest::addColumn<int>("method");
+        QTest::addColumn<int>("maxRetries");
+        QTest::addColumn<Scenarios>("scenarios");
+        QTest::addColumn<int>("error");
+
+        QTest::newRow("internal error") << int(Get) << 3 << Scenarios{scenario(Get, KGAPI2::InternalError), scenario(Get, KGAPI2::OK, "ok")}
+                                        << int(KGAPI2::NoError);
+        QTest::newRow("bad gateway") << int(Get) << 3 << Scenarios{scenario(Get, KGAPI2::BadGateway), scenario(Get, KGAPI2::OK, "ok")} << int(KGAPI2::NoError);
+        QTest::newRow("gateway timeout") << int(Get) << 3
+                                         << Scenarios{scenario(Get, KGAPI2::GatewayTimeout),
+                                                      scenario(Get, KGAPI2::GatewayTimeout),
+                                                      scenario(Get, KGAPI2::OK, "ok")}
+                                         << int(KGAPI2::NoError);
+        QTest::newRow("connection closed") << int(Get) << 3
+                                           << Scenarios{networkError(Get, QNetworkReply::RemoteHostClosedError), scenario(Get, KGAPI2::OK, "ok")}
+                                           << int(KGAPI2::NoError);
+        QTest::newRow("too many retries") << int(Get) << 2
+                                          << Scenarios{scenario(Get, KGAPI2::InternalError),
+                                                       scenario(Get, KGAPI2::InternalError),
+                                                       scenario(Get, KGAPI2::InternalError)}
+                                          << int(KGAPI2::InternalError);
+        QTest::newRow("retries disabled") << int(Get) << 0 << Scenarios{scenario(Get, KGAPI2::InternalError)} << int(KGAPI2::InternalError);
+        QTest::newRow("permanent network error") << int(Get) << 3 << Scenarios{networkError(Get, QNetworkReply::SslHandshakeFailedError)}
+                                                 << int(KGAPI2::NetworkError);
+        QTest::newRow("post internal error") << int(Post) << 3 << Scenarios{scenario(Post, KGAPI2::InternalError)} << int(KGAPI2::InternalError);
+        QTest::newRow("post connection closed") << int(Post) << 3 << Scenarios{networkError(Post, QNetworkReply::RemoteHostClosedError)}
+                                                << int(KGAPI2::NetworkError);
+        QTest::newRow("post connection refused") << int(Post) << 3
+                                                 << Scenarios{networkError(Post, QNetworkReply::ConnectionRefusedError), scenario(Post, KGAPI2::OK, "ok")}
+                                                 << int(KGAPI2::NoError);
+    }
+
+    void testRetry()
+    {
+        QFETCH(int, method);
+        QFETCH(int, maxRetries);
+        QFETCH(Scenarios, scenarios);
+        QFETCH(int, error);
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        auto job = new TestRetryJob(static_cast<QNetworkAccessManager::Operation>(method));
+        job->setMaxRetries(maxRetries);
+        QVERIFY(execJob(job));
+        QCOMPARE(int(job->error()), error);
+        if (error == KGAPI2::NoError) {
+            QCOMPARE(job->response(), QByteArray("ok"));
+        }
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        delete job;
+    }
+
+    void testRetryKeepsOrder()
+    {
+        const auto item = [](int index, int responseCode, const QByteArray &response) {
+            return FakeNetworkAccessManager::Scenario(QUrl(QStringLiteral("https://www.googleapis.com/test/item/%1?prettyPrint=false").arg(index)),
+                                                      QNetworkAccessManager::GetOperation,
+                                                      {},
+                                                      responseCode,
+                                                      response,
+                                                      false);
+        };
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {item(0, KGAPI2::InternalError, {}), item(1, KGAPI2::OK, "1"), item(2, KGAPI2::OK, "2"), item(0, KGAPI2::OK, "0")});
+
+        auto job = new TestMultiRetryJob(3);
+        job->setMaxConcurrentRequests(3);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        // The retried request is handled in its original position, not after the requests sent after it
+        QCOMPARE(job->responses(), (QList<QByteArray>{"0", "1", "2"}));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        delete job;
+    }
+};
+
+QTEST_GUILESS_MAIN(JobRetryTest)
+
+#include "jobretrytest.moc"
@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QJsonDocument>
+#include <QObject>
+#include <QTest>
+
+#include "private/jsonreader_p.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+struct Item {
+    QString id;
+    qint64 size = 0;
+    bool hidden = false;
+    QStringList tags;
+};
+
+bool readItem(JsonReader &reader, Item &item)
+{
+    static const JsonFieldTable<Item> fields{
+        {"id",
+         [](JsonReader &reader, Item &item) {
+             item.id = reader.readString();
+         }},
+        {"size",
+         [](JsonReader &reader, Item &item) {
+             item.size = reader.readInteger();
+         }},
+        {"hidden",
+         [](JsonReader &reader, Item &item) {
+             item.hidden = reader.readBool();
+         }},
+        {"tags",
+         [](JsonReader &reader, Item &item) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     item.tags << reader.readString();
+                 }
+                 reader.endArray();
+             }
+         }},
+    };
+
+    return fields.read(reader, item);
+}
+
+}
+
+class JsonReaderTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testReadVariant_data()
+    {
+        QTest::addColumn<QByteArray>("json");
+
+        QTest::newRow("empty object") << QByteArray("{}");
+        QTest::newRow("empty array") << QByteArray("[ ]");
+        QTest::newRow("scalars") << QByteArray(R"({"s": "string", "i": 42, "n": -7, "d": 1.5, "e": 2E3, "t": true, "f": false, "z": null})");
+        QTest::newRow("nested") << QByteArray(R"({"a": [1, [2, {"b": []}], {}], "c": {"d": {"e": "f"}}})");
+        QTest::newRow("escapes") << QByteArray(R"({"quote\"d": "line\nbreak \\ \/ \t é € 😀"})");
+        QTest::newRow("utf8") << QByteArray("{\"name\": \"Vr\xc3\xa1til\"}");
+        QTest::newRow("whitespace") << QByteArray(" \r\n\t{ \"a\" :\n1 ,\"b\":[ 1 , 2 ] }\n");
+    }
+
+    void testReadVariant()
+    {
+        QFETCH(QByteArray, json);
+
+        JsonReader reader(json);
+        const QVariant variant = reader.readVariant();
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QVERIFY(reader.atEnd());
+        QCOMPARE(variant, QJsonDocument::fromJson(json).toVariant());
+    }
+
+    void testFieldTable()
+    {
+        const QByteArray json = R"([
+            {"id": "first", "size": "12345678901", "hidden": true, "tags": ["a", "b"], "unknown": {"id": "nested"}},
+            {"unknown": [1, "]", {"}": "{"}], "id": "second", "size": 3},
+            null,
+            {}
+        ])";
+
+        JsonReader reader(json);
+        QList<Item> items;
+        QVERIFY(reader.beginArray());
+        while (reader.hasNext()) {
+            Item item;
+            readItem(reader, item);
+            items << item;
+        }
+        QVERIFY(reader.endArray());
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QVERIFY(reader.atEnd());
+
+        QCOMPARE(items.size(), 4);
+        QCOMPARE(items[0].id, QStringLiteral("first"));
+        QCOMPARE(items[0].size, qint64(12345678901));
+        QCOMPARE(items[0].hidden, true);
+        QCOMPARE(items[0].tags, (QStringList{QStringLiteral("a"), QStringLiteral("b")}));
+        QCOMPARE(items[1].id, QStringLiteral("second"));
+        QCOMPARE(items[1].size, qint64(3));
+        QCOMPARE(items[1].hidden, false);
+        QVERIFY(items[2].id.isEmpty());
+        QVERIFY(items[3].id.isEmpty());
+    }
+
+    void testConversions()
+    {
+        const QByteArray json = R"({"number": 10, "string": "true", "object": {"a": 1}, "bool": true, "null": null})";
+
+        JsonReader reader(json);
+        QVERIFY(reader.beginObject());
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("number"));
+        QCOMPARE(reader.readString(), QStringLiteral("10"));
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("string"));
+        QCOMPARE(reader.readBool(), true);
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("object"));
+        QCOMPARE(reader.readString(), QString());
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("bool"));
+        QCOMPARE(reader.readInteger(), qint64(1));
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("null"));
+        QVERIFY(!reader.beginObject());
+        QVERIFY(!reader.hasNext());
+        QVERIFY(reader.endObject());
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+
+    void testRawValue()
+    {
+        const QByteArray json = R"({"items": [{"id": "a"}, {"id": "b"}], "after": 1})";
+
+        JsonReader reader(json);
+        QVERIFY(reader.beginObject());
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("items"));
+        const QByteArrayView items = reader.readRawValue();
+        QCOMPARE(items.toByteArray(), QByteArray(R"([{"id": "a"}, {"id": "b"}])"));
+        QVERIFY(reader.hasNext());
+        QCOMPARE(reader.nextName().toByteArray(), QByteArrayLiteral("after"));
+        QCOMPARE(reader.readInteger(), qint64(1));
+        QVERIFY(reader.endObject());
+
+        JsonReader itemsReader(items);
+        QCOMPARE(itemsReader.readVariant().toList().size(), 2);
+        QVERIFY(!itemsReader.hasError());
+    }
+
+    void testErrors_data()
+    {
+        QTest::addColumn<QByteArray>("json");
+
+        QTest::newRow("empty") << QByteArray();
+        QTest::newRow("unterminated object") << QByteArray(R"({"a": 1)");
+        QTest::newRow("unterminated string") << QByteArray(R"({"a": "b})");
+        QTest::newRow("missing colon") << QByteArray(R"({"a" 1})");
+        QTest::newRow("missing comma") << QByteArray(R"([1 2])");
+        QTest::newRow("trailing comma") << QByteArray(R"([1, 2,])");
+        QTest::newRow("invalid literal") << QByteArray(R"({"a": nul})");
+        QTest::newRow("invalid escape") << QByteArray(R"({"a": "\x"})");
+        QTest::newRow("garbage") << QByteArray(R"({"a": @})");
+    }
+
+    void testErrors()
+    {
+        QFETCH(QByteArray, json);
+
+        JsonReader reader(json);
+        reader.readVariant();
+        QVERIFY(reader.hasError());
+        QVERIFY(!reader.errorString().isEmpty());
+        QVERIFY(!reader.hasNext());
+    }
+};
+
+QTEST_GUILESS_MAIN(JsonReaderTest)
+
+#include "jsonreadertest.moc"
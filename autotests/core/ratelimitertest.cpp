@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "fetchjob.h"
+#include "ratelimiter.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+
+FakeNetworkAccessManager::Scenario resourceScenario(int responseCode, const QByteArray &response)
+{
+    return FakeNetworkAccessManager::Scenario(ResourceUrl, QNetworkAccessManager::GetOperation, {}, responseCode, response);
+}
+
+}
+
+class TestResourceJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestResourceJob(const AccountPtr &account, QObject *parent = nullptr)
+        : FetchJob(account, parent)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl));
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponse = rawData;
+    }
+
+    QByteArray response() const
+    {
+        return mResponse;
+    }
+
+private:
+    QByteArray mResponse;
+};
+
+class RateLimiterTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testUnlimited()
+    {
+        auto limiter = RateLimiter::instance();
+        QCOMPARE(limiter->requestsPerSecond(QStringLiteral("unlimited.example.com")), 0.0);
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(limiter->acquire(QStringLiteral("account"), QStringLiteral("unlimited.example.com")), qint64(0));
+        }
+    }
+
+    void testTokenBucket()
+    {
+        auto limiter = RateLimiter::instance();
+        const QString host = QStringLiteral("bucket.example.com");
+        limiter->setRequestsPerSecond(host, 10, 2);
+
+        // The bucket starts full
+        QCOMPARE(limiter->acquire(QStringLiteral("account1"), host), qint64(0));
+        QCOMPARE(limiter->acquire(QStringLiteral("account1"), host), qint64(0));
+        const qint64 wait = limiter->acquire(QStringLiteral("account1"), host);
+        QVERIFY(wait > 0);
+        QVERIFY(wait <= 100);
+
+        // Other accounts have their own bucket
+        QCOMPARE(limiter->acquire(QStringLiteral("account2"), host), qint64(0));
+
+        QTest::qWait(wait + 10);
+        QCOMPARE(limiter->acquire(QStringLiteral("account1"), host), qint64(0));
+    }
+
+    void testBackoff()
+    {
+        auto limiter = RateLimiter::instance();
+        const QString host = QStringLiteral("backoff.example.com");
+        const QString account = QStringLiteral("account");
+
+        const qint64 first = limiter->reportRateLimited(account, host);
+        QVERIFY(first >= 1000);
+        QVERIFY(first <= 2000);
+        QVERIFY(limiter->acquire(account, host) > 0);
+
+        // Requests that were already on the wire don't extend the backoff
+        QVERIFY(limiter->reportRateLimited(account, host) <= first);
+
+        // Retry-After takes precedence
+        QCOMPARE(limiter->reportRateLimited(account, host, 5000), qint64(5000));
+
+        limiter->reportSuccess(account, host);
+        QVERIFY(limiter->acquire(account, host) > 0);
+    }
+
+    void testMaxBackoff()
+    {
+        auto limiter = RateLimiter::instance();
+        const QString host = QStringLiteral("maxbackoff.example.com");
+        const int maxBackoff = limiter->maxBackoff();
+        limiter->setMaxBackoff(500);
+        QCOMPARE(limiter->reportRateLimited(QStringLiteral("account"), host), qint64(500));
+        limiter->setMaxBackoff(maxBackoff);
+    }
+
+    void testJobRetriesAfterTooManyRequests()
+    {
+        auto tooMany = resourceScenario(KGAPI2::TooManyRequests, R"({"error": {"code": 429}})");
+        tooMany.responseHeaders = {{"Retry-After", "1"}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({tooMany, resourceScenario(KGAPI2::OK, R"({"ok": true})")});
+
+        QElapsedTimer timer;
+        timer.start();
+        auto job = new TestResourceJob(AccountPtr::create(QStringLiteral("RetryAccount"), QStringLiteral("Token")));
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), QByteArray(R"({"ok": true})"));
+        QVERIFY(timer.elapsed() >= 1000);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testJobRetriesAfterRateLimitExceeded()
+    {
+        auto forbidden = resourceScenario(KGAPI2::Forbidden, R"({"error": {"code": 403, "errors": [{"reason": "userRateLimitExceeded"}]}})");
+        FakeNetworkAccessManagerFactory::get()->setScenarios({forbidden, resourceScenario(KGAPI2::OK, R"({"ok": true})")});
+
+        auto job = new TestResourceJob(AccountPtr::create(QStringLiteral("ForbiddenAccount"), QStringLiteral("Token")));
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testJobFailsOverMaxTimeout()
+    {
+        auto tooMany = resourceScenario(KGAPI2::QuotaExceeded, R"({"error": {"code": 503, "message": "Quota"}})");
+        tooMany.responseHeaders = {{"Retry-After", "120"}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({tooMany});
+
+        auto job = new TestResourceJob(AccountPtr::create(QStringLiteral("TimeoutAccount"), QStringLiteral("Token")));
+        job->setMaxTimeout(10);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::QuotaExceeded);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testBackoffSharedAcrossJobs()
+    {
+        // Another job of the same account has been told to back off
+        const auto account = AccountPtr::create(QStringLiteral("SharedAccount"), QStringLiteral("Token"));
+        RateLimiter::instance()->reportRateLimited(account->accountName(), ResourceUrl.host(), 1000);
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios({resourceScenario(KGAPI2::OK, R"({"ok": true})")});
+        QElapsedTimer timer;
+        timer.start();
+        auto job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(timer.elapsed() >= 900);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(RateLimiterTest)
+
+#include "ratelimitertest.moc"
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QJsonArray>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "fetchjob.h"
+#include "requestmetrics.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+static const QByteArray Response = R"({"kind": "test#resource"})";
+
+}
+
+class TestMeasuredJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestMeasuredJob(const AccountPtr &account, QObject *parent = nullptr)
+        : FetchJob(account, parent)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl));
+    }
+
+protected:
+    ObjectsList handleReplyWithItems(const QNetworkReply *, const QByteArray &) override
+    {
+        return {};
+    }
+};
+
+class RequestMetricsTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void init()
+    {
+        RequestMetrics::instance()->reset();
+        RequestMetrics::instance()->setEnabled(true);
+    }
+
+    void cleanup()
+    {
+        RequestMetrics::instance()->setEnabled(false);
+    }
+
+    void testJobIsMeasured()
+    {
+        QSignalSpy spy(RequestMetrics::instance(), &RequestMetrics::requestFinished);
+
+        const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {FakeNetworkAccessManager::Scenario(ResourceUrl, QNetworkAccessManager::GetOperation, {}, KGAPI2::OK, Response)});
+        auto job = new TestMeasuredJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        QCOMPARE(spy.size(), 1);
+        const auto timing = spy.at(0).at(0).value<RequestTiming>();
+        QCOMPARE(timing.api, QStringLiteral("www.googleapis.com/test"));
+        QCOMPARE(timing.url, ResourceUrl);
+        QCOMPARE(timing.method, QByteArray("GET"));
+        QCOMPARE(timing.status, int(KGAPI2::OK));
+        QCOMPARE(timing.retries, 0);
+        QCOMPARE(timing.bytesReceived, qint64(Response.size()));
+        QVERIFY(timing.queueWait >= 0);
+        QVERIFY(timing.parse >= 0);
+        QVERIFY(timing.total >= 0);
+
+        QCOMPARE(RequestMetrics::instance()->apis(), QStringList{timing.api});
+        QCOMPARE(RequestMetrics::instance()->requestCount(timing.api), qint64(1));
+        QCOMPARE(RequestMetrics::instance()->histogram(timing.api, RequestMetrics::Total).count, qint64(1));
+    }
+
+    void testDisabled()
+    {
+        RequestMetrics::instance()->setEnabled(false);
+
+        const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {FakeNetworkAccessManager::Scenario(ResourceUrl, QNetworkAccessManager::GetOperation, {}, KGAPI2::OK, Response)});
+        auto job = new TestMeasuredJob(account);
+        QVERIFY(execJob(job));
+
+        QVERIFY(RequestMetrics::instance()->apis().isEmpty());
+    }
+
+    void testHistogram()
+    {
+        const QString api = RequestMetrics::apiForUrl(QUrl(QStringLiteral("https://www.googleapis.com/drive/v3/files")));
+        QCOMPARE(api, QStringLiteral("www.googleapis.com/drive"));
+
+        RequestTiming timing;
+        timing.api = api;
+        timing.status = 200;
+        timing.total = 3000;
+        RequestMetrics::instance()->record(timing);
+        timing.total = 60 * 1000 * 1000;
+        timing.status = 503;
+        timing.retries = 1;
+        RequestMetrics::instance()->record(timing);
+
+        const auto histogram = RequestMetrics::instance()->histogram(api, RequestMetrics::Total);
+        QCOMPARE(histogram.count, qint64(2));
+        QCOMPARE(histogram.sum, qint64(3000 + 60 * 1000 * 1000));
+        QCOMPARE(histogram.buckets.size(), RequestMetrics::bucketBounds().size() + 1);
+        QCOMPARE(histogram.buckets.at(1), qint64(1)); // 1 ms < 3 ms <= 5 ms
+        QCOMPARE(histogram.buckets.last(), qint64(1));
+        // Unknown durations are not counted
+        QCOMPARE(RequestMetrics::instance()->histogram(api, RequestMetrics::Connect).count, qint64(0));
+
+        const QByteArray prometheus = RequestMetrics::instance()->toPrometheus();
+        QVERIFY(prometheus.contains(R"(kgapi_request_duration_seconds_bucket{api="www.googleapis.com/drive",phase="total",le="0.005"} 1)"));
+        QVERIFY(prometheus.contains(R"(kgapi_request_duration_seconds_bucket{api="www.googleapis.com/drive",phase="total",le="+Inf"} 2)"));
+        QVERIFY(prometheus.contains(R"(kgapi_requests_total{api="www.googleapis.com/drive",status="503"} 1)"));
+        QVERIFY(prometheus.contains(R"(kgapi_request_retries_total{api="www.googleapis.com/drive"} 1)"));
+
+        const QJsonObject json = RequestMetrics::instance()->toJson().value(QStringLiteral("apis")).toObject().value(api).toObject();
+        QCOMPARE(json.value(QStringLiteral("requests")).toInt(), 2);
+        QCOMPARE(json.value(QStringLiteral("statuses")).toObject().value(QStringLiteral("200")).toInt(), 1);
+        const QJsonObject total = json.value(QStringLiteral("phases")).toObject().value(QStringLiteral("total")).toObject();
+        QCOMPARE(total.value(QStringLiteral("count")).toInt(), 2);
+        QCOMPARE(total.value(QStringLiteral("buckets")).toArray().size(), histogram.buckets.size());
+    }
+};
+
+QTEST_GUILESS_MAIN(RequestMetricsTest)
+
+#include "requestmetricstest.moc"
@@ -0,0 +1,273 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "fetchjob.h"
+#include "responsecache.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+static const QByteArray Response = R"({"kind": "test#resource", "etag": "\"1\""})";
+
+FakeNetworkAccessManager::Scenario resourceScenario(int responseCode, const QByteArray &response)
+{
+    FakeNetworkAccessManager::Scenario scenario(ResourceUrl, QNetworkAccessManager::GetOperation, {}, responseCode, response);
+    scenario.responseHeaders = {{"ETag", "\"1\""}};
+    return scenario;
+}
+
+}
+
+class TestResourceJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestResourceJob(const AccountPtr &account, QObject *parent = nullptr)
+        : FetchJob(account, parent)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl));
+    }
+
+    QByteArray response() const
+    {
+        return mResponse;
+    }
+
+protected:
+    ObjectsList handleReplyWithItems(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponse = rawData;
+        return {};
+    }
+
+private:
+    QByteArray mResponse;
+};
+
+class TestBatchResourceJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    TestBatchResourceJob(const QList<QUrl> &urls, const QUrl &batchUrl, QObject *parent = nullptr)
+        : FetchJob(parent)
+        , mUrls(urls)
+    {
+        setBatchUrl(batchUrl);
+    }
+
+    void start() override
+    {
+        for (const auto &url : std::as_const(mUrls)) {
+            enqueueRequest(QNetworkRequest(url));
+        }
+    }
+
+    QList<QByteArray> responses() const
+    {
+        return mResponses;
+    }
+
+protected:
+    ObjectsList handleReplyWithItems(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponses << rawData;
+        return {};
+    }
+
+private:
+    QList<QUrl> mUrls;
+    QList<QByteArray> mResponses;
+};
+
+class ResponseCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+        QVERIFY(!ResponseCache::instance()->isEnabled());
+    }
+
+    void init()
+    {
+        ResponseCache::instance()->clear();
+        ResponseCache::instance()->setEnabled(true);
+    }
+
+    void testNotModified()
+    {
+        const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios({resourceScenario(KGAPI2::OK, Response)});
+        auto job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), Response);
+
+        const auto entry = ResponseCache::instance()->find(account->accountName(), ResourceUrl);
+        QVERIFY(entry.isValid());
+        QCOMPARE(entry.etag, QByteArray("\"1\""));
+        QCOMPARE(entry.data, Response);
+
+        // The resource is revalidated and the cached reply is used
+        auto notModified = resourceScenario(KGAPI2::NotModified, {});
+        notModified.requestHeaders = {{"If-None-Match", "\"1\""}};
+        FakeNetworkAccessManagerFactory::get()->setScenarios({notModified});
+        job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), Response);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testNotModifiedWithoutCachedData()
+    {
+        const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+
+        // The resource is fetched again when there is no cached reply to use
+        FakeNetworkAccessManagerFactory::get()->setScenarios({resourceScenario(KGAPI2::NotModified, {}), resourceScenario(KGAPI2::OK, Response)});
+        auto job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), Response);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        ResponseCache::instance()->clear();
+        FakeNetworkAccessManagerFactory::get()->setScenarios({resourceScenario(KGAPI2::NotModified, {}), resourceScenario(KGAPI2::NotModified, {})});
+        job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::UnknownError);
+        QVERIFY(job->response().isEmpty());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testNotModifiedInBatch()
+    {
+        const QUrl batchUrl(QStringLiteral("https://example.test/batch"));
+
+        QList<QUrl> urls;
+        QByteArray batchRequest;
+        for (int i = 0; i < 2; ++i) {
+            urls << QUrl(QStringLiteral("https://example.test/item/%1").arg(i));
+            batchRequest += "--batch_kgapi\r\n"
+                            "Content-Type: application/http\r\n"
+                            "Content-ID: <item-"
+                + QByteArray::number(i + 1)
+                + ">\r\n\r\n"
+                  "GET /item/"
+                + QByteArray::number(i)
+                + "?prettyPrint=false HTTP/1.1\r\n"
+                  "User-Agent: libkgapi (gzip)\r\n"
+                  "Accept-Encoding: gzip\r\n"
+                  "\r\n"
+                  "\r\n";
+        }
+        batchRequest += "--batch_kgapi--\r\n";
+
+        // Parts of a batch reply don't carry the cached body, the first item has to be fetched again
+        const QByteArray batchResponse =
+            "--batch_response\r\n"
+            "Content-Type: application/http\r\n"
+            "Content-ID: <response-item-1>\r\n"
+            "\r\n"
+            "HTTP/1.1 304 Not Modified\r\n"
+            "\r\n"
+            "\r\n"
+            "--batch_response\r\n"
+            "Content-Type: application/http\r\n"
+            "Content-ID: <response-item-2>\r\n"
+            "\r\n"
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain\r\n"
+            "\r\n"
+            "Item 1\r\n"
+            "--batch_response--\r\n";
+
+        FakeNetworkAccessManager::Scenario batch(batchUrl, QNetworkAccessManager::PostOperation, batchRequest, KGAPI2::OK, batchResponse, false);
+        batch.requestHeaders = {{"Content-Type", "multipart/mixed; boundary=batch_kgapi"}};
+        batch.responseHeaders = {{"Content-Type", "multipart/mixed; boundary=batch_response"}};
+        const FakeNetworkAccessManager::Scenario item(QUrl(QStringLiteral("https://example.test/item/0?prettyPrint=false")),
+                                                      QNetworkAccessManager::GetOperation,
+                                                      {},
+                                                      KGAPI2::OK,
+                                                      "Item 0",
+                                                      false);
+        FakeNetworkAccessManagerFactory::get()->setScenarios({batch, item});
+
+        // The item fetched again is still delivered before the items requested after it
+        auto job = new TestBatchResourceJob(urls, batchUrl);
+        job->setMaxBatchSize(2);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->responses(), (QList<QByteArray>{"Item 0", "Item 1"}));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testKeyedByAccount()
+    {
+        ResponseCache::instance()->insert(QStringLiteral("account1"), ResourceUrl, "\"1\"", Response);
+        QVERIFY(ResponseCache::instance()->find(QStringLiteral("account1"), ResourceUrl).isValid());
+        QVERIFY(!ResponseCache::instance()->find(QStringLiteral("account2"), ResourceUrl).isValid());
+
+        ResponseCache::instance()->remove(QStringLiteral("account1"), ResourceUrl);
+        QVERIFY(!ResponseCache::instance()->find(QStringLiteral("account1"), ResourceUrl).isValid());
+    }
+
+    void testDisabled()
+    {
+        ResponseCache::instance()->setEnabled(false);
+        ResponseCache::instance()->insert(QStringLiteral("account"), ResourceUrl, "\"1\"", Response);
+        QVERIFY(!ResponseCache::instance()->find(QStringLiteral("account"), ResourceUrl).isValid());
+    }
+
+    void testDiskCache()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        auto cache = ResponseCache::instance();
+        const qint64 maxMemorySize = cache->maxMemorySize();
+        cache->setCacheDirectory(dir.path());
+        cache->insert(QStringLiteral("account"), ResourceUrl, "\"1\"", Response);
+
+        // Evict everything from memory, the entry is read back from disk
+        cache->setMaxMemorySize(0);
+        const auto entry = cache->find(QStringLiteral("account"), ResourceUrl);
+        QVERIFY(entry.isValid());
+        QCOMPARE(entry.etag, QByteArray("\"1\""));
+        QCOMPARE(entry.data, Response);
+
+        cache->clear();
+        QVERIFY(!cache->find(QStringLiteral("account"), ResourceUrl).isValid());
+
+        cache->setMaxMemorySize(maxMemorySize);
+        cache->setCacheDirectory({});
+    }
+};
+
+QTEST_GUILESS_MAIN(ResponseCacheTest)
+
+#include "responsecachetest.moc"
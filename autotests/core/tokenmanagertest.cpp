@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "fetchjob.h"
+#include "tokenmanager.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl ResourceUrl(QStringLiteral("https://www.googleapis.com/test/resource?prettyPrint=false"));
+
+FakeNetworkAccessManager::Scenario resourceScenario(const QByteArray &token, int responseCode)
+{
+    FakeNetworkAccessManager::Scenario scenario(ResourceUrl,
+                                                QNetworkAccessManager::GetOperation,
+                                                {},
+                                                responseCode,
+                                                responseCode == KGAPI2::OK ? R"({"ok": true})" : R"({"error": {"code": 401}})");
+    scenario.requestHeaders = {{"Authorization", "Bearer " + token}};
+    return scenario;
+}
+
+FakeNetworkAccessManager::Scenario refreshScenario()
+{
+    FakeNetworkAccessManager::Scenario scenario(QUrl(QStringLiteral("https://accounts.google.com/o/oauth2/token?prettyPrint=false")),
+                                                QNetworkAccessManager::PostOperation,
+                                                "client_id=Key1&client_secret=Secret1&refresh_token=RefreshToken&grant_type=refresh_token",
+                                                KGAPI2::OK,
+                                                R"({"access_token": "NewToken", "token_type": "Bearer", "expires_in": 3600})",
+                                                false);
+    return scenario;
+}
+
+AccountPtr createAccount(const QDateTime &expiration = {})
+{
+    auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("OldToken"), QStringLiteral("RefreshToken"));
+    account->setExpireDateTime(expiration);
+    return account;
+}
+
+}
+
+class TestResourceJob : public FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit TestResourceJob(const AccountPtr &account, QObject *parent = nullptr)
+        : FetchJob(account, parent)
+    {
+    }
+
+    void start() override
+    {
+        enqueueRequest(QNetworkRequest(ResourceUrl));
+    }
+
+    void handleReply(const QNetworkReply *, const QByteArray &rawData) override
+    {
+        mResponse = rawData;
+    }
+
+    QByteArray response() const
+    {
+        return mResponse;
+    }
+
+private:
+    QByteArray mResponse;
+};
+
+class TokenManagerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void init()
+    {
+        TokenManager::instance()->setClientCredentials(QStringLiteral("Key1"), QStringLiteral("Secret1"));
+    }
+
+    void testDisabled()
+    {
+        TokenManager::instance()->setClientCredentials({}, {});
+        FakeNetworkAccessManagerFactory::get()->setScenarios({resourceScenario("OldToken", KGAPI2::Unauthorized)});
+
+        auto job = new TestResourceJob(createAccount(QDateTime::currentDateTime().addSecs(-60)));
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::Unauthorized);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testReplayUnauthorized()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {resourceScenario("OldToken", KGAPI2::Unauthorized), refreshScenario(), resourceScenario("NewToken", KGAPI2::OK)});
+
+        const auto account = createAccount();
+        auto job = new TestResourceJob(account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->response(), QByteArray(R"({"ok": true})"));
+        QCOMPARE(account->accessToken(), QStringLiteral("NewToken"));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testReplayOnlyOnce()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {resourceScenario("OldToken", KGAPI2::Unauthorized), refreshScenario(), resourceScenario("NewToken", KGAPI2::Unauthorized)});
+
+        auto job = new TestResourceJob(createAccount());
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::Unauthorized);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testRefreshBeforeExpiration()
+    {
+        // Both jobs wait for the same refresh, even though they don't share the Account object
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {refreshScenario(), resourceScenario("NewToken", KGAPI2::OK), resourceScenario("NewToken", KGAPI2::OK)});
+
+        const auto expiration = QDateTime::currentDateTime().addSecs(60);
+        const auto account1 = createAccount(expiration);
+        const auto account2 = createAccount(expiration);
+        QSignalSpy refreshSpy(TokenManager::instance(), &TokenManager::tokensRefreshed);
+
+        auto job1 = new TestResourceJob(account1);
+        auto job2 = new TestResourceJob(account2);
+        QSignalSpy job2Spy(job2, &Job::finished);
+        QVERIFY(execJob(job1));
+        QVERIFY(job2Spy.count() == 1 || job2Spy.wait());
+        QCOMPARE(job1->error(), KGAPI2::NoError);
+        QCOMPARE(job2->error(), KGAPI2::NoError);
+
+        QCOMPARE(refreshSpy.count(), 2);
+        QCOMPARE(account1->accessToken(), QStringLiteral("NewToken"));
+        QCOMPARE(account2->accessToken(), QStringLiteral("NewToken"));
+        QVERIFY(account2->expireDateTime() > expiration);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(TokenManagerTest)
+
+#include "tokenmanagertest.moc"
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filecontentdevice.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl DownloadUrl(QStringLiteral("https://www.googleapis.com/drive/v2/files/file1?alt=media&prettyPrint=false"));
+static constexpr qint64 BlockSize = 4096;
+
+QByteArray fileContent()
+{
+    QByteArray content;
+    for (int i = 0; i < 10000; ++i) {
+        content += QByteArray::number(i);
+    }
+    return content;
+}
+
+Drive::FilePtr fileWithContent(const QByteArray &content)
+{
+    const QByteArray json = R"({"kind": "drive#file", "id": "file1", "downloadUrl": "https://www.googleapis.com/drive/v2/files/file1?alt=media", "fileSize": ")"
+        + QByteArray::number(content.size()) + R"("})";
+    return Drive::File::fromJSON(json);
+}
+
+FakeNetworkAccessManager::Scenario blockScenario(const QByteArray &content, qint64 index)
+{
+    const qint64 first = index * BlockSize;
+    const qint64 last = qMin<qint64>(first + BlockSize, content.size()) - 1;
+    FakeNetworkAccessManager::Scenario scenario(DownloadUrl, QNetworkAccessManager::GetOperation, {}, KGAPI2::PartialContent, content.mid(first, last - first + 1));
+    scenario.requestHeaders = {{"Range", "bytes=" + QByteArray::number(first) + '-' + QByteArray::number(last)}};
+    return scenario;
+}
+
+}
+
+class FileContentDeviceTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testRandomAccess()
+    {
+        const QByteArray content = fileContent();
+        // Only the block that is read and the blocks read ahead once the access turns sequential are downloaded
+        FakeNetworkAccessManagerFactory::get()->setScenarios({blockScenario(content, 4),
+                                                              blockScenario(content, 5),
+                                                              blockScenario(content, 6),
+                                                              blockScenario(content, 7),
+                                                              blockScenario(content, 8),
+                                                              blockScenario(content, 9)});
+
+        QTemporaryDir cacheDir;
+        QVERIFY(cacheDir.isValid());
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::FileContentDevice device(fileWithContent(content), account);
+        device.setBlockSize(BlockSize);
+        device.setReadAheadBlocks(2);
+        device.setMaxMemorySize(2 * BlockSize);
+        device.setCacheDirectory(cacheDir.path());
+        QVERIFY(device.open(QIODevice::ReadOnly));
+        QCOMPARE(device.size(), qint64(content.size()));
+
+        QVERIFY(device.seek(20000));
+        QCOMPARE(device.bytesAvailable(), qint64(0));
+        QVERIFY(device.waitForReadyRead(-1));
+        QCOMPARE(device.read(100), content.mid(20000, 100));
+
+        // Sequential read, blocks 5 and 6 are downloaded ahead
+        QCOMPARE(device.read(100), content.mid(20100, 100));
+        QTRY_COMPARE(device.bytesAvailable(), qint64(7 * BlockSize - 20200));
+        QCOMPARE(device.read(7 * BlockSize - 20200), content.mid(20200, 7 * BlockSize - 20200));
+
+        // Blocks evicted from memory are read back from the cache directory
+        QTRY_VERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QTRY_COMPARE(device.bytesAvailable(), qint64(content.size() - 7 * BlockSize));
+        QVERIFY(device.seek(20000));
+        QCOMPARE(device.read(content.size() - 20000), content.mid(20000));
+        QVERIFY(device.atEnd());
+        QCOMPARE(device.downloadedSize(), qint64(content.size() - 4 * BlockSize));
+    }
+
+    void testCloseAbortsFetches()
+    {
+        const QByteArray content = fileContent();
+        auto scenario = blockScenario(content, 0);
+        scenario.delay = 60 * 1000;
+        FakeNetworkAccessManagerFactory::get()->setScenarios({scenario});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::FileContentDevice device(fileWithContent(content), account);
+        device.setBlockSize(BlockSize);
+        QVERIFY(device.open(QIODevice::ReadOnly));
+
+        // Reading a block that is not cached starts downloading it
+        QCOMPARE(device.read(100), QByteArray());
+        QTRY_VERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QList<QPointer<QNetworkReply>> fetches;
+        const auto replies = NetworkAccessManagerFactory::instance()->sharedNetworkAccessManager()->findChildren<QNetworkReply *>();
+        for (auto reply : replies) {
+            if (reply->url() == DownloadUrl && !reply->isFinished()) {
+                fetches << reply;
+            }
+        }
+        QCOMPARE(fetches.size(), 1);
+
+        device.close();
+        for (const auto &reply : std::as_const(fetches)) {
+            QVERIFY(reply);
+            QCOMPARE(reply->error(), QNetworkReply::OperationCanceledError);
+        }
+    }
+
+    void testWriteNotSupported()
+    {
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::FileContentDevice device(fileWithContent(fileContent()), account);
+        QVERIFY(!device.open(QIODevice::ReadWrite));
+    }
+};
+
+QTEST_GUILESS_MAIN(FileContentDeviceTest)
+
+#include "filecontentdevicetest.moc"
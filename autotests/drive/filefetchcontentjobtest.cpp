@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filefetchcontentjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl DownloadUrl(QStringLiteral("https://www.googleapis.com/drive/v2/files/file1?alt=media&prettyPrint=false"));
+
+QByteArray fileContent()
+{
+    QByteArray content;
+    for (int i = 0; i < 10000; ++i) {
+        content += QByteArray::number(i);
+    }
+    return content;
+}
+
+Drive::FilePtr fileWithContent(const QByteArray &content)
+{
+    const QByteArray json = R"({"kind": "drive#file", "id": "file1", "downloadUrl": "https://www.googleapis.com/drive/v2/files/file1?alt=media", "md5Checksum": ")"
+        + QCryptographicHash::hash(content, QCryptographicHash::Md5).toHex() + R"(", "fileSize": ")" + QByteArray::number(content.size()) + R"("})";
+    return Drive::File::fromJSON(json);
+}
+
+FakeNetworkAccessManager::Scenario segmentScenario(int responseCode, const QByteArray &responseData, qint64 first, qint64 last)
+{
+    FakeNetworkAccessManager::Scenario scenario(DownloadUrl, QNetworkAccessManager::GetOperation, {}, responseCode, responseData);
+    scenario.requestHeaders = {{"Range", "bytes=" + QByteArray::number(first) + '-' + QByteArray::number(last)}};
+    return scenario;
+}
+
+FakeNetworkAccessManager::Scenario downloadScenario(int responseCode, const QByteArray &responseData, qint64 offset = 0)
+{
+    FakeNetworkAccessManager::Scenario scenario(DownloadUrl, QNetworkAccessManager::GetOperation, {}, responseCode, responseData);
+    if (offset > 0) {
+        scenario.requestHeaders = {{"Range", "bytes=" + QByteArray::number(offset) + '-'}};
+    }
+    return scenario;
+}
+
+}
+
+class FileFetchContentJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testFetchIntoMemory()
+    {
+        const QByteArray content = fileContent();
+        FakeNetworkAccessManagerFactory::get()->setScenarios({downloadScenario(KGAPI2::OK, content)});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setVerifyChecksum(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->data(), content);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testFetchSlice_data()
+    {
+        QTest::addColumn<int>("responseCode");
+
+        QTest::newRow("range honored") << int(KGAPI2::PartialContent);
+        QTest::newRow("range ignored") << int(KGAPI2::OK);
+    }
+
+    void testFetchSlice()
+    {
+        QFETCH(int, responseCode);
+
+        const QByteArray content = fileContent();
+        const QByteArray response = responseCode == KGAPI2::PartialContent ? content.mid(12345, 1000) : content;
+        FakeNetworkAccessManagerFactory::get()->setScenarios({segmentScenario(responseCode, response, 12345, 13344)});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setResumeOffset(12345);
+        job->setLength(1000);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->data(), content.mid(12345, 1000));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testStreamIntoDevice_data()
+    {
+        QTest::addColumn<int>("responseCode");
+        QTest::addColumn<qint64>("offset");
+        QTest::addColumn<bool>("corrupted");
+        QTest::addColumn<int>("expectedError");
+
+        QTest::newRow("full") << int(KGAPI2::OK) << qint64(0) << false << int(KGAPI2::NoError);
+        QTest::newRow("resumed") << int(KGAPI2::PartialContent) << qint64(12345) << false << int(KGAPI2::NoError);
+        QTest::newRow("range ignored") << int(KGAPI2::OK) << qint64(12345) << false << int(KGAPI2::NoError);
+        QTest::newRow("corrupted") << int(KGAPI2::OK) << qint64(0) << true << int(KGAPI2::InvalidResponse);
+        QTest::newRow("corrupted resumed") << int(KGAPI2::PartialContent) << qint64(12345) << true << int(KGAPI2::InvalidResponse);
+    }
+
+    void testStreamIntoDevice()
+    {
+        QFETCH(int, responseCode);
+        QFETCH(qint64, offset);
+        QFETCH(bool, corrupted);
+        QFETCH(int, expectedError);
+
+        const QByteArray content = fileContent();
+        QByteArray response = responseCode == KGAPI2::PartialContent ? content.mid(offset) : content;
+        if (corrupted) {
+            response[response.size() / 2] = 'X';
+        }
+        FakeNetworkAccessManagerFactory::get()->setScenarios({downloadScenario(responseCode, response, offset)});
+
+        // Data downloaded previously are already in the device
+        QBuffer output;
+        output.open(QIODevice::ReadWrite);
+        output.write(content.left(offset));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setOutputDevice(&output);
+        job->setResumeOffset(offset);
+        job->setVerifyChecksum(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(int(job->error()), expectedError);
+        QVERIFY(job->data().isEmpty());
+        QCOMPARE(job->downloadedSize(), qint64(content.size() - offset));
+        if (!corrupted) {
+            QCOMPARE(output.data(), content);
+        }
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testInterruptedStream_data()
+    {
+        QTest::addColumn<qint64>("offset");
+        QTest::addColumn<QString>("failure");
+
+        QTest::newRow("connection closed") << qint64(0) << QString();
+        QTest::newRow("connection closed resumed") << qint64(12345) << QString();
+        QTest::newRow("network error") << qint64(0) << QStringLiteral("network");
+        QTest::newRow("server error") << qint64(12345) << QStringLiteral("server");
+    }
+
+    void testInterruptedStream()
+    {
+        QFETCH(qint64, offset);
+        QFETCH(QString, failure);
+
+        const QByteArray content = fileContent();
+        const qint64 received = offset + 5000;
+
+        // The connection is closed after the first 5000 bytes have been streamed into the device
+        auto interrupted = downloadScenario(offset > 0 ? KGAPI2::PartialContent : KGAPI2::OK, content.mid(offset, 5000), offset);
+        interrupted.networkError = QNetworkReply::RemoteHostClosedError;
+        QList<FakeNetworkAccessManager::Scenario> scenarios{interrupted};
+        if (failure == QLatin1StringView("network")) {
+            auto error = downloadScenario(0, {}, received);
+            error.networkError = QNetworkReply::ConnectionRefusedError;
+            scenarios << error;
+        } else if (failure == QLatin1StringView("server")) {
+            scenarios << downloadScenario(KGAPI2::BadGateway, R"({"error": {"code": 502, "message": "Backend Error"}})", received);
+        }
+        scenarios << downloadScenario(KGAPI2::PartialContent, content.mid(received), received);
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        QBuffer output;
+        output.open(QIODevice::ReadWrite);
+        output.write(content.left(offset));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setOutputDevice(&output);
+        job->setResumeOffset(offset);
+        job->setVerifyChecksum(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->downloadedSize(), qint64(content.size() - offset));
+        QCOMPARE(output.data(), content);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testSegmented_data()
+    {
+        QTest::addColumn<QString>("failure");
+
+        QTest::newRow("no failure") << QString();
+        QTest::newRow("server error") << QStringLiteral("error");
+        QTest::newRow("incomplete segment") << QStringLiteral("incomplete");
+    }
+
+    void testSegmented()
+    {
+        QFETCH(QString, failure);
+
+        QByteArray content = fileContent();
+        while (content.size() < 3 * 1024 * 1024) {
+            content += content;
+        }
+        content.truncate(3 * 1024 * 1024 + 10);
+
+        // Content is split into three segments of at least 1 MiB
+        const qint64 segmentSize = (content.size() + 2) / 3;
+        auto segment = [&](int i, qint64 from = 0) {
+            const qint64 first = i * segmentSize;
+            const qint64 last = qMin<qint64>(first + segmentSize, content.size()) - 1;
+            return segmentScenario(KGAPI2::PartialContent, content.mid(first + from, last - first - from + 1), first + from, last);
+        };
+
+        QList<FakeNetworkAccessManager::Scenario> scenarios{segment(0), segment(1), segment(2)};
+        if (failure == QLatin1StringView("error")) {
+            scenarios[1].responseCode = KGAPI2::InternalError;
+            scenarios[1].responseData = R"({"error": {"code": 500, "message": "Backend Error"}})";
+            scenarios << segment(1);
+        } else if (failure == QLatin1StringView("incomplete")) {
+            scenarios[1].responseData.truncate(1000);
+            scenarios << segment(1, 1000);
+        }
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        QBuffer output;
+        output.open(QIODevice::ReadWrite);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setOutputDevice(&output);
+        job->setSegmentCount(4);
+        job->setVerifyChecksum(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->downloadedSize(), qint64(content.size()));
+        QCOMPARE(output.data(), content);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testAlreadyCompleted()
+    {
+        const QByteArray content = fileContent();
+        FakeNetworkAccessManagerFactory::get()->setScenarios({downloadScenario(KGAPI2::RangeNotSatisfiable, {}, content.size())});
+
+        QBuffer output;
+        output.open(QIODevice::ReadWrite);
+        output.write(content);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(fileWithContent(content), account);
+        job->setOutputDevice(&output);
+        job->setResumeOffset(content.size());
+        job->setVerifyChecksum(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->downloadedSize(), qint64(0));
+        QCOMPARE(output.data(), content);
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileFetchContentJobTest)
+
+#include "filefetchcontentjobtest.moc"
@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "change.h"
+#include "file.h"
+#include "filemirror.h"
+#include "filemirrorsyncjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QString RootId = QStringLiteral("rootid");
+
+Drive::FilePtr mirroredFile(const QString &id, const QString &title, const QString &parentId, const QString &modifiedDate)
+{
+    QByteArray parents;
+    if (!parentId.isEmpty()) {
+        parents = R"(, "parents": [{"kind": "drive#parentReference", "id": ")" + parentId.toUtf8() + R"(", "isRoot": )"
+            + (parentId == RootId ? "true" : "false") + "}]";
+    }
+    const QByteArray json = R"({"kind": "drive#file", "id": ")" + id.toUtf8() + R"(", "title": ")" + title.toUtf8() + R"(", "modifiedDate": ")"
+        + modifiedDate.toUtf8() + '"' + parents + '}';
+    return Drive::File::fromJSON(json);
+}
+
+QStringList fileIds(const Drive::FilesList &files)
+{
+    QStringList ids;
+    for (const auto &file : files) {
+        ids << file->id();
+    }
+    ids.sort();
+    return ids;
+}
+
+void populate(Drive::FileMirror &mirror)
+{
+    mirror.insert(mirroredFile(QStringLiteral("projects"), QStringLiteral("Projects"), RootId, QStringLiteral("2026-01-01T10:00:00.000Z")));
+    mirror.insert(mirroredFile(QStringLiteral("report"), QStringLiteral("report.pdf"), QStringLiteral("projects"), QStringLiteral("2026-01-03T10:00:00.000Z")));
+    mirror.insert(mirroredFile(QStringLiteral("notes"), QStringLiteral("notes.txt"), RootId, QStringLiteral("2026-01-02T10:00:00.000Z")));
+    mirror.insert(mirroredFile(QStringLiteral("shared"), QStringLiteral("shared.txt"), QString(), QStringLiteral("2026-01-01T10:00:00.000Z")));
+    mirror.setStartChangeId(100);
+}
+
+}
+
+class FileMirrorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testQueries()
+    {
+        Drive::FileMirror mirror;
+        populate(mirror);
+
+        QCOMPARE(mirror.count(), 4);
+        QCOMPARE(mirror.rootFolderId(), RootId);
+        QCOMPARE(fileIds(mirror.children(QStringLiteral("root"))), (QStringList{QStringLiteral("notes"), QStringLiteral("projects")}));
+        QCOMPARE(fileIds(mirror.children(QStringLiteral("projects"))), QStringList{QStringLiteral("report")});
+        QCOMPARE(mirror.path(QStringLiteral("report")), QStringLiteral("/Projects/report.pdf"));
+        QCOMPARE(mirror.path(QStringLiteral("notes")), QStringLiteral("/notes.txt"));
+        QVERIFY(mirror.path(QStringLiteral("shared")).isEmpty());
+        QVERIFY(mirror.path(QStringLiteral("unknown")).isEmpty());
+
+        const auto modified = mirror.modifiedSince(QDateTime(QDate(2026, 1, 1), QTime(12, 0), QTimeZone::UTC));
+        QCOMPARE(modified.size(), 2);
+        QCOMPARE(modified.at(0)->id(), QStringLiteral("notes"));
+        QCOMPARE(modified.at(1)->id(), QStringLiteral("report"));
+    }
+
+    void testApplyChanges()
+    {
+        Drive::FileMirror mirror;
+        populate(mirror);
+
+        const auto moved = mirroredFile(QStringLiteral("report"), QStringLiteral("final.pdf"), RootId, QStringLiteral("2026-01-04T10:00:00.000Z"));
+        const Drive::ChangesList changes{
+            Drive::Change::fromJSON(R"({"kind": "drive#change", "id": "100", "fileId": "notes", "deleted": true})"),
+            Drive::Change::fromJSON(R"({"kind": "drive#change", "id": "101", "fileId": "report", "deleted": false, "file": )" + Drive::File::toJSON(moved)
+                                    + '}'),
+        };
+        mirror.applyChanges(changes);
+
+        QCOMPARE(mirror.startChangeId(), qlonglong(102));
+        QVERIFY(!mirror.file(QStringLiteral("notes")));
+        QVERIFY(mirror.children(QStringLiteral("projects")).isEmpty());
+        QCOMPARE(fileIds(mirror.children(QStringLiteral("root"))), (QStringList{QStringLiteral("projects"), QStringLiteral("report")}));
+        QCOMPARE(mirror.path(QStringLiteral("report")), QStringLiteral("/final.pdf"));
+        QCOMPARE(mirror.modifiedSince(QDateTime(QDate(2026, 1, 3), QTime(12, 0), QTimeZone::UTC)).size(), 1);
+    }
+
+    void testSaveAndLoad()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString storePath = dir.filePath(QStringLiteral("mirror"));
+
+        {
+            Drive::FileMirror mirror(storePath);
+            populate(mirror);
+            QVERIFY(mirror.save());
+        }
+
+        Drive::FileMirror mirror(storePath);
+        QVERIFY(mirror.load());
+        QCOMPARE(mirror.count(), 4);
+        QCOMPARE(mirror.startChangeId(), qlonglong(100));
+        QCOMPARE(mirror.rootFolderId(), RootId);
+        QCOMPARE(mirror.path(QStringLiteral("report")), QStringLiteral("/Projects/report.pdf"));
+
+        Drive::FileMirror missing(dir.filePath(QStringLiteral("missing")));
+        QVERIFY(!missing.load());
+        QVERIFY(!missing.isPopulated());
+    }
+
+    void testSyncChanges()
+    {
+        const QUrl url(
+            QStringLiteral("https://www.googleapis.com/drive/v2/changes?includeDeleted=true&includeSubscribed=true&startChangeId=100&"
+                           "includeItemsFromAllDrives=true&supportsAllDrives=true&prettyPrint=false"));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {FakeNetworkAccessManager::Scenario(url,
+                                                QNetworkAccessManager::GetOperation,
+                                                {},
+                                                KGAPI2::OK,
+                                                R"({"kind": "drive#changeList", "items": [{"kind": "drive#change", "id": "100", "fileId": "notes", "deleted": true}]})")});
+
+        Drive::FileMirror mirror;
+        populate(mirror);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileMirrorSyncJob(&mirror, account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->changes().size(), 1);
+        QCOMPARE(mirror.startChangeId(), qlonglong(101));
+        QVERIFY(!mirror.file(QStringLiteral("notes")));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileMirrorTest)
+
+#include "filemirrortest.moc"
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "fileresumablecreatejob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QUrl SessionOpenUrl(QStringLiteral(
+    "https://www.googleapis.com/upload/drive/v2/files?convert=false&enforceSingleParent=false&ocr=false&pinned=false&useContentAsIndexableText=false&"
+    "supportsAllDrives=true&uploadType=resumable&prettyPrint=false"));
+static const QUrl SessionUrl(QStringLiteral("https://upload.example.test/session?prettyPrint=false"));
+static const QByteArray FileResponse = R"({"kind": "drive#file", "id": "uploadedFileId", "title": "upload.bin"})";
+static const qint64 Chunk = 256 * 1024;
+
+FakeNetworkAccessManager::Scenario openSessionScenario()
+{
+    FakeNetworkAccessManager::Scenario scenario(SessionOpenUrl, QNetworkAccessManager::PostOperation, {}, KGAPI2::OK, {});
+    scenario.responseHeaders = {{"Location", "https://upload.example.test/session"}};
+    return scenario;
+}
+
+FakeNetworkAccessManager::Scenario chunkScenario(const QByteArray &data, qint64 from, qint64 total, int responseCode, qint64 confirmed = -1)
+{
+    const QByteArray range = "bytes " + QByteArray::number(from) + '-' + QByteArray::number(from + data.size() - 1) + '/' + QByteArray::number(total);
+    FakeNetworkAccessManager::Scenario scenario(SessionUrl,
+                                                QNetworkAccessManager::PutOperation,
+                                                data,
+                                                responseCode,
+                                                responseCode == KGAPI2::OK ? FileResponse : QByteArray());
+    scenario.requestHeaders = {{"Content-Range", range}};
+    if (confirmed >= 0) {
+        scenario.responseHeaders = {{"Range", "bytes=0-" + QByteArray::number(confirmed - 1)}};
+    }
+    return scenario;
+}
+
+FakeNetworkAccessManager::Scenario statusScenario(qint64 total, qint64 confirmed)
+{
+    FakeNetworkAccessManager::Scenario scenario(SessionUrl, QNetworkAccessManager::PutOperation, {}, KGAPI2::ResumeIncomplete, {});
+    scenario.requestHeaders = {{"Content-Range", "bytes */" + QByteArray::number(total)}};
+    scenario.responseHeaders = {{"Range", "bytes=0-" + QByteArray::number(confirmed - 1)}};
+    return scenario;
+}
+
+}
+
+class FileResumableCreateJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testChunkedUpload()
+    {
+        // Fake replies are instant, so the chunk size doubles after each chunk
+        const QByteArray data(3 * Chunk + 100, 'a');
+        FakeNetworkAccessManagerFactory::get()->setScenarios({openSessionScenario(),
+                                                              chunkScenario(data.left(Chunk), 0, data.size(), KGAPI2::ResumeIncomplete, Chunk),
+                                                              chunkScenario(data.mid(Chunk, 2 * Chunk), Chunk, data.size(), KGAPI2::ResumeIncomplete, 3 * Chunk),
+                                                              chunkScenario(data.mid(3 * Chunk), 3 * Chunk, data.size(), KGAPI2::OK)});
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(&buffer, account);
+        job->setUploadSize(data.size());
+        QSignalSpy sessionSpy(job, &Drive::FileAbstractResumableJob::sessionStarted);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(sessionSpy.count(), 1);
+        QCOMPARE(job->uploadedSize(), qint64(data.size()));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploadedFileId"));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testRecoverFromServerError()
+    {
+        const QByteArray data(Chunk + 37856, 'b');
+        const qint64 confirmed = Chunk / 2;
+        FakeNetworkAccessManagerFactory::get()->setScenarios({openSessionScenario(),
+                                                              chunkScenario(data.left(Chunk), 0, data.size(), 503),
+                                                              statusScenario(data.size(), confirmed),
+                                                              chunkScenario(data.mid(confirmed), confirmed, data.size(), KGAPI2::OK)});
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(&buffer, account);
+        job->setUploadSize(data.size());
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploadedFileId"));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+
+    void testResumeSession()
+    {
+        const QByteArray data(Chunk + 37856, 'c');
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        QByteArray token;
+        {
+            FakeNetworkAccessManagerFactory::get()->setScenarios({openSessionScenario(), chunkScenario(data.left(Chunk), 0, data.size(), KGAPI2::NotFound)});
+
+            QBuffer buffer;
+            buffer.setData(data);
+            buffer.open(QIODevice::ReadOnly);
+
+            auto job = new Drive::FileResumableCreateJob(&buffer, account);
+            job->setUploadSize(data.size());
+            QVERIFY(job->sessionToken().isEmpty());
+            QVERIFY(execJob(job));
+            QCOMPARE(job->error(), KGAPI2::NotFound);
+            token = job->sessionToken();
+            QVERIFY(!token.isEmpty());
+        }
+
+        // The server has received the first chunk after all, the new job only sends the rest
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {statusScenario(data.size(), Chunk), chunkScenario(data.mid(Chunk), Chunk, data.size(), KGAPI2::OK)});
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+
+        auto job = new Drive::FileResumableCreateJob(&buffer, account);
+        job->setSessionToken(token);
+        QSignalSpy sessionSpy(job, &Drive::FileAbstractResumableJob::sessionStarted);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(sessionSpy.count(), 0);
+        QCOMPARE(job->uploadedSize(), qint64(data.size()));
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploadedFileId"));
+
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileResumableCreateJobTest)
+
+#include "fileresumablecreatejobtest.moc"
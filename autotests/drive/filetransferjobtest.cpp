@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filetransferjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+Q_DECLARE_METATYPE(QList<FakeNetworkAccessManager::Scenario>)
+
+namespace
+{
+
+static const QString UploadUrl = QStringLiteral(
+    "https://www.googleapis.com/upload/drive/v2/files?convert=false&enforceSingleParent=false&ocr=false&pinned=false&useContentAsIndexableText=false&"
+    "supportsAllDrives=true&uploadType=%1&prettyPrint=false");
+static const QUrl SessionUrl(QStringLiteral("https://upload.example.test/session?prettyPrint=false"));
+
+Drive::FilePtr uploadMetadata(const QString &filePath)
+{
+    auto metadata = Drive::FilePtr::create();
+    metadata->setTitle(QFileInfo(filePath).fileName());
+    metadata->setMimeType(QStringLiteral("text/plain"));
+    return metadata;
+}
+
+QString createFile(const QTemporaryDir &dir, const QString &name, qint64 size)
+{
+    const QString filePath = dir.filePath(name);
+    QFile file(filePath);
+    VERIFY_RET(file.open(QIODevice::WriteOnly), {});
+    file.write(QByteArray(size, name.at(0).toLatin1()));
+    return filePath;
+}
+
+QByteArray fileResponse(const QString &filePath)
+{
+    const QString fileName = QFileInfo(filePath).fileName();
+    return R"({"kind": "drive#file", "id": ")" + fileName.toUtf8() + R"(_id", "title": ")" + fileName.toUtf8() + R"("})";
+}
+
+// Upload of a small file through FileCreateJob
+FakeNetworkAccessManager::Scenario multipartScenario(const QString &filePath, int delay = 0)
+{
+    QFile file(filePath);
+    VERIFY_RET(file.open(QIODevice::ReadOnly), {});
+    const auto metadata = uploadMetadata(filePath);
+    const QByteArray boundary = QCryptographicHash::hash(metadata->title().toLatin1(), QCryptographicHash::Md5).toHex();
+    const QByteArray body = "--" + boundary + "\nContent-Type: application/json; charset=UTF-8\n\n" + Drive::File::toJSON(metadata) + "\n\n--" + boundary
+        + "\nContent-Type: text/plain\n\n" + file.readAll() + "\n--" + boundary + "--";
+
+    FakeNetworkAccessManager::Scenario scenario(QUrl(UploadUrl.arg(QStringLiteral("multipart"))),
+                                                QNetworkAccessManager::PostOperation,
+                                                body,
+                                                KGAPI2::OK,
+                                                fileResponse(filePath));
+    scenario.delay = delay;
+    return scenario;
+}
+
+// Upload of a large file through FileResumableCreateJob, sent in a single chunk
+QList<FakeNetworkAccessManager::Scenario> resumableScenarios(const QString &filePath)
+{
+    QFile file(filePath);
+    VERIFY_RET(file.open(QIODevice::ReadOnly), {});
+    const QByteArray data = file.readAll();
+
+    FakeNetworkAccessManager::Scenario openSession(QUrl(UploadUrl.arg(QStringLiteral("resumable"))),
+                                                   QNetworkAccessManager::PostOperation,
+                                                   Drive::File::toJSON(uploadMetadata(filePath)),
+                                                   KGAPI2::OK,
+                                                   {});
+    openSession.responseHeaders = {{"Location", "https://upload.example.test/session"}};
+
+    FakeNetworkAccessManager::Scenario chunk(SessionUrl, QNetworkAccessManager::PutOperation, data, KGAPI2::OK, fileResponse(filePath));
+    chunk.requestHeaders = {{"Content-Range", "bytes 0-" + QByteArray::number(data.size() - 1) + '/' + QByteArray::number(data.size())}};
+    return {openSession, chunk};
+}
+
+}
+
+class FileTransferJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testTransfer()
+    {
+        // With a single transfer at a time the requests are sent in a known order
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file1_copy_request.txt"), QFINDTESTDATA("data/file1_copy_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file2_copy_request.txt"), QFINDTESTDATA("data/file2_copy_response.txt"))});
+
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        const auto file2 = fileFromFile(QFINDTESTDATA("data/file2.json"));
+        const QString missingFile = QStringLiteral("/this/file/does/not/exist");
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTransferJob(account);
+        job->setMaxConcurrentTransfers(1);
+        job->addCopy(file1->id(), fileFromFile(QFINDTESTDATA("data/file1_copy.json")));
+        job->addCopy(file2->id(), fileFromFile(QFINDTESTDATA("data/file2_copy.json")));
+        job->addUpload(missingFile);
+
+        QSignalSpy finishedSpy(job, &Drive::FileTransferJob::fileFinished);
+        QVERIFY(execJob(job));
+
+        QCOMPARE(finishedSpy.count(), 3);
+        const auto files = job->files();
+        QCOMPARE(files.count(), 2);
+        QCOMPARE(*files.value(file1->id()), *fileFromFile(QFINDTESTDATA("data/file1_copy.json")));
+        QCOMPARE(*files.value(file2->id()), *fileFromFile(QFINDTESTDATA("data/file2_copy.json")));
+
+        const auto failed = job->failedTransfers();
+        QCOMPARE(failed.count(), 1);
+        QVERIFY(failed.contains(missingFile));
+    }
+
+    void testConcurrency_data()
+    {
+        QTest::addColumn<int>("maxConcurrentTransfers");
+        QTest::addColumn<qint64>("maxBytesInFlight");
+        QTest::addColumn<bool>("concurrent");
+
+        QTest::newRow("sequential") << 1 << qint64(64 * 1024 * 1024) << false;
+        QTest::newRow("concurrent") << 2 << qint64(64 * 1024 * 1024) << true;
+        QTest::newRow("bytes in flight") << 2 << qint64(1500) << false;
+    }
+
+    void testConcurrency()
+    {
+        QFETCH(int, maxConcurrentTransfers);
+        QFETCH(qint64, maxBytesInFlight);
+        QFETCH(bool, concurrent);
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString file1 = createFile(dir, QStringLiteral("a.txt"), 1000);
+        const QString file2 = createFile(dir, QStringLiteral("b.txt"), 1000);
+        // The replies are delayed, so that both requests would be on the wire at the same time
+        FakeNetworkAccessManagerFactory::get()->setScenarios({multipartScenario(file1, 50), multipartScenario(file2, 50)});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTransferJob(account);
+        job->setMaxConcurrentTransfers(maxConcurrentTransfers);
+        job->setMaxBytesInFlight(maxBytesInFlight);
+        job->addUpload(file1, uploadMetadata(file1));
+        job->addUpload(file2, uploadMetadata(file2));
+
+        // When the first transfer finishes, the request of the second one has been sent only if they run concurrently
+        QList<bool> secondSent;
+        connect(job, &Drive::FileTransferJob::fileFinished, this, [&secondSent]() {
+            secondSent.append(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        });
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        QCOMPARE(secondSent, (QList<bool>{concurrent, true}));
+        QCOMPARE(job->files().count(), 2);
+        QCOMPARE(job->files().value(file1)->id(), QStringLiteral("a.txt_id"));
+        QCOMPARE(job->files().value(file2)->id(), QStringLiteral("b.txt_id"));
+        QVERIFY(job->failedTransfers().isEmpty());
+    }
+
+    void testSmallFilesFirst()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString large = createFile(dir, QStringLiteral("large.txt"), 1500);
+        const QString small = createFile(dir, QStringLiteral("small.txt"), 500);
+        FakeNetworkAccessManagerFactory::get()->setScenarios({multipartScenario(small), multipartScenario(large)});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTransferJob(account);
+        job->setMaxConcurrentTransfers(1);
+        job->addUpload(large, uploadMetadata(large));
+        job->addUpload(small, uploadMetadata(small));
+
+        QSignalSpy finishedSpy(job, &Drive::FileTransferJob::fileFinished);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(finishedSpy.count(), 2);
+        QCOMPARE(finishedSpy.at(0).at(1).toString(), small);
+        QCOMPARE(finishedSpy.at(1).at(1).toString(), large);
+    }
+
+    void testResumableUpload()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString large = createFile(dir, QStringLiteral("large.txt"), 2000);
+        const QString small = createFile(dir, QStringLiteral("small.txt"), 100);
+        FakeNetworkAccessManagerFactory::get()->setScenarios(QList<FakeNetworkAccessManager::Scenario>{multipartScenario(small)} + resumableScenarios(large));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTransferJob(account);
+        job->setMaxConcurrentTransfers(1);
+        job->setResumableThreshold(1000);
+        job->addUpload(large, uploadMetadata(large));
+        job->addUpload(small, uploadMetadata(small));
+
+        QSignalSpy fileProgressSpy(job, &Drive::FileTransferJob::fileProgress);
+        QSignalSpy transferProgressSpy(job, &Drive::FileTransferJob::transferProgress);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->files().count(), 2);
+        QCOMPARE(job->files().value(small)->id(), QStringLiteral("small.txt_id"));
+        QCOMPARE(job->files().value(large)->id(), QStringLiteral("large.txt_id"));
+
+        // The resumable upload reports the progress of the file
+        QVERIFY(!fileProgressSpy.isEmpty());
+        const auto lastFileProgress = fileProgressSpy.constLast();
+        QCOMPARE(lastFileProgress.at(1).toString(), large);
+        QCOMPARE(lastFileProgress.at(2).toLongLong(), qint64(2000));
+        QCOMPARE(lastFileProgress.at(3).toLongLong(), qint64(2000));
+
+        QCOMPARE(job->bytesTransferred(), qint64(2100));
+        QVERIFY(job->bytesPerSecond() > 0);
+        QVERIFY(!transferProgressSpy.isEmpty());
+        const auto lastTransferProgress = transferProgressSpy.constLast();
+        QCOMPARE(lastTransferProgress.at(1).toLongLong(), qint64(2100));
+        QCOMPARE(lastTransferProgress.at(2).toLongLong(), qint64(2100));
+        QVERIFY(lastTransferProgress.at(3).toLongLong() > 0);
+    }
+
+    void testNothingToTransfer()
+    {
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTransferJob(account);
+        QVERIFY(execJob(job));
+        QVERIFY(job->files().isEmpty());
+        QVERIFY(job->failedTransfers().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileTransferJobTest)
+
+#include "filetransferjobtest.moc"
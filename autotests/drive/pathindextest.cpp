@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "change.h"
+#include "file.h"
+#include "pathindex.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const QString RootId = QStringLiteral("rootid");
+
+Drive::FilePtr indexedFile(const QString &id, const QString &title, const QString &parentId, bool folder = false)
+{
+    const QByteArray mimeType = folder ? "application/vnd.google-apps.folder" : "text/plain";
+    const QByteArray json = R"({"kind": "drive#file", "id": ")" + id.toUtf8() + R"(", "title": ")" + title.toUtf8() + R"(", "mimeType": ")" + mimeType
+        + R"(", "parents": [{"kind": "drive#parentReference", "id": ")" + parentId.toUtf8() + R"(", "isRoot": )" + (parentId == RootId ? "true" : "false")
+        + "}]}";
+    return Drive::File::fromJSON(json);
+}
+
+}
+
+class PathIndexTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testResolve()
+    {
+        Drive::PathIndex index;
+        QCOMPARE(index.rootFolderId(), QStringLiteral("root"));
+
+        index.insert(indexedFile(QStringLiteral("projects"), QStringLiteral("Projects"), RootId, true));
+        index.insert(indexedFile(QStringLiteral("2026"), QStringLiteral("2026"), QStringLiteral("projects"), true));
+        index.insert(indexedFile(QStringLiteral("report"), QStringLiteral("report.pdf"), QStringLiteral("2026")));
+        QCOMPARE(index.rootFolderId(), RootId);
+
+        QString fileId;
+        int depth = -1;
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/2026/report.pdf"), &fileId, &depth), Drive::PathIndex::Found);
+        QCOMPARE(fileId, QStringLiteral("report"));
+        QCOMPARE(depth, 3);
+        QCOMPARE(index.path(QStringLiteral("report")), QStringLiteral("/Projects/2026/report.pdf"));
+        QCOMPARE(index.path(RootId), QStringLiteral("/"));
+
+        // The rest of the path has to be looked up on the server
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/2025/report.pdf"), &fileId, &depth), Drive::PathIndex::Unknown);
+        QCOMPARE(fileId, QStringLiteral("projects"));
+        QCOMPARE(depth, 1);
+
+        index.insertMissing(QStringLiteral("projects"), QStringLiteral("2025"));
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/2025/report.pdf")), Drive::PathIndex::NotFound);
+
+        // Inserting the file invalidates the negative entry
+        index.insert(indexedFile(QStringLiteral("2025"), QStringLiteral("2025"), QStringLiteral("projects"), true));
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/2025/report.pdf"), &fileId, &depth), Drive::PathIndex::Unknown);
+        QCOMPARE(depth, 2);
+
+        index.setFolderListed(QStringLiteral("2025"));
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/2025/report.pdf")), Drive::PathIndex::NotFound);
+    }
+
+    void testRootAlias()
+    {
+        Drive::PathIndex index;
+        index.insertMissing(QStringLiteral("root"), QStringLiteral("Missing"));
+        QCOMPARE(index.resolve(QStringLiteral("/Missing")), Drive::PathIndex::NotFound);
+
+        // Once the ID of the root folder is known, it replaces the alias
+        index.insert(indexedFile(QStringLiteral("notes"), QStringLiteral("notes.txt"), RootId));
+        QCOMPARE(index.resolve(QStringLiteral("/Missing")), Drive::PathIndex::NotFound);
+        QCOMPARE(index.children(QStringLiteral("root")), QStringList{QStringLiteral("notes")});
+        QCOMPARE(index.path(QStringLiteral("notes")), QStringLiteral("/notes.txt"));
+    }
+
+    void testDuplicateTitles()
+    {
+        Drive::PathIndex index;
+        index.insert(indexedFile(QStringLiteral("folder"), QStringLiteral("Docs"), RootId, true));
+        index.insert(indexedFile(QStringLiteral("file"), QStringLiteral("Docs"), RootId));
+
+        QString fileId;
+        QCOMPARE(index.lookup(RootId, QStringLiteral("Docs"), &fileId), Drive::PathIndex::Found);
+        QCOMPARE(fileId, QStringLiteral("folder"));
+    }
+
+    void testApplyChanges()
+    {
+        Drive::PathIndex index;
+        index.insert(indexedFile(QStringLiteral("projects"), QStringLiteral("Projects"), RootId, true));
+        index.insert(indexedFile(QStringLiteral("report"), QStringLiteral("report.pdf"), QStringLiteral("projects")));
+        index.insert(indexedFile(QStringLiteral("notes"), QStringLiteral("notes.txt"), RootId));
+
+        index.applyChanges({
+            Drive::Change::fromJSON(R"({"kind": "drive#change", "id": "1", "fileId": "notes", "deleted": true})"),
+            Drive::Change::fromJSON(R"({"kind": "drive#change", "id": "2", "fileId": "report", "deleted": false, "file": {
+                "kind": "drive#file", "id": "report", "title": "final.pdf", "mimeType": "application/pdf",
+                "parents": [{"kind": "drive#parentReference", "id": "rootid", "isRoot": true}]}})"),
+        });
+
+        QVERIFY(!index.contains(QStringLiteral("notes")));
+        QCOMPARE(index.resolve(QStringLiteral("/notes.txt")), Drive::PathIndex::Unknown);
+        QCOMPARE(index.resolve(QStringLiteral("/Projects/report.pdf")), Drive::PathIndex::Unknown);
+        QCOMPARE(index.path(QStringLiteral("report")), QStringLiteral("/final.pdf"));
+    }
+};
+
+QTEST_GUILESS_MAIN(PathIndexTest)
+
+#include "pathindextest.moc"
@@ -19,6 +19,14 @@ FakeNetworkAccessManager::FakeNetworkAccessManager(QObject *parent)
 }
 
 QNetworkReply *FakeNetworkAccessManager::createRequest(Operation op, const QNetworkRequest &originalReq, QIODevice *outgoingData)
+{
+    // Like QNetworkAccessManager, own the replies
+    QNetworkReply *reply = createFakeReply(op, originalReq, outgoingData);
+    reply->setParent(this);
+    return reply;
+}
+
+QNetworkReply *FakeNetworkAccessManager::createFakeReply(Operation op, const QNetworkRequest &originalReq, QIODevice *outgoingData)
 {
     auto namFactory = dynamic_cast<FakeNetworkAccessManagerFactory *>(KGAPI2::NetworkAccessManagerFactory::instance());
     VERIFY2_RET(namFactory, "NAMFactory is nto a FakeNetworkAccessManagerFactory!", new FakeNetworkReply(op, originalReq));
@@ -70,7 +78,7 @@ QNetworkReply *FakeNetworkAccessManager::createRequest(Operation op, const QNetw
         }
     }
 
-    return new FakeNetworkReply(scenario);
+    return new FakeNetworkReply(scenario, originalReq);
 }
 
 #include "moc_fakenetworkaccessmanager.cpp"
@@ -9,6 +9,7 @@
 #include <QByteArray>
 #include <QList>
 #include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include <QUrl>
 
 class FakeNetworkAccessManager : public QNetworkAccessManager
@@ -45,6 +46,10 @@ public:
         QList<QPair<QByteArray, QByteArray>> responseHeaders;
         QByteArray responseData;
         bool needsAuth = true;
+        // Simulates a request that has failed without reply from the server
+        QNetworkReply::NetworkError networkError = QNetworkReply::NoError;
+        // Delays the reply by the given msecs, simulates a request that is still on the wire
+        int delay = 0;
     };
 
     explicit FakeNetworkAccessManager(QObject *parent = nullptr);
@@ -53,5 +58,7 @@ protected:
     QNetworkReply *createRequest(Operation op, const QNetworkRequest &originalReq, QIODevice *outgoingData) override;
 
 private:
+    QNetworkReply *createFakeReply(Operation op, const QNetworkRequest &originalReq, QIODevice *outgoingData);
+
     QList<Scenario> mScenarios;
 };
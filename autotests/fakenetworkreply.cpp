@@ -7,9 +7,12 @@
 #include "fakenetworkreply.h"
 #include "types.h"
 
-FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario)
+#include <QTimer>
+
+FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario, const QNetworkRequest &originalRequest)
     : QNetworkReply()
 {
+    setRequest(originalRequest);
     setUrl(scenario.requestUrl);
     setOperation(scenario.requestMethod);
     setAttribute(QNetworkRequest::HttpStatusCodeAttribute, scenario.responseCode);
@@ -24,6 +27,9 @@ FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &sce
     for (const auto &header : std::as_const(scenario.responseHeaders)) {
         setRawHeader(header.first, header.second);
     }
+    if (scenario.networkError != QNetworkReply::NoError) {
+        setError(scenario.networkError, QStringLiteral("Simulated network error"));
+    }
 
     if (scenario.responseCode == KGAPI2::TemporarilyMoved) {
         setHeader(QNetworkRequest::LocationHeader, QString::fromUtf8(scenario.responseData));
@@ -33,6 +39,10 @@ FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &sce
     mBuffer.open(QIODevice::ReadOnly);
 
     open(QIODevice::ReadOnly);
+    if (scenario.delay > 0) {
+        QTimer::singleShot(scenario.delay, this, &FakeNetworkReply::deliver);
+        return;
+    }
     setFinished(true);
     QMetaObject::invokeMethod(this, "readyRead", Qt::QueuedConnection);
     QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
@@ -41,6 +51,7 @@ FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &sce
 FakeNetworkReply::FakeNetworkReply(QNetworkAccessManager::Operation method, const QNetworkRequest &originalRequest)
     : QNetworkReply()
 {
+    setRequest(originalRequest);
     setOperation(method);
     setUrl(originalRequest.url());
 
@@ -50,9 +61,27 @@ FakeNetworkReply::FakeNetworkReply(QNetworkAccessManager::Operation method, cons
     QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
 }
 
+void FakeNetworkReply::deliver()
+{
+    if (isFinished()) {
+        // Aborted in the meantime
+        return;
+    }
+    setFinished(true);
+    Q_EMIT readyRead();
+    Q_EMIT finished();
+}
+
 void FakeNetworkReply::abort()
 {
-    // NOOP
+    // Only delayed replies are still on the wire
+    if (isFinished()) {
+        return;
+    }
+    setError(QNetworkReply::OperationCanceledError, QStringLiteral("Operation canceled"));
+    setFinished(true);
+    Q_EMIT errorOccurred(QNetworkReply::OperationCanceledError);
+    Q_EMIT finished();
 }
 
 bool FakeNetworkReply::atEnd() const
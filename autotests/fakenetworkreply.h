@@ -17,7 +17,7 @@ class FakeNetworkReply : public QNetworkReply
 {
     Q_OBJECT
 public:
-    FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario);
+    FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario, const QNetworkRequest &originalRequest);
     explicit FakeNetworkReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &originalRequest);
 
     void abort() override;
@@ -34,5 +34,7 @@ protected:
     qint64 writeData(const char *data, qint64 len) override;
 
 private:
+    void deliver();
+
     QBuffer mBuffer;
 };
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "benchmarkutils.h"
+
+#include <QFile>
+#include <QTest>
+
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define KGAPI_ASAN_BUILD
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define KGAPI_ASAN_BUILD
+#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(KGAPI_ASAN_BUILD)
+// Count heap allocations of the whole process, including those made by Qt
+// containers, which don't go through operator new.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+static std::atomic<quint64> allocationCount{0};
+
+void *malloc(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+#define HAVE_ALLOCATION_COUNTER
+#endif
+
+namespace Benchmark
+{
+
+QByteArray readFixture(const QString &path)
+{
+    QFile file(QStringLiteral(KGAPI_FIXTURES_DIR "/") + path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qFatal("Failed to open %s", qPrintable(file.fileName()));
+    }
+    return file.readAll();
+}
+
+QByteArray buildFeed(const QByteArray &header, const QList<QByteArray> &fixtures, qsizetype count)
+{
+    QByteArray feed = "{" + header + ", \"items\": [";
+    for (qsizetype i = 0; i < count; ++i) {
+        if (i > 0) {
+            feed += ',';
+        }
+        feed += fixtures.at(i % fixtures.size()).trimmed();
+    }
+    feed += "]}";
+    return feed;
+}
+
+void addFeedSizes()
+{
+    QTest::addColumn<qsizetype>("items");
+
+    QTest::newRow("10k") << qsizetype(10000);
+    QTest::newRow("100k") << qsizetype(100000);
+}
+
+void report(const char *name, qsizetype items, qsizetype bytes, const std::function<void()> &func)
+{
+#ifdef HAVE_ALLOCATION_COUNTER
+    const quint64 before = allocationCount.load();
+#endif
+    QElapsedTimer timer;
+    timer.start();
+    func();
+    const double seconds = qMax<qint64>(timer.nsecsElapsed(), 1) / 1e9;
+
+#ifdef HAVE_ALLOCATION_COUNTER
+    const quint64 allocations = allocationCount.load() - before;
+    qInfo("%s: %lld items, %.0f items/s, %.1f MiB/s, %.1f allocations per item",
+          name,
+          qlonglong(items),
+          items / seconds,
+          bytes / seconds / (1024 * 1024),
+          double(allocations) / items);
+#else
+    qInfo("%s: %lld items, %.0f items/s, %.1f MiB/s", name, qlonglong(items), items / seconds, bytes / seconds / (1024 * 1024));
+#endif
+}
+
+}
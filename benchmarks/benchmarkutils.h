@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+#include <functional>
+
+namespace Benchmark
+{
+
+/**
+ * Reads @p path relative to the autotests directory, which contains the fixtures
+ */
+QByteArray readFixture(const QString &path);
+
+/**
+ * Builds a feed of @p count items by repeating the @p fixtures
+ */
+QByteArray buildFeed(const QByteArray &header, const QList<QByteArray> &fixtures, qsizetype count);
+
+/**
+ * Adds rows with the sizes of generated feeds to the current data function
+ */
+void addFeedSizes();
+
+/**
+ * Runs @p func once and prints its throughput and how many heap allocations
+ * it has made per item. Allocations are only counted in glibc builds without
+ * ASAN.
+ */
+void report(const char *name, qsizetype items, qsizetype bytes, const std::function<void()> &func);
+
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QHash>
+#include <QObject>
+#include <QTest>
+
+#include "benchmarkutils.h"
+#include "legacyeventparser.h"
+
+#include "calendarservice.h"
+#include "event.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class CalendarBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    QByteArray eventFeed(qsizetype items)
+    {
+        auto feed = mEventFeeds.find(items);
+        if (feed == mEventFeeds.end()) {
+            feed = mEventFeeds.insert(items,
+                                      Benchmark::buildFeed(R"("kind": "calendar#events", "timeZone": "Europe/Prague")",
+                                                           {Benchmark::readFixture(QStringLiteral("calendar/data/event1.json")),
+                                                            Benchmark::readFixture(QStringLiteral("calendar/data/event2.json"))},
+                                                           items));
+        }
+        return *feed;
+    }
+
+    QHash<qsizetype, QByteArray> mEventFeeds;
+
+private Q_SLOTS:
+    void benchmarkLegacyEventFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkLegacyEventFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = eventFeed(items);
+
+        Benchmark::report("parseEventJSONFeed (QVariant parser)", items, feed.size(), [&feed]() {
+            FeedData feedData;
+            Benchmark::Legacy::parseEventJSONFeed(feed, feedData);
+        });
+        QBENCHMARK {
+            FeedData feedData;
+            QCOMPARE(Benchmark::Legacy::parseEventJSONFeed(feed, feedData).size(), items);
+        }
+    }
+
+    void benchmarkParseEventFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkParseEventFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = eventFeed(items);
+
+        Benchmark::report("parseEventJSONFeed", items, feed.size(), [&feed]() {
+            FeedData feedData;
+            CalendarService::parseEventJSONFeed(feed, feedData);
+        });
+        QBENCHMARK {
+            FeedData feedData;
+            QCOMPARE(CalendarService::parseEventJSONFeed(feed, feedData).size(), items);
+        }
+    }
+
+    void benchmarkEventToJSON_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkEventToJSON()
+    {
+        QFETCH(qsizetype, items);
+        FeedData feedData;
+        const ObjectsList events = CalendarService::parseEventJSONFeed(eventFeed(items), feedData);
+        QCOMPARE(events.size(), items);
+
+        const auto serialize = [&events]() {
+            qsizetype bytes = 0;
+            for (const auto &event : events) {
+                bytes += CalendarService::eventToJSON(event.staticCast<Event>()).size();
+            }
+            return bytes;
+        };
+
+        const qsizetype bytes = serialize();
+        Benchmark::report("eventToJSON", items, bytes, serialize);
+        QBENCHMARK {
+            QCOMPARE(serialize(), bytes);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(CalendarBenchmark)
+
+#include "calendarbenchmark.moc"
@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QHash>
+#include <QJsonDocument>
+#include <QObject>
+#include <QTest>
+#include <QVariant>
+
+#include "benchmarkutils.h"
+
+#include "change.h"
+#include "file.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+// File::fromJSONFeed() as it was before it was ported to the streaming JsonReader
+Drive::FilesList legacyFileFeed(const QByteArray &jsonData)
+{
+    const QVariantMap map = QJsonDocument::fromJson(jsonData).toVariant().toMap();
+    if (map.value(Drive::File::Fields::Kind).toString() != QLatin1StringView("drive#fileList")) {
+        return {};
+    }
+
+    Drive::FilesList list;
+    const QVariantList items = map[Drive::File::Fields::Items].toList();
+    for (const QVariant &item : items) {
+        const Drive::FilePtr file = Drive::File::fromJSON(item.toMap());
+        if (!file.isNull()) {
+            list << file;
+        }
+    }
+    return list;
+}
+
+// Change::fromJSONFeed() as it was before it was ported to the streaming JsonReader,
+// Change can't be constructed outside of the library, so the values go into a struct
+struct LegacyChange {
+    qlonglong id = 0;
+    QString fileId;
+    QUrl selfLink;
+    bool deleted = false;
+    Drive::FilePtr file;
+};
+
+QList<LegacyChange> legacyChangeFeed(const QByteArray &jsonData)
+{
+    const QVariantMap map = QJsonDocument::fromJson(jsonData).toVariant().toMap();
+    if (map.value(QStringLiteral("kind")).toString() != QLatin1StringView("drive#changeList")) {
+        return {};
+    }
+
+    QList<LegacyChange> list;
+    const QVariantList items = map[QStringLiteral("items")].toList();
+    for (const QVariant &item : items) {
+        const QVariantMap data = item.toMap();
+        if (data[QStringLiteral("kind")].toString() != QLatin1StringView("drive#change")) {
+            continue;
+        }
+
+        LegacyChange change;
+        change.id = data[QStringLiteral("id")].toLongLong();
+        change.fileId = data[QStringLiteral("fileId")].toString();
+        change.selfLink = data[QStringLiteral("selfLink")].toUrl();
+        change.deleted = data[QStringLiteral("deleted")].toBool();
+        change.file = Drive::File::fromJSON(data[QStringLiteral("file")].toMap());
+        list << change;
+    }
+    return list;
+}
+
+}
+
+class DriveBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    QByteArray fileFeed(qsizetype items)
+    {
+        auto feed = mFileFeeds.find(items);
+        if (feed == mFileFeeds.end()) {
+            feed = mFileFeeds.insert(items,
+                                     Benchmark::buildFeed(R"("kind": "drive#fileList")",
+                                                          {Benchmark::readFixture(QStringLiteral("drive/data/file1.json")),
+                                                           Benchmark::readFixture(QStringLiteral("drive/data/file2.json"))},
+                                                          items));
+        }
+        return *feed;
+    }
+
+    QByteArray changeFeed(qsizetype items)
+    {
+        auto feed = mChangeFeeds.find(items);
+        if (feed == mChangeFeeds.end()) {
+            feed = mChangeFeeds.insert(items,
+                                       Benchmark::buildFeed(R"("kind": "drive#changeList")",
+                                                            {Benchmark::readFixture(QStringLiteral("drive/data/change1.json")),
+                                                             Benchmark::readFixture(QStringLiteral("drive/data/change2.json"))},
+                                                            items));
+        }
+        return *feed;
+    }
+
+    QHash<qsizetype, QByteArray> mFileFeeds;
+    QHash<qsizetype, QByteArray> mChangeFeeds;
+
+private Q_SLOTS:
+    void benchmarkLegacyFileFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkLegacyFileFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = fileFeed(items);
+
+        Benchmark::report("File::fromJSONFeed (QVariant parser)", items, feed.size(), [&feed]() {
+            legacyFileFeed(feed);
+        });
+        QBENCHMARK {
+            QCOMPARE(legacyFileFeed(feed).size(), items);
+        }
+    }
+
+    void benchmarkFileFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkFileFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = fileFeed(items);
+
+        Benchmark::report("File::fromJSONFeed", items, feed.size(), [&feed]() {
+            FeedData feedData;
+            Drive::File::fromJSONFeed(feed, feedData);
+        });
+        QBENCHMARK {
+            FeedData feedData;
+            QCOMPARE(Drive::File::fromJSONFeed(feed, feedData).size(), items);
+        }
+    }
+
+    void benchmarkLegacyChangeFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkLegacyChangeFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = changeFeed(items);
+
+        Benchmark::report("Change::fromJSONFeed (QVariant parser)", items, feed.size(), [&feed]() {
+            legacyChangeFeed(feed);
+        });
+        QBENCHMARK {
+            QCOMPARE(legacyChangeFeed(feed).size(), items);
+        }
+    }
+
+    void benchmarkChangeFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkChangeFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = changeFeed(items);
+
+        Benchmark::report("Change::fromJSONFeed", items, feed.size(), [&feed]() {
+            FeedData feedData;
+            Drive::Change::fromJSONFeed(feed, feedData);
+        });
+        QBENCHMARK {
+            FeedData feedData;
+            QCOMPARE(Drive::Change::fromJSONFeed(feed, feedData).size(), items);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(DriveBenchmark)
+
+#include "drivebenchmark.moc"
@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+#include "mockgoogleserver.h"
+#include "mocknetworkaccessmanager.h"
+
+#include "account.h"
+#include "eventfetchjob.h"
+#include "filefetchjob.h"
+#include "people/personfetchjob.h"
+#include "requestmetrics.h"
+#include "taskfetchjob.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+
+using JobFactory = std::function<FetchJob *(const AccountPtr &)>;
+
+const QList<QPair<QString, JobFactory>> &apiJobs()
+{
+    static const QList<QPair<QString, JobFactory>> jobs = {
+        {QStringLiteral("calendar"),
+         [](const AccountPtr &account) {
+             return new EventFetchJob(QStringLiteral("primary"), account);
+         }},
+        {QStringLiteral("drive"),
+         [](const AccountPtr &account) {
+             return new Drive::FileFetchJob(account);
+         }},
+        {QStringLiteral("people"),
+         [](const AccountPtr &account) {
+             return new People::PersonFetchJob(account);
+         }},
+        {QStringLiteral("tasks"),
+         [](const AccountPtr &account) {
+             return new TaskFetchJob(QStringLiteral("list"), account);
+         }},
+    };
+    return jobs;
+}
+
+qint64 percentile(const QList<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    return sorted.at(qMin<qsizetype>(sorted.size() * p, sorted.size() - 1));
+}
+
+// Peak resident set size of the process in KiB
+long peakRss()
+{
+#ifdef Q_OS_UNIX
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return -1;
+}
+
+void run(const QString &api, const JobFactory &createJob, int concurrentJobs, bool parseInThreadPool)
+{
+    const auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("Token"));
+
+    QList<qint64> latencies;
+    const auto connection = QObject::connect(RequestMetrics::instance(), &RequestMetrics::requestFinished, [&latencies](const RequestTiming &timing) {
+        latencies << timing.total;
+    });
+
+    qsizetype items = 0;
+    int failed = 0;
+    int running = concurrentJobs;
+    QEventLoop loop;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < concurrentJobs; ++i) {
+        FetchJob *job = createJob(account);
+        // Count the items as they arrive, so that memory use reflects the parsing and not the results
+        job->setRetainItems(false);
+        job->setParseInThreadPool(parseInThreadPool);
+        QObject::connect(job, &FetchJob::itemsAvailable, [&items](Job *, const ObjectsList &page) {
+            items += page.size();
+        });
+        QObject::connect(job, &Job::finished, [&](Job *finishedJob) {
+            if (finishedJob->error() != KGAPI2::NoError) {
+                ++failed;
+                std::fprintf(stderr, "%s job failed: %s\n", qPrintable(api), qPrintable(finishedJob->errorString()));
+            }
+            finishedJob->deleteLater();
+            if (--running == 0) {
+                loop.quit();
+            }
+        });
+    }
+    loop.exec();
+    const qint64 elapsed = timer.nsecsElapsed();
+    QObject::disconnect(connection);
+
+    std::sort(latencies.begin(), latencies.end());
+    const double seconds = elapsed / 1e9;
+    std::printf("%-8s %8lld requests %10lld items %8.1f requests/s %10.0f items/s  p50 %7.2f ms  p99 %7.2f ms  %d failed  peak RSS %ld KiB\n",
+                qPrintable(api),
+                static_cast<long long>(latencies.size()),
+                static_cast<long long>(items),
+                latencies.size() / seconds,
+                items / seconds,
+                percentile(latencies, 0.50) / 1000.0,
+                percentile(latencies, 0.99) / 1000.0,
+                failed,
+                peakRss());
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("endtoendbenchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Runs fetch jobs against the mock Google API server and reports their throughput"));
+    parser.addHelpOption();
+    parser.addOptions({
+        {QStringLiteral("api"), QStringLiteral("API to benchmark: calendar, drive, people, tasks or all."), QStringLiteral("api"), QStringLiteral("all")},
+        {QStringLiteral("jobs"), QStringLiteral("Number of jobs running at the same time."), QStringLiteral("count"), QStringLiteral("4")},
+        {QStringLiteral("server"), QStringLiteral("URL of an already running kgapi-mockserver instead of a built-in one."), QStringLiteral("url")},
+        {QStringLiteral("parse-in-thread-pool"), QStringLiteral("Parse replies in worker threads instead of the main thread.")},
+    });
+    MockGoogleServer::addOptions(parser);
+    parser.process(app);
+
+    // Without any latency the benchmark measures only the parsers, which have their own benchmarks
+    MockGoogleServer::Settings settings = MockGoogleServer::settingsFromOptions(parser);
+    if (!parser.isSet(QStringLiteral("latency"))) {
+        settings.latency = 20;
+    }
+
+    // The server runs in its own thread, so that it does not compete with the jobs for the event loop
+    QThread serverThread;
+    QUrl serverUrl(parser.value(QStringLiteral("server")));
+    MockGoogleServer *server = nullptr;
+    if (serverUrl.isEmpty()) {
+        server = new MockGoogleServer(settings);
+        server->moveToThread(&serverThread);
+        QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+        serverThread.start();
+
+        bool listening = false;
+        QMetaObject::invokeMethod(
+            server,
+            [server, &listening, &serverUrl]() {
+                listening = server->listen();
+                serverUrl = server->url();
+            },
+            Qt::BlockingQueuedConnection);
+        if (!listening) {
+            serverThread.quit();
+            serverThread.wait();
+            return 1;
+        }
+    }
+
+    NetworkAccessManagerFactory::setFactory(new MockNetworkAccessManagerFactory(serverUrl));
+    RequestMetrics::instance()->setEnabled(true);
+
+    std::printf("Server %s, %lld items, %d ms latency, %d concurrent jobs\n",
+                qPrintable(serverUrl.toString()),
+                static_cast<long long>(settings.items),
+                settings.latency,
+                parser.value(QStringLiteral("jobs")).toInt());
+
+    const QString api = parser.value(QStringLiteral("api"));
+    for (const auto &apiJob : apiJobs()) {
+        if (api == QLatin1StringView("all") || api == apiJob.first) {
+            run(apiJob.first, apiJob.second, qMax(parser.value(QStringLiteral("jobs")).toInt(), 1), parser.isSet(QStringLiteral("parse-in-thread-pool")));
+        }
+    }
+
+    if (server) {
+        std::printf("Server served %lld requests, injected %lld errors\n",
+                    static_cast<long long>(server->requestsServed()),
+                    static_cast<long long>(server->errorsInjected()));
+        serverThread.quit();
+        serverThread.wait();
+    }
+
+    return 0;
+}
@@ -0,0 +1,396 @@
+/*
+ * SPDX-FileCopyrightText: 2013 Daniel Vrátil <dvratil@redhat.com>
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "legacyeventparser.h"
+
+#include "calendarservice.h"
+#include "event.h"
+#include "utils.h"
+
+#include <KCalendarCore/Alarm>
+#include <KCalendarCore/Attendee>
+#include <KCalendarCore/ICalFormat>
+#include <KCalendarCore/Person>
+#include <KCalendarCore/Recurrence>
+#include <KCalendarCore/RecurrenceRule>
+
+#include <QDebug>
+#include <QJsonDocument>
+#include <QTimeZone>
+#include <QUrlQuery>
+#include <QVariant>
+
+#include <memory>
+
+// The event parser of CalendarService as it was before it was ported to the
+// streaming JsonReader, kept unchanged apart from the names it is reachable by.
+
+using namespace KGAPI2;
+
+namespace
+{
+
+static const auto kindParam = QStringLiteral("kind");
+static const auto idParam = QStringLiteral("id");
+static const auto etagParam = QStringLiteral("etag");
+
+static const auto nextSyncTokenParam = QStringLiteral("nextSyncToken");
+static const auto nextPageTokenParam = QStringLiteral("nextPageToken");
+static const auto pageTokenParam = QStringLiteral("pageToken");
+static const auto itemsParam = QStringLiteral("items");
+
+static const auto reminderMethodParam = QStringLiteral("method");
+static const auto reminderMinutesParam = QStringLiteral("minutes");
+
+static const auto eventiCalUIDParam = QStringLiteral("iCalUID");
+static const auto eventStatusParam = QStringLiteral("status");
+static const auto eventCreatedParam = QStringLiteral("created");
+static const auto eventUpdatedParam = QStringLiteral("updated");
+static const auto eventSummaryParam = QStringLiteral("summary");
+static const auto eventDescriptionParam = QStringLiteral("description");
+static const auto eventLocationParam = QStringLiteral("location");
+static const auto eventStartPram = QStringLiteral("start");
+static const auto eventEndParam = QStringLiteral("end");
+static const auto eventOriginalStartTimeParam = QStringLiteral("originalStartTime");
+static const auto eventTransparencyParam = QStringLiteral("transparency");
+static const auto eventOrganizerParam = QStringLiteral("organizer");
+static const auto eventAttendeesParam = QStringLiteral("attendees");
+static const auto eventRecurrenceParam = QStringLiteral("recurrence");
+static const auto eventRemindersParam = QStringLiteral("reminders");
+static const auto eventExtendedPropertiesParam = QStringLiteral("extendedProperties");
+
+static const auto attendeeDisplayNameParam = QStringLiteral("displayName");
+static const auto attendeeEmailParam = QStringLiteral("email");
+static const auto attendeeResponseStatusParam = QStringLiteral("responseStatus");
+static const auto attendeeOptionalParam = QStringLiteral("optional");
+
+static const auto organizerDisplayNameParam = QStringLiteral("displayName");
+static const auto organizerEmailParam = QStringLiteral("email");
+
+static const auto reminderUseDefaultParam = QStringLiteral("useDefault");
+static const auto reminderOverridesParam = QStringLiteral("overrides");
+
+static const auto propertyPrivateParam = QStringLiteral("private");
+static const auto propertySharedParam = QStringLiteral("shared");
+
+static const auto dateParam = QStringLiteral("date");
+static const auto dateTimeParam = QStringLiteral("dateTime");
+static const auto timeZoneParam = QStringLiteral("timeZone");
+
+static const auto eventsKind = QLatin1StringView("calendar#events");
+
+static const auto emailMethod = QLatin1StringView("email");
+static const auto popupMethod = QLatin1StringView("popup");
+
+static const auto confirmedStatus = QLatin1StringView("confirmed");
+static const auto canceledStatus = QLatin1StringView("cancelled");
+static const auto tentativeStatus = QLatin1StringView("tentative");
+static const auto acceptedStatus = QLatin1StringView("accepted");
+static const auto transparentTransparency = QLatin1StringView("transparent");
+static const auto declinedStatus = QLatin1StringView("declined");
+static const auto categoriesProperty = QLatin1StringView("categories");
+
+static const auto hangoutLinkParam = QStringLiteral("hangoutLink");
+
+static const auto eventTypeParam = QStringLiteral("eventType");
+
+KCalendarCore::DateList parseRDate(const QString &rule);
+
+struct ParsedDt {
+    QDateTime dt;
+    bool isAllDay;
+};
+
+ParsedDt parseDt(const QVariantMap &data, const QString &timezone, bool isDtEnd)
+{
+    if (data.contains(dateParam)) {
+        auto dt = QDateTime::fromString(data.value(dateParam).toString(), Qt::ISODate);
+        if (isDtEnd) {
+            // Google reports all-day events to end on the next day, e.g. a
+            // Monday all-day event will be reporting as starting on Monday and
+            // ending on Tuesday, while KCalendarCore/iCal uses the same day for
+            // dtEnd, so adjust the end date here.
+            dt = dt.addDays(-1);
+        }
+        return {dt, true};
+    } else if (data.contains(dateTimeParam)) {
+        auto dt = Utils::rfc3339DateFromString(data.value(dateTimeParam).toString());
+        // If there's a timezone specified in the "start" entity, then use it
+        if (data.contains(timeZoneParam)) {
+            const QTimeZone tz = QTimeZone(data.value(timeZoneParam).toString().toUtf8());
+            if (tz.isValid()) {
+                dt = dt.toTimeZone(tz);
+            } else {
+                qWarning() << "Invalid timezone" << data.value(timeZoneParam).toString();
+            }
+
+            // Otherwise try to fallback to calendar-wide timezone
+        } else if (!timezone.isEmpty()) {
+            const QTimeZone tz(timezone.toUtf8());
+            if (tz.isValid()) {
+                dt.setTimeZone(tz);
+            } else {
+                qWarning() << "Invalid timezone" << timezone;
+            }
+        }
+        return {dt, false};
+    } else {
+        return {{}, false};
+    }
+}
+
+void setEventCategories(EventPtr &event, const QVariantMap &properties)
+{
+    for (auto iter = properties.cbegin(), end = properties.cend(); iter != end; ++iter) {
+        if (iter.key() == categoriesProperty) {
+            event->setCategories(iter.value().toString());
+        }
+    }
+}
+
+ObjectPtr JSONToEvent(const QVariantMap &data, const QString &timezone)
+{
+    auto event = EventPtr::create();
+
+    event->setId(data.value(idParam).toString());
+    event->setHangoutLink(data.value(hangoutLinkParam).toString());
+    event->setUid(data.value(eventiCalUIDParam).toString());
+    event->setEtag(data.value(etagParam).toString());
+
+    if (data.value(eventStatusParam).toString() == confirmedStatus) {
+        event->setStatus(KCalendarCore::Incidence::StatusConfirmed);
+    } else if (data.value(eventStatusParam).toString() == canceledStatus) {
+        event->setStatus(KCalendarCore::Incidence::StatusCanceled);
+        event->setDeleted(true);
+    } else if (data.value(eventStatusParam).toString() == tentativeStatus) {
+        event->setStatus(KCalendarCore::Incidence::StatusTentative);
+    } else {
+        event->setStatus(KCalendarCore::Incidence::StatusNone);
+    }
+
+    event->setCreated(Utils::rfc3339DateFromString(data.value(eventCreatedParam).toString()));
+    event->setLastModified(Utils::rfc3339DateFromString(data.value(eventUpdatedParam).toString()));
+    event->setSummary(data.value(eventSummaryParam).toString());
+    event->setDescription(data.value(eventDescriptionParam).toString());
+    event->setLocation(data.value(eventLocationParam).toString());
+
+    const auto dtStart = parseDt(data.value(eventStartPram).toMap(), timezone, false);
+    event->setDtStart(dtStart.dt);
+    event->setAllDay(dtStart.isAllDay);
+
+    const auto dtEnd = parseDt(data.value(eventEndParam).toMap(), timezone, true);
+    event->setDtEnd(dtEnd.dt);
+
+    if (data.contains(eventOriginalStartTimeParam)) {
+        const auto recurrenceId = parseDt(data.value(eventOriginalStartTimeParam).toMap(), timezone, false);
+        event->setRecurrenceId(recurrenceId.dt);
+    }
+
+    if (data.value(eventTransparencyParam).toString() == transparentTransparency) {
+        event->setTransparency(Event::Transparent);
+    } else { /* Assume opaque as default transparency */
+        event->setTransparency(Event::Opaque);
+    }
+
+    const auto attendees = data.value(eventAttendeesParam).toList();
+    for (const auto &a : attendees) {
+        const auto att = a.toMap();
+        KCalendarCore::Attendee attendee(att.value(attendeeDisplayNameParam).toString(), att.value(attendeeEmailParam).toString());
+        const auto responseStatus = att.value(attendeeResponseStatusParam).toString();
+        if (responseStatus == acceptedStatus) {
+            attendee.setStatus(KCalendarCore::Attendee::Accepted);
+        } else if (responseStatus == declinedStatus) {
+            attendee.setStatus(KCalendarCore::Attendee::Declined);
+        } else if (responseStatus == tentativeStatus) {
+            attendee.setStatus(KCalendarCore::Attendee::Tentative);
+        } else {
+            attendee.setStatus(KCalendarCore::Attendee::NeedsAction);
+        }
+
+        if (att.value(attendeeOptionalParam).toBool()) {
+            attendee.setRole(KCalendarCore::Attendee::OptParticipant);
+        }
+        const auto uid = att.value(idParam).toString();
+        if (!uid.isEmpty()) {
+            attendee.setUid(uid);
+        } else {
+            // Set some UID, just so that the results are reproducible
+            attendee.setUid(QString::number(qHash(attendee.email())));
+        }
+        event->addAttendee(attendee, true);
+    }
+
+    /* According to RFC, only events with attendees can have an organizer.
+     * Google seems to ignore it, so we must take care of it here */
+    if (event->attendeeCount() > 0) {
+        KCalendarCore::Person organizer;
+        const auto organizerData = data.value(eventOrganizerParam).toMap();
+        organizer.setName(organizerData.value(organizerDisplayNameParam).toString());
+        organizer.setEmail(organizerData.value(organizerEmailParam).toString());
+        event->setOrganizer(organizer);
+    }
+
+    const QStringList recrs = data.value(eventRecurrenceParam).toStringList();
+    for (const QString &rec : recrs) {
+        KCalendarCore::ICalFormat format;
+        const QStringView recView(rec);
+        if (recView.left(5) == QLatin1StringView("RRULE")) {
+            auto recurrenceRule = std::make_unique<KCalendarCore::RecurrenceRule>();
+            const auto ok = format.fromString(recurrenceRule.get(), rec.mid(6));
+            Q_UNUSED(ok)
+            recurrenceRule->setRRule(rec);
+            event->recurrence()->addRRule(recurrenceRule.release());
+        } else if (recView.left(6) == QLatin1StringView("EXRULE")) {
+            auto recurrenceRule = std::make_unique<KCalendarCore::RecurrenceRule>();
+            const auto ok = format.fromString(recurrenceRule.get(), rec.mid(7));
+            Q_UNUSED(ok)
+            recurrenceRule->setRRule(rec);
+            event->recurrence()->addExRule(recurrenceRule.release());
+        } else if (recView.left(6) == QLatin1StringView("EXDATE")) {
+            KCalendarCore::DateList exdates = parseRDate(rec);
+            event->recurrence()->setExDates(exdates);
+        } else if (recView.left(5) == QLatin1StringView("RDATE")) {
+            KCalendarCore::DateList rdates = parseRDate(rec);
+            event->recurrence()->setRDates(rdates);
+        }
+    }
+
+    const auto reminders = data.value(eventRemindersParam).toMap();
+    if (reminders.contains(reminderUseDefaultParam) && reminders.value(reminderUseDefaultParam).toBool()) {
+        event->setUseDefaultReminders(true);
+    } else {
+        event->setUseDefaultReminders(false);
+    }
+
+    const auto overrides = reminders.value(reminderOverridesParam).toList();
+    for (const auto &r : overrides) {
+        const auto reminderOverride = r.toMap();
+        auto alarm = KCalendarCore::Alarm::Ptr::create(static_cast<KCalendarCore::Incidence *>(event.data()));
+        alarm->setTime(event->dtStart());
+
+        if (reminderOverride.value(reminderMethodParam).toString() == popupMethod) {
+            alarm->setType(KCalendarCore::Alarm::Display);
+        } else if (reminderOverride.value(reminderMethodParam).toString() == emailMethod) {
+            alarm->setType(KCalendarCore::Alarm::Email);
+        } else {
+            alarm->setType(KCalendarCore::Alarm::Invalid);
+            continue;
+        }
+
+        alarm->setStartOffset(KCalendarCore::Duration(reminderOverride.value(reminderMinutesParam).toInt() * (-60)));
+        alarm->setEnabled(true);
+        event->addAlarm(alarm);
+    }
+
+    const auto extendedProperties = data.value(eventExtendedPropertiesParam).toMap();
+    setEventCategories(event, extendedProperties.value(propertyPrivateParam).toMap());
+    setEventCategories(event, extendedProperties.value(propertySharedParam).toMap());
+
+    if (const auto eventType = data.value(eventTypeParam).toString(); !eventType.isEmpty()) {
+        event->setEventType(CalendarService::eventTypeFromString(eventType));
+    } else {
+        event->setEventType(Event::EventType::Default);
+    }
+
+    return event.dynamicCast<Object>();
+}
+
+KCalendarCore::DateList parseRDate(const QString &rule)
+{
+    KCalendarCore::DateList list;
+    QTimeZone tz;
+    QStringView value;
+    const auto left = QStringView(rule).left(rule.indexOf(QLatin1Char(':')));
+
+    const auto params = left.split(QLatin1Char(';'));
+    for (const auto &param : params) {
+        if (param.startsWith(QLatin1StringView("VALUE"))) {
+            value = param.mid(param.indexOf(QLatin1Char('=')) + 1);
+        } else if (param.startsWith(QLatin1StringView("TZID"))) {
+            auto _name = param.mid(param.indexOf(QLatin1Char('=')) + 1);
+            tz = QTimeZone(_name.toUtf8());
+        }
+    }
+    const auto datesStr = QStringView(rule).mid(rule.lastIndexOf(QLatin1Char(':')) + 1);
+    const auto dates = datesStr.split(QLatin1Char(','));
+    for (const auto &date : dates) {
+        QDate dt;
+
+        if (value == QLatin1StringView("DATE")) {
+            dt = QDate::fromString(date.toString(), QStringLiteral("yyyyMMdd"));
+        } else if (value == QLatin1StringView("PERIOD")) {
+            const auto start = date.left(date.indexOf(QLatin1Char('/')));
+            QDateTime kdt = Utils::rfc3339DateFromString(start.toString());
+            if (tz.isValid()) {
+                kdt.setTimeZone(tz);
+            }
+
+            dt = kdt.date();
+        } else {
+            QDateTime kdt = Utils::rfc3339DateFromString(date.toString());
+            if (tz.isValid()) {
+                kdt.setTimeZone(tz);
+            }
+
+            dt = kdt.date();
+        }
+
+        list.push_back(dt);
+    }
+
+    return list;
+}
+
+} // namespace
+
+namespace Benchmark
+{
+
+namespace Legacy
+{
+
+ObjectsList parseEventJSONFeed(const QByteArray &jsonFeed, FeedData &feedData)
+{
+    const auto document = QJsonDocument::fromJson(jsonFeed);
+    const auto data = document.toVariant().toMap();
+
+    QString timezone;
+    if (data.value(kindParam) == eventsKind) {
+        if (data.contains(nextPageTokenParam)) {
+            QString calendarId = feedData.requestUrl.toString().remove(QStringLiteral("https://www.googleapis.com/calendar/v3/calendars/"));
+            calendarId = calendarId.left(calendarId.indexOf(QLatin1Char('/')));
+            feedData.nextPageUrl = feedData.requestUrl;
+            // replace the old pageToken with a new one
+            QUrlQuery query(feedData.nextPageUrl);
+            query.removeQueryItem(pageTokenParam);
+            query.addQueryItem(pageTokenParam, data.value(nextPageTokenParam).toString());
+            feedData.nextPageUrl.setQuery(query);
+        }
+        if (data.contains(timeZoneParam)) {
+            // This should always be in Olson format
+            timezone = data.value(timeZoneParam).toString();
+        }
+        if (data.contains(nextSyncTokenParam)) {
+            feedData.syncToken = data[nextSyncTokenParam].toString();
+        }
+    } else {
+        return {};
+    }
+
+    ObjectsList list;
+    const auto items = data.value(itemsParam).toList();
+    list.reserve(items.size());
+    for (const auto &i : items) {
+        list.push_back(JSONToEvent(i.toMap(), timezone));
+    }
+
+    return list;
+}
+
+} // namespace Legacy
+
+} // namespace Benchmark
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <QByteArray>
+
+namespace Benchmark
+{
+
+namespace Legacy
+{
+
+/**
+ * Parses an event feed like CalendarService::parseEventJSONFeed() used to
+ * before it was ported to the streaming JsonReader: the feed is converted to
+ * a QJsonDocument and a tree of QVariants first, then each event is read
+ * from its QVariantMap. Used as the baseline of the calendar benchmarks.
+ */
+KGAPI2::ObjectsList parseEventJSONFeed(const QByteArray &jsonFeed, KGAPI2::FeedData &feedData);
+
+} // namespace Legacy
+
+} // namespace Benchmark
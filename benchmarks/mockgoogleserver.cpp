@@ -0,0 +1,430 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "mockgoogleserver.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QSslCertificate>
+#include <QSslKey>
+#include <QSslServer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+
+namespace
+{
+
+// How often paced connections send the next chunk of a reply
+constexpr int PacingInterval = 10;
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200:
+        return "OK";
+    case 401:
+        return "Unauthorized";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    case 500:
+        return "Internal Server Error";
+    case 502:
+        return "Bad Gateway";
+    case 503:
+        return "Service Unavailable";
+    case 504:
+        return "Gateway Timeout";
+    default:
+        return "Unknown";
+    }
+}
+
+/**
+ * Reads HTTP/1.1 requests from a socket and writes the replies back, one request at a time
+ */
+class MockConnection : public QObject
+{
+public:
+    MockConnection(QTcpSocket *socket, MockGoogleServer *server)
+        : QObject(server)
+        , mSocket(socket)
+        , mServer(server)
+    {
+        socket->setParent(this);
+        connect(socket, &QTcpSocket::readyRead, this, &MockConnection::readRequest);
+        connect(socket, &QTcpSocket::disconnected, this, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::bytesWritten, this, &MockConnection::replyWritten);
+        mPacer.setInterval(PacingInterval);
+        connect(&mPacer, &QTimer::timeout, this, &MockConnection::writeChunk);
+    }
+
+private:
+    void readRequest()
+    {
+        mBuffer += mSocket->readAll();
+        // The next request is read only once the reply to the current one has been sent
+        if (mBusy) {
+            return;
+        }
+
+        const qsizetype headerEnd = mBuffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            return;
+        }
+
+        const QList<QByteArray> lines = mBuffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() < 3) {
+            mSocket->disconnectFromHost();
+            return;
+        }
+
+        QHash<QByteArray, QByteArray> headers;
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            const qsizetype colon = lines[i].indexOf(':');
+            if (colon > 0) {
+                headers.insert(lines[i].left(colon).trimmed().toLower(), lines[i].mid(colon + 1).trimmed());
+            }
+        }
+
+        // Request bodies are not used by any of the emulated endpoints, they are just skipped
+        const qsizetype contentLength = headers.value("content-length").toLongLong();
+        if (mBuffer.size() < headerEnd + 4 + contentLength) {
+            return;
+        }
+        mBuffer.remove(0, headerEnd + 4 + contentLength);
+        mCloseAfterReply = headers.value("connection").toLower() == "close";
+
+        const auto response = mServer->handleRequest(requestLine.at(0), requestLine.at(1), headers);
+
+        QByteArray reply = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+        reply += "Content-Type: application/json; charset=UTF-8\r\n";
+        reply += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+        for (const auto &header : response.headers) {
+            reply += header.first + ": " + header.second + "\r\n";
+        }
+        reply += "\r\n";
+        reply += response.body;
+
+        mBusy = true;
+        mPending = reply;
+        QTimer::singleShot(mServer->settings().latency, this, [this]() {
+            if (mServer->settings().bandwidth > 0) {
+                mPacer.start();
+                writeChunk();
+            } else {
+                mSocket->write(std::exchange(mPending, {}));
+            }
+        });
+    }
+
+    void writeChunk()
+    {
+        const qint64 chunk = qMax<qint64>(mServer->settings().bandwidth * PacingInterval / 1000, 1);
+        mSocket->write(mPending.left(chunk));
+        mPending.remove(0, qMin<qint64>(chunk, mPending.size()));
+        if (mPending.isEmpty()) {
+            mPacer.stop();
+        }
+    }
+
+    void replyWritten()
+    {
+        if (!mBusy || !mPending.isEmpty() || mSocket->bytesToWrite() > 0) {
+            return;
+        }
+
+        mBusy = false;
+        if (mCloseAfterReply) {
+            mSocket->disconnectFromHost();
+            return;
+        }
+        if (!mBuffer.isEmpty()) {
+            readRequest();
+        }
+    }
+
+    QTcpSocket *const mSocket;
+    MockGoogleServer *const mServer;
+    QByteArray mBuffer;
+    QByteArray mPending;
+    QTimer mPacer;
+    bool mBusy = false;
+    bool mCloseAfterReply = false;
+};
+
+}
+
+void MockGoogleServer::addOptions(QCommandLineParser &parser)
+{
+    parser.addOptions({
+        {QStringLiteral("items"), QStringLiteral("Number of items in every collection."), QStringLiteral("count"), QStringLiteral("10000")},
+        {QStringLiteral("page-size"), QStringLiteral("Items per page when the request does not ask for a page size."), QStringLiteral("count"), QStringLiteral("250")},
+        {QStringLiteral("max-page-size"), QStringLiteral("Largest page the server returns."), QStringLiteral("count"), QStringLiteral("1000")},
+        {QStringLiteral("latency"), QStringLiteral("Delay before each reply."), QStringLiteral("ms"), QStringLiteral("0")},
+        {QStringLiteral("bandwidth"), QStringLiteral("Bandwidth of each connection, 0 for unlimited."), QStringLiteral("KiB/s"), QStringLiteral("0")},
+        {QStringLiteral("quota-error-rate"), QStringLiteral("Probability of a 429 rateLimitExceeded reply."), QStringLiteral("rate"), QStringLiteral("0")},
+        {QStringLiteral("server-error-rate"), QStringLiteral("Probability of a 5xx reply."), QStringLiteral("rate"), QStringLiteral("0")},
+        {QStringLiteral("seed"), QStringLiteral("Seed for error injection."), QStringLiteral("seed"), QStringLiteral("1")},
+        {QStringLiteral("fixtures"), QStringLiteral("Directory with the autotest fixtures."), QStringLiteral("dir"), QStringLiteral(KGAPI_FIXTURES_DIR)},
+        {QStringLiteral("tls-certificate"), QStringLiteral("Serve HTTPS with this PEM certificate."), QStringLiteral("file")},
+        {QStringLiteral("tls-key"), QStringLiteral("PEM private key of the certificate."), QStringLiteral("file")},
+    });
+}
+
+MockGoogleServer::Settings MockGoogleServer::settingsFromOptions(const QCommandLineParser &parser)
+{
+    Settings settings;
+    settings.items = parser.value(QStringLiteral("items")).toLongLong();
+    settings.pageSize = parser.value(QStringLiteral("page-size")).toLongLong();
+    settings.maxPageSize = parser.value(QStringLiteral("max-page-size")).toLongLong();
+    settings.latency = parser.value(QStringLiteral("latency")).toInt();
+    settings.bandwidth = parser.value(QStringLiteral("bandwidth")).toLongLong() * 1024;
+    settings.quotaErrorRate = parser.value(QStringLiteral("quota-error-rate")).toDouble();
+    settings.serverErrorRate = parser.value(QStringLiteral("server-error-rate")).toDouble();
+    settings.seed = parser.value(QStringLiteral("seed")).toUInt();
+    settings.fixturesDir = parser.value(QStringLiteral("fixtures"));
+
+    if (parser.isSet(QStringLiteral("tls-certificate"))) {
+        QFile certificateFile(parser.value(QStringLiteral("tls-certificate")));
+        QFile keyFile(parser.value(QStringLiteral("tls-key")));
+        if (!certificateFile.open(QIODevice::ReadOnly) || !keyFile.open(QIODevice::ReadOnly)) {
+            qWarning("Failed to read the TLS certificate or key, serving plain HTTP");
+            return settings;
+        }
+        settings.sslConfiguration = QSslConfiguration::defaultConfiguration();
+        settings.sslConfiguration.setLocalCertificate(QSslCertificate(&certificateFile, QSsl::Pem));
+        settings.sslConfiguration.setPrivateKey(QSslKey(&keyFile, QSsl::Rsa, QSsl::Pem));
+    }
+    return settings;
+}
+
+MockGoogleServer::MockGoogleServer(const Settings &settings, QObject *parent)
+    : QObject(parent)
+    , mSettings(settings)
+    , mRandom(settings.seed)
+{
+    loadCollections();
+}
+
+MockGoogleServer::~MockGoogleServer() = default;
+
+bool MockGoogleServer::listen(const QHostAddress &address, quint16 port)
+{
+    if (mSettings.sslConfiguration.localCertificate().isNull()) {
+        mServer = new QTcpServer(this);
+    } else {
+        auto sslServer = new QSslServer(this);
+        sslServer->setSslConfiguration(mSettings.sslConfiguration);
+        mServer = sslServer;
+    }
+
+    connect(mServer, &QTcpServer::pendingConnectionAvailable, this, &MockGoogleServer::newConnection);
+    if (!mServer->listen(address, port)) {
+        qWarning("Failed to listen on %s:%d: %s", qPrintable(address.toString()), port, qPrintable(mServer->errorString()));
+        return false;
+    }
+    return true;
+}
+
+QUrl MockGoogleServer::url() const
+{
+    QUrl url;
+    url.setScheme(qobject_cast<QSslServer *>(mServer) ? QStringLiteral("https") : QStringLiteral("http"));
+    url.setHost(mServer->serverAddress().toString());
+    url.setPort(mServer->serverPort());
+    return url;
+}
+
+const MockGoogleServer::Settings &MockGoogleServer::settings() const
+{
+    return mSettings;
+}
+
+qint64 MockGoogleServer::requestsServed() const
+{
+    return mRequestsServed;
+}
+
+qint64 MockGoogleServer::errorsInjected() const
+{
+    return mErrorsInjected;
+}
+
+void MockGoogleServer::newConnection()
+{
+    while (QTcpSocket *socket = mServer->nextPendingConnection()) {
+        new MockConnection(socket, this);
+    }
+}
+
+void MockGoogleServer::loadCollections()
+{
+    const auto load = [this](const QStringList &fixtures) {
+        QList<QJsonObject> templates;
+        for (const auto &fixture : fixtures) {
+            QFile file(mSettings.fixturesDir + QLatin1Char('/') + fixture);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qWarning("Failed to open fixture %s", qPrintable(file.fileName()));
+                continue;
+            }
+            templates << QJsonDocument::fromJson(file.readAll()).object();
+        }
+        return templates;
+    };
+
+    mCollections.insert("events",
+                        {"calendar#events",
+                         "items",
+                         "id",
+                         "event",
+                         "maxResults",
+                         false,
+                         load({QStringLiteral("calendar/data/event1.json"), QStringLiteral("calendar/data/event2.json")})});
+    mCollections.insert("files",
+                        {"drive#fileList",
+                         "items",
+                         "id",
+                         "file",
+                         "maxResults",
+                         true,
+                         load({QStringLiteral("drive/data/file1.json"), QStringLiteral("drive/data/file2.json")})});
+    mCollections.insert("connections",
+                        {{},
+                         "connections",
+                         "resourceName",
+                         "people/c",
+                         "pageSize",
+                         false,
+                         load({QStringLiteral("people/data/person1.json"), QStringLiteral("people/data/person2.json")})});
+    mCollections.insert("tasks",
+                        {"tasks#tasks",
+                         "items",
+                         "id",
+                         "task",
+                         "maxResults",
+                         false,
+                         load({QStringLiteral("tasks/data/task1.json"), QStringLiteral("tasks/data/task2.json")})});
+}
+
+MockGoogleServer::Response MockGoogleServer::error(int status, const QByteArray &reason, const QByteArray &message)
+{
+    Response response;
+    response.status = status;
+    response.body = R"({"error": {"code": )" + QByteArray::number(status) + R"(, "message": ")" + message + R"(", "errors": [{"reason": ")" + reason
+        + R"(", "message": ")" + message + R"("}]}})";
+    return response;
+}
+
+MockGoogleServer::Response MockGoogleServer::handleRequest(const QByteArray &method, const QByteArray &target, const QHash<QByteArray, QByteArray> &headers)
+{
+    ++mRequestsServed;
+
+    // The original host is the first segment of the path
+    QUrl url(QStringLiteral("http://localhost") + QString::fromLatin1(target));
+    QString host = QStringLiteral("www.googleapis.com");
+    QString path = url.path();
+    const qsizetype hostEnd = path.indexOf(QLatin1Char('/'), 1);
+    if (hostEnd > 0 && path.left(hostEnd).contains(QLatin1Char('.'))) {
+        host = path.mid(1, hostEnd - 1);
+        path = path.mid(hostEnd);
+    }
+    url.setHost(host);
+    url.setPath(path);
+
+    if (!headers.contains("authorization")) {
+        return error(401, "authError", "Login Required");
+    }
+
+    if (mRandom.generateDouble() < mSettings.quotaErrorRate) {
+        ++mErrorsInjected;
+        return error(429, "rateLimitExceeded", "Rate Limit Exceeded");
+    }
+    if (mRandom.generateDouble() < mSettings.serverErrorRate) {
+        ++mErrorsInjected;
+        static const int statuses[] = {500, 502, 503, 504};
+        const int status = statuses[mRandom.bounded(4)];
+        return error(status, "backendError", "Backend Error");
+    }
+
+    static const QList<QPair<QRegularExpression, QByteArray>> routes = {
+        {QRegularExpression(QStringLiteral("^www\\.googleapis\\.com/calendar/v3/calendars/[^/]+/events$")), "events"},
+        {QRegularExpression(QStringLiteral("^www\\.googleapis\\.com/drive/v2/files$")), "files"},
+        {QRegularExpression(QStringLiteral("^people\\.googleapis\\.com/v1/people/me/connections$")), "connections"},
+        {QRegularExpression(QStringLiteral("^www\\.googleapis\\.com/tasks/v1/lists/[^/]+/tasks$")), "tasks"},
+    };
+
+    if (method == "GET") {
+        const QString resource = host + path;
+        for (const auto &route : routes) {
+            if (route.first.match(resource).hasMatch()) {
+                return collectionPage(mCollections.value(route.second), host, url);
+            }
+        }
+    }
+
+    return error(404, "notFound", "Not Found");
+}
+
+MockGoogleServer::Response MockGoogleServer::collectionPage(const Collection &collection, const QString &host, const QUrl &url)
+{
+    const QUrlQuery query(url);
+    const qsizetype offset = qBound<qsizetype>(0, query.queryItemValue(QStringLiteral("pageToken")).toLongLong(), mSettings.items);
+    const qsizetype requested = query.queryItemValue(QString::fromLatin1(collection.pageSizeParam)).toLongLong();
+    const qsizetype pageSize = qMin(requested > 0 ? requested : mSettings.pageSize, mSettings.maxPageSize);
+    const qsizetype end = qMin(offset + pageSize, mSettings.items);
+
+    QByteArray body = "{";
+    if (!collection.kind.isEmpty()) {
+        body += R"("kind": ")" + collection.kind + R"(", )";
+    }
+    body += R"("totalItems": )" + QByteArray::number(mSettings.items) + ", ";
+
+    if (end < mSettings.items) {
+        const QByteArray token = QByteArray::number(end);
+        body += R"("nextPageToken": ")" + token + R"(", )";
+        if (collection.nextLink) {
+            QUrl nextLink(url);
+            nextLink.setScheme(QStringLiteral("https"));
+            nextLink.setHost(host);
+            nextLink.setPort(-1);
+            QUrlQuery nextQuery(query);
+            nextQuery.removeAllQueryItems(QStringLiteral("pageToken"));
+            nextQuery.addQueryItem(QStringLiteral("pageToken"), QString::fromLatin1(token));
+            nextLink.setQuery(nextQuery);
+            body += R"("nextLink": ")" + nextLink.toEncoded() + R"(", )";
+        }
+    } else {
+        body += R"("nextSyncToken": "sync-)" + QByteArray::number(mSettings.items) + R"(", )";
+    }
+
+    body += '"' + collection.itemsMember + R"(": [)";
+    for (qsizetype i = offset; i < end; ++i) {
+        if (i > offset) {
+            body += ',';
+        }
+        if (collection.templates.isEmpty()) {
+            body += "{}";
+            continue;
+        }
+        QJsonObject item = collection.templates.at(i % collection.templates.size());
+        item.insert(QString::fromLatin1(collection.idMember), QString::fromLatin1(collection.idPrefix + QByteArray::number(i)));
+        body += QJsonDocument(item).toJson(QJsonDocument::Compact);
+    }
+    body += "]}";
+
+    Response response;
+    response.body = body;
+    return response;
+}
+
+#include "moc_mockgoogleserver.cpp"
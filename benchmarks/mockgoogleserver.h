@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QSslConfiguration>
+#include <QUrl>
+
+#include <atomic>
+
+class QCommandLineParser;
+class QTcpServer;
+
+/**
+ * Local stand-in for Google APIs, serving generated collections of
+ * Calendar events, Drive files, People connections and Tasks.
+ *
+ * Requests are expected to carry the original host as the first segment of
+ * the path, e.g. http://127.0.0.1:8080/www.googleapis.com/drive/v2/files,
+ * which is what MockNetworkAccessManager sends. Requests without the host
+ * are assumed to be sent to www.googleapis.com.
+ *
+ * Collections are paginated like the real APIs and their items are built
+ * from the autotest fixtures. Latency, bandwidth and errors can be injected
+ * to see how jobs cope with them.
+ */
+class MockGoogleServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Settings {
+        /** Number of items in every collection */
+        qsizetype items = 10000;
+        /** Page size used when the request does not ask for one */
+        qsizetype pageSize = 250;
+        /** Largest page size the server returns, regardless of the request */
+        qsizetype maxPageSize = 1000;
+        /** Delay before the server starts sending a reply */
+        int latency = 0;
+        /** Bytes per second sent over each connection, 0 for unlimited */
+        qint64 bandwidth = 0;
+        /** Probability of rejecting a request with 429 rateLimitExceeded */
+        double quotaErrorRate = 0.0;
+        /** Probability of failing a request with a 5xx error */
+        double serverErrorRate = 0.0;
+        /** Seed of the random generator that decides which requests fail */
+        quint32 seed = 1;
+        /** Directory with the autotest fixtures */
+        QString fixturesDir;
+        /** Serve HTTPS when a local certificate and key are set */
+        QSslConfiguration sslConfiguration;
+    };
+
+    struct Response {
+        int status = 200;
+        QList<QPair<QByteArray, QByteArray>> headers;
+        QByteArray body;
+    };
+
+    /**
+     * Adds options for all settings, shared by the server and the benchmark driver
+     */
+    static void addOptions(QCommandLineParser &parser);
+    static Settings settingsFromOptions(const QCommandLineParser &parser);
+
+    explicit MockGoogleServer(const Settings &settings, QObject *parent = nullptr);
+    ~MockGoogleServer() override;
+
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+    QUrl url() const;
+
+    const Settings &settings() const;
+
+    qint64 requestsServed() const;
+    qint64 errorsInjected() const;
+
+    /**
+     * Builds the reply to a request, used by the connections of the server
+     */
+    Response handleRequest(const QByteArray &method, const QByteArray &target, const QHash<QByteArray, QByteArray> &headers);
+
+private:
+    struct Collection {
+        QByteArray kind;
+        QByteArray itemsMember;
+        QByteArray idMember;
+        QByteArray idPrefix;
+        QByteArray pageSizeParam;
+        // Drive v2 links to the next page, the other APIs send only the token
+        bool nextLink = false;
+        QList<QJsonObject> templates;
+    };
+
+    Response collectionPage(const Collection &collection, const QString &host, const QUrl &url);
+    static Response error(int status, const QByteArray &reason, const QByteArray &message);
+    void loadCollections();
+
+    void newConnection();
+
+    Settings mSettings;
+    QTcpServer *mServer = nullptr;
+    QRandomGenerator mRandom;
+    QHash<QByteArray, Collection> mCollections;
+    std::atomic<qint64> mRequestsServed = 0;
+    std::atomic<qint64> mErrorsInjected = 0;
+};
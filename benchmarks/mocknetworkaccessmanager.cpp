@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "mocknetworkaccessmanager.h"
+
+#include <QNetworkRequest>
+
+#include <cstring>
+
+ForwardingReply::ForwardingReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QNetworkReply *inner, QObject *parent)
+    : QNetworkReply(parent)
+    , mInner(inner)
+{
+    inner->setParent(this);
+    setRequest(request);
+    setUrl(request.url());
+    setOperation(operation);
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    connect(inner, &QNetworkReply::socketStartedConnecting, this, &QNetworkReply::socketStartedConnecting);
+    connect(inner, &QNetworkReply::requestSent, this, &QNetworkReply::requestSent);
+    connect(inner, &QNetworkReply::encrypted, this, &QNetworkReply::encrypted);
+    connect(inner, &QNetworkReply::uploadProgress, this, &QNetworkReply::uploadProgress);
+    connect(inner, &QNetworkReply::downloadProgress, this, &QNetworkReply::downloadProgress);
+    connect(inner, &QNetworkReply::metaDataChanged, this, [this]() {
+        copyMetaData();
+        Q_EMIT metaDataChanged();
+    });
+    connect(inner, &QNetworkReply::readyRead, this, &ForwardingReply::readInner);
+    connect(inner, &QNetworkReply::finished, this, &ForwardingReply::innerFinished);
+    // The mock server uses a self-signed certificate
+    connect(inner, &QNetworkReply::sslErrors, inner, qOverload<>(&QNetworkReply::ignoreSslErrors));
+}
+
+void ForwardingReply::abort()
+{
+    mInner->abort();
+}
+
+qint64 ForwardingReply::bytesAvailable() const
+{
+    return mBuffer.size() + QNetworkReply::bytesAvailable();
+}
+
+bool ForwardingReply::isSequential() const
+{
+    return true;
+}
+
+qint64 ForwardingReply::readData(char *data, qint64 maxSize)
+{
+    const qint64 size = qMin<qint64>(maxSize, mBuffer.size());
+    if (size == 0 && isFinished()) {
+        return -1;
+    }
+    std::memcpy(data, mBuffer.constData(), size);
+    mBuffer.remove(0, size);
+    return size;
+}
+
+void ForwardingReply::copyMetaData()
+{
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, mInner->attribute(QNetworkRequest::HttpStatusCodeAttribute));
+    setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, mInner->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+    for (const auto &header : mInner->rawHeaderPairs()) {
+        setRawHeader(header.first, header.second);
+    }
+}
+
+void ForwardingReply::readInner()
+{
+    mBuffer += mInner->readAll();
+    Q_EMIT readyRead();
+}
+
+void ForwardingReply::innerFinished()
+{
+    copyMetaData();
+    if (mInner->bytesAvailable() > 0) {
+        readInner();
+    }
+    if (mInner->error() != QNetworkReply::NoError) {
+        setError(mInner->error(), mInner->errorString());
+        Q_EMIT errorOccurred(mInner->error());
+    }
+    setFinished(true);
+    Q_EMIT finished();
+}
+
+MockNetworkAccessManager::MockNetworkAccessManager(const QUrl &serverUrl, QObject *parent)
+    : QNetworkAccessManager(parent)
+    , mServerUrl(serverUrl)
+    , mForwarder(new QNetworkAccessManager(this))
+{
+}
+
+QNetworkReply *MockNetworkAccessManager::createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+    const QUrl originalUrl = request.url();
+    if (!originalUrl.host().endsWith(QLatin1StringView("googleapis.com"))) {
+        return QNetworkAccessManager::createRequest(op, request, outgoingData);
+    }
+
+    // The mock server expects the original host as the first segment of the path
+    QUrl url = mServerUrl;
+    url.setPath(QLatin1Char('/') + originalUrl.host() + originalUrl.path());
+    url.setQuery(originalUrl.query(QUrl::FullyEncoded), QUrl::StrictMode);
+
+    QNetworkRequest forwarded(request);
+    forwarded.setUrl(url);
+    forwarded.setOriginatingObject(nullptr);
+
+    QNetworkReply *inner = nullptr;
+    const QByteArray verb = request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+    switch (op) {
+    case HeadOperation:
+        inner = mForwarder->head(forwarded);
+        break;
+    case GetOperation:
+        inner = mForwarder->get(forwarded);
+        break;
+    case PutOperation:
+        inner = mForwarder->put(forwarded, outgoingData);
+        break;
+    case PostOperation:
+        inner = mForwarder->post(forwarded, outgoingData);
+        break;
+    case DeleteOperation:
+        inner = mForwarder->deleteResource(forwarded);
+        break;
+    default:
+        inner = mForwarder->sendCustomRequest(forwarded, verb, outgoingData);
+        break;
+    }
+
+    // QNetworkAccessManager relays finished() of the returned reply to its own finished() signal
+    return new ForwardingReply(op, request, inner, this);
+}
+
+MockNetworkAccessManagerFactory::MockNetworkAccessManagerFactory(const QUrl &serverUrl)
+    : mServerUrl(serverUrl)
+{
+}
+
+QNetworkAccessManager *MockNetworkAccessManagerFactory::networkAccessManager(QObject *parent) const
+{
+    return new MockNetworkAccessManager(mServerUrl, parent);
+}
+
+#include "moc_mocknetworkaccessmanager.cpp"
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "../src/core/networkaccessmanagerfactory_p.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QUrl>
+
+/**
+ * Reply to a request sent to Google, received from the mock server
+ *
+ * The reply pretends to be the reply to the original request, so jobs see
+ * the URLs they have requested, but all data and metadata come from the
+ * reply of the mock server.
+ */
+class ForwardingReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    ForwardingReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QNetworkReply *inner, QObject *parent);
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+    void copyMetaData();
+    void readInner();
+    void innerFinished();
+
+    QNetworkReply *const mInner;
+    QByteArray mBuffer;
+};
+
+/**
+ * Network access manager that sends all requests to Google APIs to a MockGoogleServer
+ */
+class MockNetworkAccessManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+public:
+    MockNetworkAccessManager(const QUrl &serverUrl, QObject *parent = nullptr);
+
+protected:
+    QNetworkReply *createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) override;
+
+private:
+    const QUrl mServerUrl;
+    // Sends the rewritten requests, so that the shared manager never sees replies of the mock server
+    QNetworkAccessManager *const mForwarder;
+};
+
+class MockNetworkAccessManagerFactory : public KGAPI2::NetworkAccessManagerFactory
+{
+public:
+    explicit MockNetworkAccessManagerFactory(const QUrl &serverUrl);
+
+    QNetworkAccessManager *networkAccessManager(QObject *parent = nullptr) const override;
+
+private:
+    const QUrl mServerUrl;
+};
@@ -0,0 +1,33 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <iostream>
+
+#include "mockgoogleserver.h"
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("kgapi-mockserver"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Local stand-in for the Calendar, Drive, People and Tasks APIs"));
+    parser.addHelpOption();
+    parser.addOption({QStringLiteral("port"), QStringLiteral("Port to listen on, 0 picks a free one."), QStringLiteral("port"), QStringLiteral("0")});
+    MockGoogleServer::addOptions(parser);
+    parser.process(app);
+
+    MockGoogleServer server(MockGoogleServer::settingsFromOptions(parser));
+    if (!server.listen(QHostAddress::LocalHost, parser.value(QStringLiteral("port")).toUShort())) {
+        return 1;
+    }
+
+    std::cout << "Listening on " << qPrintable(server.url().toString()) << std::endl;
+    return app.exec();
+}
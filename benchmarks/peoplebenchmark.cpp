@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+
+#include "benchmarkutils.h"
+
+#include "people/person.h"
+
+using namespace KGAPI2;
+using namespace KGAPI2::People;
+
+class PeopleBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    QJsonArray personObjects(qsizetype items)
+    {
+        const QByteArray feed = Benchmark::buildFeed(R"("totalItems": 0)",
+                                                     {Benchmark::readFixture(QStringLiteral("people/data/person1.json")),
+                                                      Benchmark::readFixture(QStringLiteral("people/data/person2.json"))},
+                                                     items);
+        return QJsonDocument::fromJson(feed).object().value(QStringLiteral("items")).toArray();
+    }
+
+private Q_SLOTS:
+    void benchmarkPersonFromJSON_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkPersonFromJSON()
+    {
+        QFETCH(qsizetype, items);
+        const QJsonArray objects = personObjects(items);
+        QCOMPARE(objects.size(), items);
+
+        const auto parse = [&objects]() {
+            qsizetype count = 0;
+            for (const auto &object : objects) {
+                count += Person::fromJSON(object.toObject()) ? 1 : 0;
+            }
+            return count;
+        };
+
+        Benchmark::report("Person::fromJSON", items, QJsonDocument(objects).toJson(QJsonDocument::Compact).size(), parse);
+        QBENCHMARK {
+            QCOMPARE(parse(), items);
+        }
+    }
+
+    void benchmarkPersonToJSON_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkPersonToJSON()
+    {
+        QFETCH(qsizetype, items);
+        const QJsonArray objects = personObjects(items);
+        QList<PersonPtr> persons;
+        persons.reserve(objects.size());
+        for (const auto &object : objects) {
+            persons << Person::fromJSON(object.toObject());
+        }
+
+        const auto serialize = [&persons]() {
+            qsizetype bytes = 0;
+            for (const auto &person : persons) {
+                bytes += QJsonDocument(person->toJSON().toObject()).toJson(QJsonDocument::Compact).size();
+            }
+            return bytes;
+        };
+
+        const qsizetype bytes = serialize();
+        Benchmark::report("Person::toJSON", items, bytes, serialize);
+        QBENCHMARK {
+            QCOMPARE(serialize(), bytes);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PeopleBenchmark)
+
+#include "peoplebenchmark.moc"
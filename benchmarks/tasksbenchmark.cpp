@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QHash>
+#include <QObject>
+#include <QTest>
+
+#include "benchmarkutils.h"
+
+#include "tasksservice.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class TasksBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    QByteArray taskFeed(qsizetype items)
+    {
+        auto feed = mTaskFeeds.find(items);
+        if (feed == mTaskFeeds.end()) {
+            feed = mTaskFeeds.insert(items,
+                                     Benchmark::buildFeed(R"("kind": "tasks#tasks")",
+                                                          {Benchmark::readFixture(QStringLiteral("tasks/data/task1.json")),
+                                                           Benchmark::readFixture(QStringLiteral("tasks/data/task2.json"))},
+                                                          items));
+        }
+        return *feed;
+    }
+
+    QHash<qsizetype, QByteArray> mTaskFeeds;
+
+private Q_SLOTS:
+    void benchmarkTaskFeed_data()
+    {
+        Benchmark::addFeedSizes();
+    }
+
+    void benchmarkTaskFeed()
+    {
+        QFETCH(qsizetype, items);
+        const QByteArray feed = taskFeed(items);
+
+        Benchmark::report("TasksService::parseJSONFeed", items, feed.size(), [&feed]() {
+            FeedData feedData;
+            TasksService::parseJSONFeed(feed, feedData);
+        });
+        QBENCHMARK {
+            FeedData feedData;
+            QCOMPARE(TasksService::parseJSONFeed(feed, feedData).size(), items);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TasksBenchmark)
+
+#include "tasksbenchmark.moc"
@@ -49,11 +49,14 @@ void CalendarCreateJob::start()
         return;
     }
 
-    const CalendarPtr calendar = d->calendars.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::createCalendarUrl());
-    const QByteArray rawData = CalendarService::calendarToJSON(calendar);
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->calendars.hasUnqueued()) {
+        const CalendarPtr calendar = d->calendars.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::createCalendarUrl());
+        const QByteArray rawData = CalendarService::calendarToJSON(calendar);
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList CalendarCreateJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
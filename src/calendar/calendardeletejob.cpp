@@ -60,10 +60,13 @@ void CalendarDeleteJob::start()
         return;
     }
 
-    const QString calendarId = d->calendarsIds.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::removeCalendarUrl(calendarId));
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->calendarsIds.hasUnqueued()) {
+        const QString calendarId = d->calendarsIds.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::removeCalendarUrl(calendarId));
 
-    enqueueRequest(request);
+        enqueueRequest(request);
+    }
 }
 
 void CalendarDeleteJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
@@ -46,11 +46,14 @@ void CalendarModifyJob::start()
         return;
     }
 
-    const CalendarPtr calendar = d->calendars.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::updateCalendarUrl(calendar->uid()));
-    const QByteArray rawData = CalendarService::calendarToJSON(calendar);
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->calendars.hasUnqueued()) {
+        const CalendarPtr calendar = d->calendars.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::updateCalendarUrl(calendar->uid()));
+        const QByteArray rawData = CalendarService::calendarToJSON(calendar);
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList CalendarModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
@@ -10,6 +10,7 @@
 #include "calendar.h"
 #include "debug.h"
 #include "event.h"
+#include "private/jsonreader_p.h"
 #include "reminder.h"
 #include "utils.h"
 
@@ -29,6 +30,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 
 namespace KGAPI2
 {
@@ -40,9 +42,6 @@ namespace Private
 {
 KCalendarCore::DateList parseRDate(const QString &rule);
 
-ObjectPtr JSONToCalendar(const QVariantMap &data);
-ObjectPtr JSONToEvent(const QVariantMap &data, const QString &timezone = QString());
-
 /**
  * Checks whether TZID is in Olson format and converts it to it if necessary
  *
@@ -197,39 +196,35 @@ QUrl freeBusyQueryUrl()
     return url;
 }
 
+QUrl batchUrl()
+{
+    QUrl url(Private::GoogleApisUrl);
+    url.setPath(QStringLiteral("/batch/calendar/v3"));
+    return url;
+}
+
 namespace
 {
 
 static const auto kindParam = QStringLiteral("kind");
 static const auto idParam = QStringLiteral("id");
-static const auto etagParam = QStringLiteral("etag");
 
-static const auto nextSyncTokenParam = QStringLiteral("nextSyncToken");
-static const auto nextPageTokenParam = QStringLiteral("nextPageToken");
 static const auto pageTokenParam = QStringLiteral("pageToken");
-static const auto itemsParam = QStringLiteral("items");
 
 static const auto calendarSummaryParam = QStringLiteral("summary");
 static const auto calendarDescriptionParam = QStringLiteral("description");
 static const auto calendarLocationParam = QStringLiteral("location");
 static const auto calendarTimezoneParam = QStringLiteral("timeZone");
-static const auto calendarBackgroundColorParam = QStringLiteral("backgroundColor");
-static const auto calendarForegroundColorParam = QStringLiteral("foregroundColor");
-static const auto calendarAccessRoleParam = QStringLiteral("accessRole");
-static const auto calendarDefaultRemindersParam = QStringLiteral("defaultReminders");
 static const auto reminderMethodParam = QStringLiteral("method");
 static const auto reminderMinutesParam = QStringLiteral("minutes");
 
 static const auto eventiCalUIDParam = QStringLiteral("iCalUID");
 static const auto eventStatusParam = QStringLiteral("status");
-static const auto eventCreatedParam = QStringLiteral("created");
-static const auto eventUpdatedParam = QStringLiteral("updated");
 static const auto eventSummaryParam = QStringLiteral("summary");
 static const auto eventDescriptionParam = QStringLiteral("description");
 static const auto eventLocationParam = QStringLiteral("location");
 static const auto eventStartPram = QStringLiteral("start");
 static const auto eventEndParam = QStringLiteral("end");
-static const auto eventOriginalStartTimeParam = QStringLiteral("originalStartTime");
 static const auto eventTransparencyParam = QStringLiteral("transparency");
 static const auto eventOrganizerParam = QStringLiteral("organizer");
 static const auto eventAttendeesParam = QStringLiteral("attendees");
@@ -249,7 +244,6 @@ static const auto organizerEmailParam = QStringLiteral("email");
 static const auto reminderUseDefaultParam = QStringLiteral("useDefault");
 static const auto reminderOverridesParam = QStringLiteral("overrides");
 
-static const auto propertyPrivateParam = QStringLiteral("private");
 static const auto propertySharedParam = QStringLiteral("shared");
 
 static const auto dateParam = QStringLiteral("date");
@@ -277,8 +271,6 @@ static const auto opaqueTransparency = QLatin1StringView("opaque");
 static const auto declinedStatus = QLatin1StringView("declined");
 static const auto categoriesProperty = QLatin1StringView("categories");
 
-static const auto hangoutLinkParam = QStringLiteral("hangoutLink");
-
 static const auto eventTypeParam = QStringLiteral("eventType");
 
 }
@@ -288,57 +280,131 @@ QString APIVersion()
     return QStringLiteral("3");
 }
 
-CalendarPtr JSONToCalendar(const QByteArray &jsonData)
+namespace
 {
-    const auto document = QJsonDocument::fromJson(jsonData);
-    const auto calendar = document.toVariant().toMap();
 
-    if (calendar.value(kindParam).toString() != calendarListEntryKind && calendar.value(kindParam).toString() != calendarKind) {
-        return CalendarPtr();
-    }
+struct ReminderData {
+    QString method;
+    int minutes = 0;
+};
 
-    return Private::JSONToCalendar(calendar).staticCast<Calendar>();
+void readReminder(JsonReader &reader, ReminderData &reminder)
+{
+    static const JsonFieldTable<ReminderData> fields{
+        {"method",
+         [](JsonReader &reader, ReminderData &reminder) {
+             reminder.method = reader.readString();
+         }},
+        {"minutes",
+         [](JsonReader &reader, ReminderData &reminder) {
+             reminder.minutes = static_cast<int>(reader.readInteger());
+         }},
+    };
+
+    fields.read(reader, reminder);
 }
 
-ObjectPtr Private::JSONToCalendar(const QVariantMap &data)
+QList<ReminderData> readReminders(JsonReader &reader)
 {
-    auto calendar = CalendarPtr::create();
-
-    const auto id = QUrl::fromPercentEncoding(data.value(idParam).toByteArray());
-    calendar->setUid(id);
-    calendar->setEtag(data.value(etagParam).toString());
-    calendar->setTitle(data.value(calendarSummaryParam).toString());
-    calendar->setDetails(data.value(calendarDescriptionParam).toString());
-    calendar->setLocation(data.value(calendarLocationParam).toString());
-    calendar->setTimezone(data.value(calendarTimezoneParam).toString());
-    calendar->setBackgroundColor(QColor(data.value(calendarBackgroundColorParam).toString()));
-    calendar->setForegroundColor(QColor(data.value(calendarForegroundColorParam).toString()));
-
-    if ((data.value(calendarAccessRoleParam).toString() == writerAccessRole) || (data.value(calendarAccessRoleParam).toString() == ownerAccessRole)) {
-        calendar->setEditable(true);
-    } else {
-        calendar->setEditable(false);
+    QList<ReminderData> reminders;
+    if (reader.beginArray()) {
+        while (reader.hasNext()) {
+            ReminderData reminder;
+            readReminder(reader, reminder);
+            reminders.push_back(reminder);
+        }
+        reader.endArray();
     }
+    return reminders;
+}
 
-    const auto reminders = data.value(calendarDefaultRemindersParam).toList();
-    for (const auto &r : reminders) {
-        const auto reminder = r.toMap();
+struct CalendarData {
+    CalendarPtr calendar = CalendarPtr::create();
+    QString kind;
+};
 
-        auto rem = ReminderPtr::create();
-        if (reminder.value(reminderMethodParam).toString() == emailMethod) {
-            rem->setType(KCalendarCore::Alarm::Email);
-        } else if (reminder.value(reminderMethodParam).toString() == popupMethod) {
-            rem->setType(KCalendarCore::Alarm::Display);
-        } else {
-            rem->setType(KCalendarCore::Alarm::Invalid);
-        }
+bool readCalendar(JsonReader &reader, CalendarData &data)
+{
+    static const JsonFieldTable<CalendarData> fields{
+        {"kind",
+         [](JsonReader &reader, CalendarData &data) {
+             data.kind = reader.readString();
+         }},
+        {"id",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setUid(QUrl::fromPercentEncoding(reader.readString().toUtf8()));
+         }},
+        {"etag",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setEtag(reader.readString());
+         }},
+        {"summary",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setTitle(reader.readString());
+         }},
+        {"description",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setDetails(reader.readString());
+         }},
+        {"location",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setLocation(reader.readString());
+         }},
+        {"timeZone",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setTimezone(reader.readString());
+         }},
+        {"backgroundColor",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setBackgroundColor(QColor(reader.readString()));
+         }},
+        {"foregroundColor",
+         [](JsonReader &reader, CalendarData &data) {
+             data.calendar->setForegroundColor(QColor(reader.readString()));
+         }},
+        {"accessRole",
+         [](JsonReader &reader, CalendarData &data) {
+             const auto accessRole = reader.readString();
+             data.calendar->setEditable(accessRole == writerAccessRole || accessRole == ownerAccessRole);
+         }},
+        {"defaultReminders",
+         [](JsonReader &reader, CalendarData &data) {
+             const auto reminders = readReminders(reader);
+             for (const auto &reminder : reminders) {
+                 auto rem = ReminderPtr::create();
+                 if (reminder.method == emailMethod) {
+                     rem->setType(KCalendarCore::Alarm::Email);
+                 } else if (reminder.method == popupMethod) {
+                     rem->setType(KCalendarCore::Alarm::Display);
+                 } else {
+                     rem->setType(KCalendarCore::Alarm::Invalid);
+                 }
+
+                 rem->setStartOffset(KCalendarCore::Duration(reminder.minutes * (-60)));
+
+                 data.calendar->addDefaultReminer(rem);
+             }
+         }},
+    };
+
+    return fields.read(reader, data);
+}
+
+} // namespace
 
-        rem->setStartOffset(KCalendarCore::Duration(reminder.value(reminderMinutesParam).toInt() * (-60)));
+CalendarPtr JSONToCalendar(const QByteArray &jsonData)
+{
+    JsonReader reader(jsonData);
+    CalendarData data;
+    if (!readCalendar(reader, data)) {
+        return CalendarPtr();
+    }
 
-        calendar->addDefaultReminer(rem);
+    if (data.kind != calendarListEntryKind && data.kind != calendarKind) {
+        return CalendarPtr();
     }
 
-    return calendar.dynamicCast<Object>();
+    return data.calendar;
 }
 
 QByteArray calendarToJSON(const CalendarPtr &calendar)
@@ -362,58 +428,101 @@ QByteArray calendarToJSON(const CalendarPtr &calendar)
 
 ObjectsList parseCalendarJSONFeed(const QByteArray &jsonFeed, FeedData &feedData)
 {
-    const auto document = QJsonDocument::fromJson(jsonFeed);
-    const auto data = document.toVariant().toMap();
-
-    ObjectsList list;
+    struct CalendarFeedData {
+        QString kind;
+        std::optional<QString> nextPageToken;
+        QByteArrayView items;
+    };
+
+    static const JsonFieldTable<CalendarFeedData> fields{
+        {"kind",
+         [](JsonReader &reader, CalendarFeedData &feed) {
+             feed.kind = reader.readString();
+         }},
+        {"nextPageToken",
+         [](JsonReader &reader, CalendarFeedData &feed) {
+             feed.nextPageToken = reader.readString();
+         }},
+        {"items",
+         [](JsonReader &reader, CalendarFeedData &feed) {
+             feed.items = reader.readRawValue();
+         }},
+    };
+
+    JsonReader reader(jsonFeed);
+    CalendarFeedData feed;
+    if (!fields.read(reader, feed)) {
+        qCWarning(KGAPIDebug) << "Error parsing calendar feed:" << reader.errorString();
+        return {};
+    }
 
-    if (data.value(kindParam).toString() == calendarListKind) {
-        if (data.contains(nextPageTokenParam)) {
+    if (feed.kind == calendarListKind) {
+        if (feed.nextPageToken.has_value()) {
             feedData.nextPageUrl = fetchCalendarsUrl();
             QUrlQuery query(feedData.nextPageUrl);
-            query.addQueryItem(pageTokenParam, data.value(nextPageTokenParam).toString());
+            query.addQueryItem(pageTokenParam, *feed.nextPageToken);
             feedData.nextPageUrl.setQuery(query);
         }
     } else {
         return {};
     }
 
-    const auto items = data.value(itemsParam).toList();
-    list.reserve(items.size());
-    for (const auto &i : items) {
-        list.push_back(Private::JSONToCalendar(i.toMap()));
+    ObjectsList list;
+    if (feed.items.isEmpty()) {
+        return list;
+    }
+
+    JsonReader itemsReader(feed.items);
+    if (itemsReader.beginArray()) {
+        while (itemsReader.hasNext()) {
+            CalendarData data;
+            readCalendar(itemsReader, data);
+            list.push_back(data.calendar);
+        }
+        itemsReader.endArray();
     }
 
     return list;
 }
 
-EventPtr JSONToEvent(const QByteArray &jsonData)
+namespace
 {
-    QJsonParseError error;
-    QJsonDocument document = QJsonDocument::fromJson(jsonData, &error);
-    if (error.error != QJsonParseError::NoError) {
-        qCWarning(KGAPIDebug) << "Error parsing event JSON: " << error.errorString();
-    }
-    QVariantMap data = document.toVariant().toMap();
-    if (data.value(kindParam).toString() != eventKind) {
-        return EventPtr();
-    }
 
-    return Private::JSONToEvent(data).staticCast<Event>();
-}
+struct DtData {
+    std::optional<QString> date;
+    std::optional<QString> dateTime;
+    std::optional<QString> timeZone;
+};
 
-namespace
+void readDt(JsonReader &reader, DtData &dt)
 {
+    static const JsonFieldTable<DtData> fields{
+        {"date",
+         [](JsonReader &reader, DtData &dt) {
+             dt.date = reader.readString();
+         }},
+        {"dateTime",
+         [](JsonReader &reader, DtData &dt) {
+             dt.dateTime = reader.readString();
+         }},
+        {"timeZone",
+         [](JsonReader &reader, DtData &dt) {
+             dt.timeZone = reader.readString();
+         }},
+    };
+
+    fields.read(reader, dt);
+}
 
 struct ParsedDt {
     QDateTime dt;
     bool isAllDay;
 };
 
-ParsedDt parseDt(const QVariantMap &data, const QString &timezone, bool isDtEnd)
+ParsedDt parseDt(const DtData &data, const QString &timezone, bool isDtEnd)
 {
-    if (data.contains(dateParam)) {
-        auto dt = QDateTime::fromString(data.value(dateParam).toString(), Qt::ISODate);
+    if (data.date.has_value()) {
+        auto dt = QDateTime::fromString(*data.date, Qt::ISODate);
         if (isDtEnd) {
             // Google reports all-day events to end on the next day, e.g. a
             // Monday all-day event will be reporting as starting on Monday and
@@ -422,15 +531,15 @@ ParsedDt parseDt(const QVariantMap &data, const QString &timezone, bool isDtEnd)
             dt = dt.addDays(-1);
         }
         return {dt, true};
-    } else if (data.contains(dateTimeParam)) {
-        auto dt = Utils::rfc3339DateFromString(data.value(dateTimeParam).toString());
+    } else if (data.dateTime.has_value()) {
+        auto dt = Utils::rfc3339DateFromString(*data.dateTime);
         // If there's a timezone specified in the "start" entity, then use it
-        if (data.contains(timeZoneParam)) {
-            const QTimeZone tz = QTimeZone(data.value(timeZoneParam).toString().toUtf8());
+        if (data.timeZone.has_value()) {
+            const QTimeZone tz = QTimeZone(data.timeZone->toUtf8());
             if (tz.isValid()) {
                 dt = dt.toTimeZone(tz);
             } else {
-                qCWarning(KGAPIDebug) << "Invalid timezone" << data.value(timeZoneParam).toString();
+                qCWarning(KGAPIDebug) << "Invalid timezone" << *data.timeZone;
             }
 
             // Otherwise try to fallback to calendar-wide timezone
@@ -448,101 +557,309 @@ ParsedDt parseDt(const QVariantMap &data, const QString &timezone, bool isDtEnd)
     }
 }
 
-void setEventCategories(EventPtr &event, const QVariantMap &properties)
+struct AttendeeData {
+    QString displayName;
+    QString email;
+    QString responseStatus;
+    QString id;
+    bool optional = false;
+};
+
+KCalendarCore::Attendee readAttendee(JsonReader &reader)
+{
+    static const JsonFieldTable<AttendeeData> fields{
+        {"displayName",
+         [](JsonReader &reader, AttendeeData &data) {
+             data.displayName = reader.readString();
+         }},
+        {"email",
+         [](JsonReader &reader, AttendeeData &data) {
+             data.email = reader.readString();
+         }},
+        {"responseStatus",
+         [](JsonReader &reader, AttendeeData &data) {
+             data.responseStatus = reader.readString();
+         }},
+        {"id",
+         [](JsonReader &reader, AttendeeData &data) {
+             data.id = reader.readString();
+         }},
+        {"optional",
+         [](JsonReader &reader, AttendeeData &data) {
+             data.optional = reader.readBool();
+         }},
+    };
+
+    AttendeeData data;
+    fields.read(reader, data);
+
+    KCalendarCore::Attendee attendee(data.displayName, data.email);
+    if (data.responseStatus == acceptedStatus) {
+        attendee.setStatus(KCalendarCore::Attendee::Accepted);
+    } else if (data.responseStatus == declinedStatus) {
+        attendee.setStatus(KCalendarCore::Attendee::Declined);
+    } else if (data.responseStatus == tentativeStatus) {
+        attendee.setStatus(KCalendarCore::Attendee::Tentative);
+    } else {
+        attendee.setStatus(KCalendarCore::Attendee::NeedsAction);
+    }
+
+    if (data.optional) {
+        attendee.setRole(KCalendarCore::Attendee::OptParticipant);
+    }
+    if (!data.id.isEmpty()) {
+        attendee.setUid(data.id);
+    } else {
+        // Set some UID, just so that the results are reproducible
+        attendee.setUid(QString::number(qHash(attendee.email())));
+    }
+
+    return attendee;
+}
+
+KCalendarCore::Person readOrganizer(JsonReader &reader)
 {
-    for (auto iter = properties.cbegin(), end = properties.cend(); iter != end; ++iter) {
-        if (iter.key() == categoriesProperty) {
-            event->setCategories(iter.value().toString());
+    static const JsonFieldTable<KCalendarCore::Person> fields{
+        {"displayName",
+         [](JsonReader &reader, KCalendarCore::Person &organizer) {
+             organizer.setName(reader.readString());
+         }},
+        {"email",
+         [](JsonReader &reader, KCalendarCore::Person &organizer) {
+             organizer.setEmail(reader.readString());
+         }},
+    };
+
+    KCalendarCore::Person organizer;
+    fields.read(reader, organizer);
+    return organizer;
+}
+
+std::optional<QString> readCategories(JsonReader &reader)
+{
+    std::optional<QString> categories;
+    if (reader.beginObject()) {
+        while (reader.hasNext()) {
+            if (QLatin1StringView(reader.nextName()) == categoriesProperty) {
+                categories = reader.readString();
+            } else {
+                reader.skipValue();
+            }
         }
+        reader.endObject();
     }
+    return categories;
 }
 
-} // namespace
+struct EventData {
+    QString kind;
+    QString id;
+    QString hangoutLink;
+    QString iCalUID;
+    QString etag;
+    QString status;
+    QString created;
+    QString updated;
+    QString summary;
+    QString description;
+    QString location;
+    DtData start;
+    DtData end;
+    std::optional<DtData> originalStartTime;
+    QString transparency;
+    QList<KCalendarCore::Attendee> attendees;
+    KCalendarCore::Person organizer;
+    QStringList recurrence;
+    bool useDefaultReminders = false;
+    QList<ReminderData> reminderOverrides;
+    std::optional<QString> privateCategories;
+    std::optional<QString> sharedCategories;
+    QString eventType;
+};
+
+void readEventReminders(JsonReader &reader, EventData &data)
+{
+    static const JsonFieldTable<EventData> fields{
+        {"useDefault",
+         [](JsonReader &reader, EventData &data) {
+             data.useDefaultReminders = reader.readBool();
+         }},
+        {"overrides",
+         [](JsonReader &reader, EventData &data) {
+             data.reminderOverrides = readReminders(reader);
+         }},
+    };
+
+    fields.read(reader, data);
+}
+
+void readEventExtendedProperties(JsonReader &reader, EventData &data)
+{
+    static const JsonFieldTable<EventData> fields{
+        {"private",
+         [](JsonReader &reader, EventData &data) {
+             data.privateCategories = readCategories(reader);
+         }},
+        {"shared",
+         [](JsonReader &reader, EventData &data) {
+             data.sharedCategories = readCategories(reader);
+         }},
+    };
+
+    fields.read(reader, data);
+}
+
+bool readEvent(JsonReader &reader, EventData &data)
+{
+    static const JsonFieldTable<EventData> fields{
+        {"kind",
+         [](JsonReader &reader, EventData &data) {
+             data.kind = reader.readString();
+         }},
+        {"id",
+         [](JsonReader &reader, EventData &data) {
+             data.id = reader.readString();
+         }},
+        {"hangoutLink",
+         [](JsonReader &reader, EventData &data) {
+             data.hangoutLink = reader.readString();
+         }},
+        {"iCalUID",
+         [](JsonReader &reader, EventData &data) {
+             data.iCalUID = reader.readString();
+         }},
+        {"etag",
+         [](JsonReader &reader, EventData &data) {
+             data.etag = reader.readString();
+         }},
+        {"status",
+         [](JsonReader &reader, EventData &data) {
+             data.status = reader.readString();
+         }},
+        {"created",
+         [](JsonReader &reader, EventData &data) {
+             data.created = reader.readString();
+         }},
+        {"updated",
+         [](JsonReader &reader, EventData &data) {
+             data.updated = reader.readString();
+         }},
+        {"summary",
+         [](JsonReader &reader, EventData &data) {
+             data.summary = reader.readString();
+         }},
+        {"description",
+         [](JsonReader &reader, EventData &data) {
+             data.description = reader.readString();
+         }},
+        {"location",
+         [](JsonReader &reader, EventData &data) {
+             data.location = reader.readString();
+         }},
+        {"start",
+         [](JsonReader &reader, EventData &data) {
+             readDt(reader, data.start);
+         }},
+        {"end",
+         [](JsonReader &reader, EventData &data) {
+             readDt(reader, data.end);
+         }},
+        {"originalStartTime",
+         [](JsonReader &reader, EventData &data) {
+             readDt(reader, data.originalStartTime.emplace());
+         }},
+        {"transparency",
+         [](JsonReader &reader, EventData &data) {
+             data.transparency = reader.readString();
+         }},
+        {"attendees",
+         [](JsonReader &reader, EventData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     data.attendees.push_back(readAttendee(reader));
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"organizer",
+         [](JsonReader &reader, EventData &data) {
+             data.organizer = readOrganizer(reader);
+         }},
+        {"recurrence",
+         [](JsonReader &reader, EventData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     data.recurrence.push_back(reader.readString());
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"reminders", readEventReminders},
+        {"extendedProperties", readEventExtendedProperties},
+        {"eventType",
+         [](JsonReader &reader, EventData &data) {
+             data.eventType = reader.readString();
+         }},
+    };
+
+    return fields.read(reader, data);
+}
 
-ObjectPtr Private::JSONToEvent(const QVariantMap &data, const QString &timezone)
+EventPtr eventFromData(const EventData &data, const QString &timezone)
 {
     auto event = EventPtr::create();
 
-    event->setId(data.value(idParam).toString());
-    event->setHangoutLink(data.value(hangoutLinkParam).toString());
-    event->setUid(data.value(eventiCalUIDParam).toString());
-    event->setEtag(data.value(etagParam).toString());
+    event->setId(data.id);
+    event->setHangoutLink(data.hangoutLink);
+    event->setUid(data.iCalUID);
+    event->setEtag(data.etag);
 
-    if (data.value(eventStatusParam).toString() == confirmedStatus) {
+    if (data.status == confirmedStatus) {
         event->setStatus(KCalendarCore::Incidence::StatusConfirmed);
-    } else if (data.value(eventStatusParam).toString() == canceledStatus) {
+    } else if (data.status == canceledStatus) {
         event->setStatus(KCalendarCore::Incidence::StatusCanceled);
         event->setDeleted(true);
-    } else if (data.value(eventStatusParam).toString() == tentativeStatus) {
+    } else if (data.status == tentativeStatus) {
         event->setStatus(KCalendarCore::Incidence::StatusTentative);
     } else {
         event->setStatus(KCalendarCore::Incidence::StatusNone);
     }
 
-    event->setCreated(Utils::rfc3339DateFromString(data.value(eventCreatedParam).toString()));
-    event->setLastModified(Utils::rfc3339DateFromString(data.value(eventUpdatedParam).toString()));
-    event->setSummary(data.value(eventSummaryParam).toString());
-    event->setDescription(data.value(eventDescriptionParam).toString());
-    event->setLocation(data.value(eventLocationParam).toString());
+    event->setCreated(Utils::rfc3339DateFromString(data.created));
+    event->setLastModified(Utils::rfc3339DateFromString(data.updated));
+    event->setSummary(data.summary);
+    event->setDescription(data.description);
+    event->setLocation(data.location);
 
-    const auto dtStart = parseDt(data.value(eventStartPram).toMap(), timezone, false);
+    const auto dtStart = parseDt(data.start, timezone, false);
     event->setDtStart(dtStart.dt);
     event->setAllDay(dtStart.isAllDay);
 
-    const auto dtEnd = parseDt(data.value(eventEndParam).toMap(), timezone, true);
+    const auto dtEnd = parseDt(data.end, timezone, true);
     event->setDtEnd(dtEnd.dt);
 
-    if (data.contains(eventOriginalStartTimeParam)) {
-        const auto recurrenceId = parseDt(data.value(eventOriginalStartTimeParam).toMap(), timezone, false);
+    if (data.originalStartTime.has_value()) {
+        const auto recurrenceId = parseDt(*data.originalStartTime, timezone, false);
         event->setRecurrenceId(recurrenceId.dt);
     }
 
-    if (data.value(eventTransparencyParam).toString() == transparentTransparency) {
+    if (data.transparency == transparentTransparency) {
         event->setTransparency(Event::Transparent);
     } else { /* Assume opaque as default transparency */
         event->setTransparency(Event::Opaque);
     }
 
-    const auto attendees = data.value(eventAttendeesParam).toList();
-    for (const auto &a : attendees) {
-        const auto att = a.toMap();
-        KCalendarCore::Attendee attendee(att.value(attendeeDisplayNameParam).toString(), att.value(attendeeEmailParam).toString());
-        const auto responseStatus = att.value(attendeeResponseStatusParam).toString();
-        if (responseStatus == acceptedStatus) {
-            attendee.setStatus(KCalendarCore::Attendee::Accepted);
-        } else if (responseStatus == declinedStatus) {
-            attendee.setStatus(KCalendarCore::Attendee::Declined);
-        } else if (responseStatus == tentativeStatus) {
-            attendee.setStatus(KCalendarCore::Attendee::Tentative);
-        } else {
-            attendee.setStatus(KCalendarCore::Attendee::NeedsAction);
-        }
-
-        if (att.value(attendeeOptionalParam).toBool()) {
-            attendee.setRole(KCalendarCore::Attendee::OptParticipant);
-        }
-        const auto uid = att.value(idParam).toString();
-        if (!uid.isEmpty()) {
-            attendee.setUid(uid);
-        } else {
-            // Set some UID, just so that the results are reproducible
-            attendee.setUid(QString::number(qHash(attendee.email())));
-        }
+    for (const auto &attendee : data.attendees) {
         event->addAttendee(attendee, true);
     }
 
     /* According to RFC, only events with attendees can have an organizer.
      * Google seems to ignore it, so we must take care of it here */
     if (event->attendeeCount() > 0) {
-        KCalendarCore::Person organizer;
-        const auto organizerData = data.value(eventOrganizerParam).toMap();
-        organizer.setName(organizerData.value(organizerDisplayNameParam).toString());
-        organizer.setEmail(organizerData.value(organizerEmailParam).toString());
-        event->setOrganizer(organizer);
+        event->setOrganizer(data.organizer);
     }
 
-    const QStringList recrs = data.value(eventRecurrenceParam).toStringList();
-    for (const QString &rec : recrs) {
+    for (const QString &rec : data.recurrence) {
         KCalendarCore::ICalFormat format;
         const QStringView recView(rec);
         if (recView.left(5) == QLatin1StringView("RRULE")) {
@@ -566,44 +883,58 @@ ObjectPtr Private::JSONToEvent(const QVariantMap &data, const QString &timezone)
         }
     }
 
-    const auto reminders = data.value(eventRemindersParam).toMap();
-    if (reminders.contains(reminderUseDefaultParam) && reminders.value(reminderUseDefaultParam).toBool()) {
-        event->setUseDefaultReminders(true);
-    } else {
-        event->setUseDefaultReminders(false);
-    }
+    event->setUseDefaultReminders(data.useDefaultReminders);
 
-    const auto overrides = reminders.value(reminderOverridesParam).toList();
-    for (const auto &r : overrides) {
-        const auto reminderOverride = r.toMap();
+    for (const auto &reminderOverride : data.reminderOverrides) {
         auto alarm = KCalendarCore::Alarm::Ptr::create(static_cast<KCalendarCore::Incidence *>(event.data()));
         alarm->setTime(event->dtStart());
 
-        if (reminderOverride.value(reminderMethodParam).toString() == popupMethod) {
+        if (reminderOverride.method == popupMethod) {
             alarm->setType(KCalendarCore::Alarm::Display);
-        } else if (reminderOverride.value(reminderMethodParam).toString() == emailMethod) {
+        } else if (reminderOverride.method == emailMethod) {
             alarm->setType(KCalendarCore::Alarm::Email);
         } else {
             alarm->setType(KCalendarCore::Alarm::Invalid);
             continue;
         }
 
-        alarm->setStartOffset(KCalendarCore::Duration(reminderOverride.value(reminderMinutesParam).toInt() * (-60)));
+        alarm->setStartOffset(KCalendarCore::Duration(reminderOverride.minutes * (-60)));
         alarm->setEnabled(true);
         event->addAlarm(alarm);
     }
 
-    const auto extendedProperties = data.value(eventExtendedPropertiesParam).toMap();
-    setEventCategories(event, extendedProperties.value(propertyPrivateParam).toMap());
-    setEventCategories(event, extendedProperties.value(propertySharedParam).toMap());
+    if (data.privateCategories.has_value()) {
+        event->setCategories(*data.privateCategories);
+    }
+    if (data.sharedCategories.has_value()) {
+        event->setCategories(*data.sharedCategories);
+    }
 
-    if (const auto eventType = data.value(eventTypeParam).toString(); !eventType.isEmpty()) {
-        event->setEventType(eventTypeFromString(eventType));
+    if (!data.eventType.isEmpty()) {
+        event->setEventType(eventTypeFromString(data.eventType));
     } else {
         event->setEventType(Event::EventType::Default);
     }
 
-    return event.dynamicCast<Object>();
+    return event;
+}
+
+} // namespace
+
+EventPtr JSONToEvent(const QByteArray &jsonData)
+{
+    JsonReader reader(jsonData);
+    EventData data;
+    if (!readEvent(reader, data)) {
+        qCWarning(KGAPIDebug) << "Error parsing event JSON: " << reader.errorString();
+        return EventPtr();
+    }
+
+    if (data.kind != eventKind) {
+        return EventPtr();
+    }
+
+    return eventFromData(data, QString());
 }
 
 namespace
@@ -792,37 +1123,80 @@ QByteArray eventToJSON(const EventPtr &event, EventSerializeFlags flags)
 
 ObjectsList parseEventJSONFeed(const QByteArray &jsonFeed, FeedData &feedData)
 {
-    const auto document = QJsonDocument::fromJson(jsonFeed);
-    const auto data = document.toVariant().toMap();
+    struct EventFeedData {
+        QString kind;
+        std::optional<QString> nextPageToken;
+        std::optional<QString> timeZone;
+        std::optional<QString> nextSyncToken;
+        QByteArrayView items;
+    };
+
+    static const JsonFieldTable<EventFeedData> fields{
+        {"kind",
+         [](JsonReader &reader, EventFeedData &feed) {
+             feed.kind = reader.readString();
+         }},
+        {"nextPageToken",
+         [](JsonReader &reader, EventFeedData &feed) {
+             feed.nextPageToken = reader.readString();
+         }},
+        {"timeZone",
+         [](JsonReader &reader, EventFeedData &feed) {
+             feed.timeZone = reader.readString();
+         }},
+        {"nextSyncToken",
+         [](JsonReader &reader, EventFeedData &feed) {
+             feed.nextSyncToken = reader.readString();
+         }},
+        {"items",
+         [](JsonReader &reader, EventFeedData &feed) {
+             // The items depend on the feed-wide timezone, which may come
+             // only after them, so parse them once the whole feed is read.
+             feed.items = reader.readRawValue();
+         }},
+    };
+
+    JsonReader reader(jsonFeed);
+    EventFeedData feed;
+    if (!fields.read(reader, feed)) {
+        qCWarning(KGAPIDebug) << "Error parsing event feed:" << reader.errorString();
+        return {};
+    }
 
     QString timezone;
-    if (data.value(kindParam) == eventsKind) {
-        if (data.contains(nextPageTokenParam)) {
-            QString calendarId = feedData.requestUrl.toString().remove(QStringLiteral("https://www.googleapis.com/calendar/v3/calendars/"));
-            calendarId = calendarId.left(calendarId.indexOf(QLatin1Char('/')));
+    if (feed.kind == eventsKind) {
+        if (feed.nextPageToken.has_value()) {
             feedData.nextPageUrl = feedData.requestUrl;
             // replace the old pageToken with a new one
             QUrlQuery query(feedData.nextPageUrl);
             query.removeQueryItem(pageTokenParam);
-            query.addQueryItem(pageTokenParam, data.value(nextPageTokenParam).toString());
+            query.addQueryItem(pageTokenParam, *feed.nextPageToken);
             feedData.nextPageUrl.setQuery(query);
         }
-        if (data.contains(timeZoneParam)) {
+        if (feed.timeZone.has_value()) {
             // This should always be in Olson format
-            timezone = data.value(timeZoneParam).toString();
+            timezone = *feed.timeZone;
         }
-        if (data.contains(nextSyncTokenParam)) {
-            feedData.syncToken = data[nextSyncTokenParam].toString();
+        if (feed.nextSyncToken.has_value()) {
+            feedData.syncToken = *feed.nextSyncToken;
         }
     } else {
         return {};
     }
 
     ObjectsList list;
-    const auto items = data.value(itemsParam).toList();
-    list.reserve(items.size());
-    for (const auto &i : items) {
-        list.push_back(Private::JSONToEvent(i.toMap(), timezone));
+    if (feed.items.isEmpty()) {
+        return list;
+    }
+
+    JsonReader itemsReader(feed.items);
+    if (itemsReader.beginArray()) {
+        while (itemsReader.hasNext()) {
+            EventData data;
+            readEvent(itemsReader, data);
+            list.push_back(eventFromData(data, timezone));
+        }
+        itemsReader.endArray();
     }
 
     return list;
@@ -195,6 +195,13 @@ namespace CalendarService
      */
     KGAPICALENDAR_EXPORT QUrl freeBusyQueryUrl();
 
+    /**
+     * @brief Returns URL of the Calendar API batch endpoint.
+     *
+     * @since 6.1
+     */
+    KGAPICALENDAR_EXPORT QUrl batchUrl();
+
 } // namespace CalendarService
 
 } // namespace KGAPI
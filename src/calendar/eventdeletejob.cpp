@@ -65,10 +65,13 @@ void EventDeleteJob::start()
         return;
     }
 
-    const QString eventId = d->eventsIds.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::removeEventUrl(d->calendarId, eventId));
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->eventsIds.hasUnqueued()) {
+        const QString eventId = d->eventsIds.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::removeEventUrl(d->calendarId, eventId));
 
-    enqueueRequest(request);
+        enqueueRequest(request);
+    }
 }
 
 void EventDeleteJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
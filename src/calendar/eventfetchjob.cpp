@@ -164,6 +164,7 @@ void EventFetchJob::start()
             query.addQueryItem(QStringLiteral("eventTypes"), CalendarService::eventTypeToString(eventType));
         }
         url.setQuery(query);
+        enablePipelinedPagination();
     } else {
         url = CalendarService::fetchEventUrl(d->calendarId, d->eventId);
     }
@@ -192,7 +193,12 @@ ObjectsList EventFetchJob::handleReplyWithItems(const QNetworkReply *reply, cons
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
     ContentType ct = Utils::stringToContentType(contentType);
     if (ct == KGAPI2::JSON) {
-        if (d->eventId.isEmpty()) {
+        if (d->eventId.isEmpty() && parseInThreadPool()) {
+            parseItemsInThreadPool(reply, rawData, &CalendarService::parseEventJSONFeed, [this](const FeedData &feedData) {
+                d->syncToken = feedData.syncToken;
+            });
+            return items;
+        } else if (d->eventId.isEmpty()) {
             items = CalendarService::parseEventJSONFeed(rawData, feedData);
         } else {
             items << CalendarService::JSONToEvent(rawData).dynamicCast<Object>();
@@ -205,10 +211,5 @@ ObjectsList EventFetchJob::handleReplyWithItems(const QNetworkReply *reply, cons
         return items;
     }
 
-    if (feedData.nextPageUrl.isValid()) {
-        const auto request = CalendarService::prepareRequest(feedData.nextPageUrl);
-        enqueueRequest(request);
-    }
-
     return items;
 }
@@ -63,11 +63,14 @@ void EventModifyJob::start()
         return;
     }
 
-    const EventPtr event = d->events.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::updateEventUrl(d->calendarId, event->id(), d->updatesPolicy));
-    const QByteArray rawData = CalendarService::eventToJSON(event);
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->events.hasUnqueued()) {
+        const EventPtr event = d->events.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::updateEventUrl(d->calendarId, event->id(), d->updatesPolicy));
+        const QByteArray rawData = CalendarService::eventToJSON(event);
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList EventModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
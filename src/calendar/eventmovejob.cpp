@@ -88,10 +88,13 @@ void EventMoveJob::start()
         return;
     }
 
-    const QString eventId = d->eventsIds.current();
-    const auto request = CalendarService::prepareRequest(CalendarService::moveEventUrl(d->source, d->destination, eventId));
+    setBatchUrl(CalendarService::batchUrl());
+    while (d->eventsIds.hasUnqueued()) {
+        const QString eventId = d->eventsIds.takeUnqueued();
+        const auto request = CalendarService::prepareRequest(CalendarService::moveEventUrl(d->source, d->destination, eventId));
 
-    enqueueRequest(request);
+        enqueueRequest(request);
+    }
 }
 
 void EventMoveJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
@@ -0,0 +1,171 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "freebusyindex.h"
+
+#include <QHash>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+
+namespace
+{
+
+// Half-open interval in msecs since epoch
+struct Interval {
+    qint64 start;
+    qint64 end;
+};
+using Intervals = QList<Interval>;
+
+// Sorts the intervals and merges those that overlap or touch
+void normalize(Intervals &intervals)
+{
+    std::sort(intervals.begin(), intervals.end(), [](const Interval &lhs, const Interval &rhs) {
+        return lhs.start < rhs.start;
+    });
+
+    Intervals merged;
+    merged.reserve(intervals.size());
+    for (const auto &interval : std::as_const(intervals)) {
+        if (interval.end <= interval.start) {
+            continue;
+        }
+        if (!merged.isEmpty() && interval.start <= merged.last().end) {
+            merged.last().end = std::max(merged.last().end, interval.end);
+        } else {
+            merged << interval;
+        }
+    }
+
+    intervals = merged;
+}
+
+// Returns the first interval that ends after @p time
+Intervals::const_iterator firstEndingAfter(const Intervals &intervals, qint64 time)
+{
+    return std::upper_bound(intervals.cbegin(), intervals.cend(), time, [](qint64 time, const Interval &interval) {
+        return time < interval.end;
+    });
+}
+
+FreeBusyQueryJob::BusyRangeList toBusyRanges(const Intervals &intervals)
+{
+    FreeBusyQueryJob::BusyRangeList ranges;
+    ranges.reserve(intervals.size());
+    for (const auto &interval : intervals) {
+        ranges << FreeBusyQueryJob::BusyRange{QDateTime::fromMSecsSinceEpoch(interval.start), QDateTime::fromMSecsSinceEpoch(interval.end)};
+    }
+    return ranges;
+}
+
+}
+
+class Q_DECL_HIDDEN FreeBusyIndex::Private : public QSharedData
+{
+public:
+    Private() = default;
+    Private(const Private &other) = default;
+
+    QStringList calendarIds;
+    QHash<QString, Intervals> calendars;
+    // Union of the intervals of all calendars
+    Intervals merged;
+};
+
+FreeBusyIndex::FreeBusyIndex()
+    : d(new Private)
+{
+}
+
+FreeBusyIndex::FreeBusyIndex(const FreeBusyIndex &other) = default;
+
+FreeBusyIndex::~FreeBusyIndex() = default;
+
+FreeBusyIndex &FreeBusyIndex::operator=(const FreeBusyIndex &other) = default;
+
+void FreeBusyIndex::insert(const QString &calendarId, const FreeBusyQueryJob::BusyRangeList &ranges)
+{
+    if (!d->calendars.contains(calendarId)) {
+        d->calendarIds << calendarId;
+    }
+
+    Intervals &intervals = d->calendars[calendarId];
+    for (const auto &range : ranges) {
+        const Interval interval{range.busyStart.toMSecsSinceEpoch(), range.busyEnd.toMSecsSinceEpoch()};
+        intervals << interval;
+        d->merged << interval;
+    }
+
+    normalize(intervals);
+    normalize(d->merged);
+}
+
+bool FreeBusyIndex::isEmpty() const
+{
+    return d->calendarIds.isEmpty();
+}
+
+QStringList FreeBusyIndex::calendars() const
+{
+    return d->calendarIds;
+}
+
+FreeBusyQueryJob::BusyRangeList FreeBusyIndex::busy(const QString &calendarId) const
+{
+    return toBusyRanges(d->calendars.value(calendarId));
+}
+
+FreeBusyQueryJob::BusyRangeList FreeBusyIndex::mergedBusy() const
+{
+    return toBusyRanges(d->merged);
+}
+
+QStringList FreeBusyIndex::busyCalendarsAt(const QDateTime &time) const
+{
+    QStringList busyCalendars;
+
+    const qint64 msecs = time.toMSecsSinceEpoch();
+    // Nobody is busy when all calendars are free
+    const auto merged = firstEndingAfter(d->merged, msecs);
+    if (merged == d->merged.cend() || merged->start > msecs) {
+        return busyCalendars;
+    }
+
+    for (const auto &calendarId : std::as_const(d->calendarIds)) {
+        const Intervals intervals = d->calendars.value(calendarId);
+        const auto interval = firstEndingAfter(intervals, msecs);
+        if (interval != intervals.cend() && interval->start <= msecs) {
+            busyCalendars << calendarId;
+        }
+    }
+
+    return busyCalendars;
+}
+
+QDateTime FreeBusyIndex::firstFreeSlot(const QDateTime &from, const QDateTime &until, qint64 duration) const
+{
+    const qint64 length = duration * 1000;
+    const qint64 end = until.toMSecsSinceEpoch();
+    qint64 candidate = from.toMSecsSinceEpoch();
+
+    // The merged intervals are disjoint, so each gap between them is free for everyone
+    for (auto interval = firstEndingAfter(d->merged, candidate); interval != d->merged.cend() && interval->start < end; ++interval) {
+        if (interval->start - candidate >= length) {
+            return QDateTime::fromMSecsSinceEpoch(candidate);
+        }
+        candidate = std::max(candidate, interval->end);
+    }
+
+    if (end - candidate >= length) {
+        return QDateTime::fromMSecsSinceEpoch(candidate);
+    }
+
+    return QDateTime();
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "freebusyqueryjob.h"
+#include "kgapicalendar_export.h"
+
+#include <QDateTime>
+#include <QSharedDataPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile freebusyindex.h
+ * @brief Busy time of multiple calendars indexed for availability queries
+ *
+ * The busy ranges of each calendar are kept sorted, with overlapping ranges
+ * merged, together with the union of busy ranges of all the calendars. This
+ * allows answering which calendars are busy at a given time, or when are all
+ * the calendars free, without scanning all the ranges.
+ *
+ * Busy ranges are treated as half-open intervals, an event that ends at 10:00
+ * does not collide with an event that starts at 10:00.
+ *
+ * @since 6.1
+ */
+class KGAPICALENDAR_EXPORT FreeBusyIndex
+{
+public:
+    FreeBusyIndex();
+    FreeBusyIndex(const FreeBusyIndex &other);
+    ~FreeBusyIndex();
+
+    FreeBusyIndex &operator=(const FreeBusyIndex &other);
+
+    /**
+     * @brief Adds busy @p ranges of calendar @p calendarId to the index
+     *
+     * The ranges don't have to be sorted. Adding ranges of a calendar that
+     * is already in the index extends the busy time of the calendar.
+     */
+    void insert(const QString &calendarId, const FreeBusyQueryJob::BusyRangeList &ranges);
+
+    /**
+     * @brief Returns whether there are no calendars in the index
+     */
+    [[nodiscard]] bool isEmpty() const;
+
+    /**
+     * @brief Returns IDs of all calendars in the index
+     */
+    [[nodiscard]] QStringList calendars() const;
+
+    /**
+     * @brief Returns sorted and merged busy ranges of calendar @p calendarId
+     */
+    [[nodiscard]] FreeBusyQueryJob::BusyRangeList busy(const QString &calendarId) const;
+
+    /**
+     * @brief Returns sorted ranges when at least one of the calendars is busy
+     */
+    [[nodiscard]] FreeBusyQueryJob::BusyRangeList mergedBusy() const;
+
+    /**
+     * @brief Returns IDs of calendars that are busy at @p time
+     */
+    [[nodiscard]] QStringList busyCalendarsAt(const QDateTime &time) const;
+
+    /**
+     * @brief Returns start of the first slot when all calendars are free
+     *
+     * Looks for the first slot of at least @p duration seconds between
+     * @p from and @p until during which none of the calendars is busy.
+     *
+     * @return Start of the slot, or an invalid QDateTime when there is no
+     *         such slot.
+     */
+    [[nodiscard]] QDateTime firstFreeSlot(const QDateTime &from, const QDateTime &until, qint64 duration) const;
+
+private:
+    class Private;
+    QSharedDataPointer<Private> d;
+};
+
+} // namespace KGAPI2
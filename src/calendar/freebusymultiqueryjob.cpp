@@ -0,0 +1,219 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "freebusymultiqueryjob.h"
+#include "calendarservice.h"
+#include "debug.h"
+#include "private/jsonreader_p.h"
+#include "utils.h"
+
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QVariantMap>
+
+using namespace KGAPI2;
+
+namespace
+{
+
+// Maximum amount of calendars the API returns free/busy information for in a single query
+static const int MaxCalendarsPerQuery = 50;
+
+struct CalendarData {
+    FreeBusyQueryJob::BusyRangeList busy;
+    bool hasErrors = false;
+};
+
+void readBusyRange(JsonReader &reader, FreeBusyQueryJob::BusyRange &range)
+{
+    static const JsonFieldTable<FreeBusyQueryJob::BusyRange> fields{
+        {"end",
+         [](JsonReader &reader, FreeBusyQueryJob::BusyRange &range) {
+             range.busyEnd = Utils::rfc3339DateFromString(reader.readString());
+         }},
+        {"start",
+         [](JsonReader &reader, FreeBusyQueryJob::BusyRange &range) {
+             range.busyStart = Utils::rfc3339DateFromString(reader.readString());
+         }},
+    };
+
+    fields.read(reader, range);
+}
+
+void readCalendar(JsonReader &reader, CalendarData &calendar)
+{
+    static const JsonFieldTable<CalendarData> fields{
+        {"busy",
+         [](JsonReader &reader, CalendarData &calendar) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     FreeBusyQueryJob::BusyRange range;
+                     readBusyRange(reader, range);
+                     calendar.busy << range;
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"errors",
+         [](JsonReader &reader, CalendarData &calendar) {
+             reader.skipValue();
+             calendar.hasErrors = true;
+         }},
+    };
+
+    fields.read(reader, calendar);
+}
+
+}
+
+class Q_DECL_HIDDEN FreeBusyMultiQueryJob::Private
+{
+public:
+    Private(const QStringList &ids, const QDateTime &timeMin, const QDateTime &timeMax)
+        : ids(ids)
+        , timeMin(timeMin)
+        , timeMax(timeMax)
+    {
+    }
+
+    QByteArray buildQuery(const QStringList &calendarIds) const;
+
+    const QStringList ids;
+    const QDateTime timeMin;
+    const QDateTime timeMax;
+    FreeBusyIndex busy;
+    QStringList failedIds;
+};
+
+QByteArray FreeBusyMultiQueryJob::Private::buildQuery(const QStringList &calendarIds) const
+{
+    QVariantList items;
+    items.reserve(calendarIds.size());
+    for (const auto &id : calendarIds) {
+        items << QVariantMap({{QStringLiteral("id"), id}});
+    }
+
+    QVariantMap requestData({{QStringLiteral("timeMin"), Utils::rfc3339DateToString(timeMin)},
+                             {QStringLiteral("timeMax"), Utils::rfc3339DateToString(timeMax)},
+                             {QStringLiteral("items"), items}});
+    QJsonDocument document = QJsonDocument::fromVariant(requestData);
+    return document.toJson(QJsonDocument::Compact);
+}
+
+FreeBusyMultiQueryJob::FreeBusyMultiQueryJob(const QStringList &ids,
+                                             const QDateTime &timeMin,
+                                             const QDateTime &timeMax,
+                                             const AccountPtr &account,
+                                             QObject *parent)
+    : FetchJob(account, parent)
+    , d(new FreeBusyMultiQueryJob::Private(ids, timeMin, timeMax))
+{
+}
+
+FreeBusyMultiQueryJob::~FreeBusyMultiQueryJob() = default;
+
+QStringList FreeBusyMultiQueryJob::ids() const
+{
+    return d->ids;
+}
+
+QDateTime FreeBusyMultiQueryJob::timeMin() const
+{
+    return d->timeMin;
+}
+
+QDateTime FreeBusyMultiQueryJob::timeMax() const
+{
+    return d->timeMax;
+}
+
+FreeBusyIndex FreeBusyMultiQueryJob::busy() const
+{
+    return d->busy;
+}
+
+QStringList FreeBusyMultiQueryJob::failedIds() const
+{
+    return d->failedIds;
+}
+
+void FreeBusyMultiQueryJob::start()
+{
+    d->busy = FreeBusyIndex();
+    d->failedIds.clear();
+
+    QStringList ids = d->ids;
+    ids.removeDuplicates();
+    if (ids.isEmpty()) {
+        emitFinished();
+        return;
+    }
+
+    // The queries are sent concurrently, each for as many calendars as possible
+    const auto request = CalendarService::prepareRequest(CalendarService::freeBusyQueryUrl());
+    for (qsizetype i = 0; i < ids.size(); i += MaxCalendarsPerQuery) {
+        enqueueRequest(request, d->buildQuery(ids.mid(i, MaxCalendarsPerQuery)), QStringLiteral("application/json"));
+    }
+}
+
+void FreeBusyMultiQueryJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
+{
+    QNetworkRequest r = request;
+    if (!r.hasRawHeader("Content-Type")) {
+        r.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
+    }
+
+    accessManager->post(r, data);
+}
+
+void FreeBusyMultiQueryJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    ContentType ct = Utils::stringToContentType(contentType);
+    if (ct != KGAPI2::JSON) {
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response content type"));
+        emitFinished();
+        return;
+    }
+
+    JsonReader reader(rawData);
+    if (reader.beginObject()) {
+        while (reader.hasNext()) {
+            if (reader.nextName() != "calendars") {
+                reader.skipValue();
+                continue;
+            }
+
+            if (!reader.beginObject()) {
+                continue;
+            }
+            while (reader.hasNext()) {
+                const QString calendarId = QString::fromUtf8(reader.nextName());
+                CalendarData calendar;
+                readCalendar(reader, calendar);
+                if (calendar.hasErrors) {
+                    d->failedIds << calendarId;
+                } else {
+                    d->busy.insert(calendarId, calendar.busy);
+                }
+            }
+            reader.endObject();
+        }
+        reader.endObject();
+    }
+
+    if (reader.hasError()) {
+        qCWarning(KGAPIDebug) << "Error parsing FreeBusy reply:" << reader.errorString();
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response"));
+        emitFinished();
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "fetchjob.h"
+#include "freebusyindex.h"
+#include "kgapicalendar_export.h"
+
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile freebusymultiqueryjob.h
+ * @brief A job to query free/busy information of multiple calendars
+ *
+ * Unlike FreeBusyQueryJob, which queries a single calendar, this job asks for
+ * as many calendars per request as the API allows and sends the requests
+ * concurrently. The busy time of all calendars is returned in a single
+ * FreeBusyIndex.
+ *
+ * Calendars whose free/busy information is not available, for example
+ * because the user has no access to them, are not part of the index and are
+ * reported by failedIds() instead of failing the whole job.
+ *
+ * @since 6.1
+ */
+class KGAPICALENDAR_EXPORT FreeBusyMultiQueryJob : public KGAPI2::FetchJob
+{
+    Q_OBJECT
+public:
+    explicit FreeBusyMultiQueryJob(const QStringList &ids, const QDateTime &timeMin, const QDateTime &timeMax, const AccountPtr &account, QObject *parent = nullptr);
+    ~FreeBusyMultiQueryJob() override;
+
+    [[nodiscard]] QStringList ids() const;
+    [[nodiscard]] QDateTime timeMin() const;
+    [[nodiscard]] QDateTime timeMax() const;
+
+    /**
+     * @brief Returns busy time of all calendars that were queried successfully
+     */
+    [[nodiscard]] FreeBusyIndex busy() const;
+
+    /**
+     * @brief Returns IDs of calendars whose free/busy information is not available
+     */
+    [[nodiscard]] QStringList failedIds() const;
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+}
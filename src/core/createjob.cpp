@@ -49,7 +49,7 @@ void CreateJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNet
         r.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
     }
 
-    accessManager->post(r, data);
+    accessManager->post(r, compressRequestBody(r, data));
 }
 
 void CreateJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
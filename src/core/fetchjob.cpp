@@ -7,29 +7,133 @@
  */
 
 #include "fetchjob.h"
+#include "account.h"
 #include "debug.h"
 #include "object.h"
+#include "private/jsonreader_p.h"
+#include "responsecache.h"
 
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QPromise>
+#include <QQueue>
+#include <QThreadPool>
+#include <QUrlQuery>
+
+#include <memory>
 
 using namespace KGAPI2;
 
+namespace
+{
+// Cached body of a request sent with If-None-Match, in case the server replies 304.
+// Carried by the request itself, so that it can't be mixed up between requests to
+// the same URL. Attributes User + 1 to User + 3 are used by Job.
+static const auto CachedDataAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 4);
+}
+
 class Q_DECL_HIDDEN FetchJob::Private
 {
 public:
+    // A reply that is being parsed in the thread pool
+    struct PendingParse {
+        QFutureWatcher<ObjectsList> *watcher = nullptr;
+        std::shared_ptr<FeedData> feedData;
+        std::function<void(const FeedData &)> parsed;
+    };
+
+    explicit Private(FetchJob *parent)
+        : q(parent)
+    {
+    }
+
+    static QString peekMember(const QByteArray &rawData, QByteArrayView name);
+    void enqueueParse(const QFuture<ObjectsList> &future, const std::shared_ptr<FeedData> &feedData, const std::function<void(const FeedData &)> &parsed);
+    void deliverItems(const ObjectsList &items);
+    void clearPendingParses();
+
     ObjectsList items;
+    bool retainItems = true;
+
+    bool parseInThreadPool = false;
+    // Parsed items are delivered in the order in which the replies were received
+    QQueue<PendingParse> pendingParses;
+
+    bool pipelinedPagination = false;
+    QByteArray nextPageMember;
+    QString pageTokenParam;
+
+private:
+    FetchJob *const q;
 };
 
+QString FetchJob::Private::peekMember(const QByteArray &rawData, QByteArrayView name)
+{
+    // Only scans the top-level members, values of all the other members
+    // (including the items) are skipped without being parsed
+    JsonReader reader(rawData);
+    if (!reader.beginObject()) {
+        return QString();
+    }
+
+    while (reader.hasNext()) {
+        if (reader.nextName() == name) {
+            return reader.readString();
+        }
+        reader.skipValue();
+    }
+
+    return QString();
+}
+
+void FetchJob::Private::enqueueParse(const QFuture<ObjectsList> &future,
+                                     const std::shared_ptr<FeedData> &feedData,
+                                     const std::function<void(const FeedData &)> &parsed)
+{
+    PendingParse pending;
+    pending.watcher = new QFutureWatcher<ObjectsList>(q);
+    pending.feedData = feedData;
+    pending.parsed = parsed;
+    QObject::connect(pending.watcher, &QFutureWatcherBase::finished, q, [this]() {
+        q->takeParsedItems();
+    });
+    pending.watcher->setFuture(future);
+    pendingParses.enqueue(pending);
+}
+
+void FetchJob::Private::deliverItems(const ObjectsList &items)
+{
+    if (items.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT q->itemsAvailable(q, items);
+    if (retainItems) {
+        this->items << items;
+    }
+}
+
+void FetchJob::Private::clearPendingParses()
+{
+    // The parsing itself can't be interrupted, its results are just discarded
+    for (const auto &pending : std::as_const(pendingParses)) {
+        delete pending.watcher;
+    }
+    pendingParses.clear();
+}
+
 FetchJob::FetchJob(QObject *parent)
     : Job(parent)
-    , d(new Private)
+    , d(new Private(this))
 {
 }
 
 FetchJob::FetchJob(const AccountPtr &account, QObject *parent)
     : Job(account, parent)
-    , d(new Private)
+    , d(new Private(this))
 {
 }
 
@@ -48,22 +152,139 @@ ObjectsList FetchJob::items() const
     return d->items;
 }
 
+void FetchJob::setRetainItems(bool retainItems)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setRetainItems() on running job. Ignoring.";
+        return;
+    }
+
+    d->retainItems = retainItems;
+}
+
+bool FetchJob::retainItems() const
+{
+    return d->retainItems;
+}
+
+void FetchJob::setParseInThreadPool(bool parseInThreadPool)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setParseInThreadPool() on running job. Ignoring.";
+        return;
+    }
+
+    d->parseInThreadPool = parseInThreadPool;
+}
+
+bool FetchJob::parseInThreadPool() const
+{
+    return d->parseInThreadPool;
+}
+
 void FetchJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
 {
     Q_UNUSED(data)
     Q_UNUSED(contentType)
 
-    accessManager->get(request);
+    // Range requests fetch only a part of the resource, their replies are not cached
+    if (request.hasRawHeader("Range") || request.hasRawHeader("If-None-Match")
+        || request.attribute(QNetworkRequest::CacheLoadControlAttribute) == QNetworkRequest::AlwaysNetwork) {
+        accessManager->get(request);
+        return;
+    }
+
+    const auto entry = ResponseCache::instance()->find(account() ? account()->accountName() : QString(), request.url());
+    if (!entry.isValid()) {
+        accessManager->get(request);
+        return;
+    }
+
+    QNetworkRequest conditionalRequest = request;
+    conditionalRequest.setRawHeader("If-None-Match", entry.etag);
+    conditionalRequest.setAttribute(CachedDataAttribute, entry.data);
+    accessManager->get(conditionalRequest);
 }
 
-void FetchJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+void FetchJob::handleReply(const QNetworkReply *reply, const QByteArray &replyData)
 {
-    d->items << handleReplyWithItems(reply, rawData);
+    QByteArray rawData = replyData;
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (replyCode == KGAPI2::NotModified) {
+        const QVariant cachedData = reply->request().attribute(CachedDataAttribute);
+        if (!cachedData.isValid()) {
+            // Requests in a batch lose the cached body, fetch the resource again without revalidating it
+            if (currentRequest().attribute(QNetworkRequest::CacheLoadControlAttribute) == QNetworkRequest::AlwaysNetwork) {
+                qCWarning(KGAPIDebug) << "Unexpected reply 304 from" << reply->url();
+                setError(KGAPI2::UnknownError);
+                setErrorString(tr("Server replied that the resource has not changed, but it's not cached."));
+                emitFinished();
+                return;
+            }
+            qCDebug(KGAPIDebug) << "Reply from" << reply->url() << "has not changed, but it's not cached, fetching it again";
+            QNetworkRequest request = currentRequest();
+            request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+            // Keep the position of the request, so the items are still delivered in order
+            sendCurrentRequestAgain(request);
+            return;
+        }
+        qCDebug(KGAPIDebug) << "Reply from" << reply->url() << "has not changed, using cached data";
+        rawData = cachedData.toByteArray();
+    } else if (replyCode == KGAPI2::OK && reply->hasRawHeader("ETag")) {
+        ResponseCache::instance()->insert(account() ? account()->accountName() : QString(), reply->request().url(), reply->rawHeader("ETag"), rawData);
+    }
+
+    if (d->pipelinedPagination) {
+        const QString nextPage = Private::peekMember(rawData, d->nextPageMember);
+        if (!nextPage.isEmpty()) {
+            // The request as enqueued, the reply carries the authorized request with the
+            // Authorization and If-None-Match headers that only apply to this page
+            QNetworkRequest request = currentRequest();
+            QUrl url;
+            if (d->pageTokenParam.isEmpty()) {
+                url = QUrl(nextPage);
+            } else {
+                url = request.url();
+                QUrlQuery query(url);
+                query.removeAllQueryItems(d->pageTokenParam);
+                query.addQueryItem(d->pageTokenParam, nextPage);
+                url.setQuery(query);
+            }
+            request.setUrl(url);
+
+            enqueueRequest(request);
+            dispatchQueuedRequests();
+        }
+    }
+
+    const int pendingParses = d->pendingParses.size();
+    QElapsedTimer parseTimer;
+    parseTimer.start();
+    const ObjectsList items = handleReplyWithItems(reply, rawData);
+    // Reported to RequestMetrics by Job, unknown when the reply is parsed in the thread pool
+    setParseTime(d->pendingParses.size() > pendingParses ? -1 : parseTimer.nsecsElapsed() / 1000);
+    if (d->pendingParses.size() > pendingParses) {
+        return;
+    }
+    if (!d->pendingParses.isEmpty()) {
+        // Items of this reply must not overtake items of replies that are still being parsed
+        QPromise<ObjectsList> promise;
+        promise.start();
+        promise.addResult(items);
+        promise.finish();
+        d->enqueueParse(promise.future(), std::make_shared<FeedData>(), {});
+        beginDeferredParse();
+        return;
+    }
+
+    d->deliverItems(items);
 }
 
 void FetchJob::aboutToStart()
 {
     d->items.clear();
+    d->clearPendingParses();
+    d->pipelinedPagination = false;
 
     Job::aboutToStart();
 }
@@ -76,4 +297,51 @@ ObjectsList FetchJob::handleReplyWithItems(const QNetworkReply *reply, const QBy
     return ObjectsList();
 }
 
+void FetchJob::enablePipelinedPagination(const QString &nextPageMember, const QString &pageTokenParam)
+{
+    d->pipelinedPagination = true;
+    d->nextPageMember = nextPageMember.toUtf8();
+    d->pageTokenParam = pageTokenParam;
+}
+
+void FetchJob::parseItemsInThreadPool(const QNetworkReply *reply,
+                                      const QByteArray &rawData,
+                                      const std::function<ObjectsList(const QByteArray &rawData, FeedData &feedData)> &parser,
+                                      const std::function<void(const FeedData &feedData)> &parsed)
+{
+    auto feedData = std::make_shared<FeedData>();
+    feedData->requestUrl = reply->url();
+
+    // Shared with the worker, which may still be running when the job is destroyed
+    auto promise = std::make_shared<QPromise<ObjectsList>>();
+    promise->start();
+
+    d->enqueueParse(promise->future(), feedData, parsed);
+    beginDeferredParse();
+
+    QThreadPool::globalInstance()->start([promise, feedData, parser, rawData]() {
+        promise->addResult(parser(rawData, *feedData));
+        promise->finish();
+    });
+}
+
+void FetchJob::takeParsedItems()
+{
+    while (!d->pendingParses.isEmpty() && d->pendingParses.head().watcher->isFinished()) {
+        const Private::PendingParse parse = d->pendingParses.dequeue();
+        parse.watcher->deleteLater();
+        // Unless the job has failed in the meantime
+        if (isRunning()) {
+            if (parse.parsed) {
+                parse.parsed(*parse.feedData);
+            }
+            if (isRunning()) {
+                d->deliverItems(parse.watcher->result());
+            }
+        }
+
+        endDeferredParse();
+    }
+}
+
 #include "moc_fetchjob.cpp"
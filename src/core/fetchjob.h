@@ -11,6 +11,8 @@
 #include "job.h"
 #include "kgapicore_export.h"
 
+#include <functional>
+
 namespace KGAPI2
 {
 
@@ -18,6 +20,11 @@ namespace KGAPI2
  * @headerfile fetchjob.h
  * @brief Abstract superclass for all jobs that fetch resources from Google
  *
+ * When the ResponseCache is enabled, replies that carry an ETag are stored
+ * in it. When the same resource is fetched again, the cached reply is
+ * revalidated with the server and passed to the job again when it has not
+ * changed, without transferring it again.
+ *
  * @author Daniel Vrátil <dvratil@redhat.com>
  * @since 2.0
  */
@@ -53,10 +60,80 @@ public:
      * from handler of Job::finished signal. Calling this method on a running
      * job will print a warning and return an empty list.
      *
+     * When the job does not retain the fetched items, this method always
+     * returns an empty list.
+     *
      * @return All items fetched by this job.
+     * @see setRetainItems
      */
     virtual ObjectsList items() const;
 
+    /**
+     * @brief Sets whether the job should keep all fetched items
+     *
+     * By default all fetched items are stored in the job until it is destroyed,
+     * so that they can be retrieved by FetchJob::items once the job has finished.
+     * Consumers that process the items as they arrive through the
+     * itemsAvailable() signal can disable this, so that each page of items is
+     * released as soon as it has been processed and the memory used by the job
+     * does not grow with the size of the result.
+     *
+     * @param retainItems Whether to keep the fetched items, true by default
+     *
+     * @since 6.1
+     */
+    void setRetainItems(bool retainItems);
+
+    /**
+     * @brief Returns whether the job keeps all fetched items
+     *
+     * @see setRetainItems
+     * @since 6.1
+     */
+    [[nodiscard]] bool retainItems() const;
+
+    /**
+     * @brief Sets whether the job should parse replies in a worker thread
+     *
+     * Parsing large feeds and constructing the items from them can take
+     * hundreds of milliseconds, blocking the thread the job lives in. When
+     * enabled, jobs that support it parse the replies in
+     * QThreadPool::globalInstance() instead, while the requests are still
+     * dispatched and their replies received in the thread of the job. The
+     * items are delivered through itemsAvailable() in the order of the
+     * replies, and the job finishes only after all replies have been parsed.
+     *
+     * Event, task and file fetch jobs support parsing in the thread pool,
+     * other jobs always parse the replies in their own thread.
+     *
+     * @param parseInThreadPool Whether to parse replies in a worker thread, false by default
+     *
+     * @since 6.1
+     */
+    void setParseInThreadPool(bool parseInThreadPool);
+
+    /**
+     * @brief Returns whether the job parses replies in a worker thread
+     *
+     * @see setParseInThreadPool
+     * @since 6.1
+     */
+    [[nodiscard]] bool parseInThreadPool() const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when a new batch of items has been fetched
+     *
+     * The signal is emitted for every reply the items have been parsed from,
+     * usually once per page of a feed, and always before Job::finished.
+     *
+     * @param job The job that has fetched the items
+     * @param items Items parsed from the last reply
+     *
+     * @since 6.1
+     */
+    void itemsAvailable(KGAPI2::Job *job, const KGAPI2::ObjectsList &items);
+
 protected:
     /**
      * @brief KGAPI::Job::dispatchRequest implementation
@@ -102,7 +179,61 @@ protected:
      */
     virtual ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData);
 
+    /**
+     * @brief Enables pipelined pagination of the fetched feed
+     *
+     * When enabled, FetchJob looks up the next page of the feed in every reply
+     * before passing the reply to FetchJob::handleReplyWithItems and dispatches
+     * the request for the next page right away, so that the next page is being
+     * transferred while the current one is being parsed. Subclasses that enable
+     * pipelined pagination must not enqueue the next page themselves.
+     *
+     * The request for the next page is a copy of the request for the current
+     * page with the @p pageTokenParam query item set to the value of the
+     * top-level @p nextPageMember member of the reply. When @p pageTokenParam
+     * is empty, @p nextPageMember is expected to hold the whole URL of the
+     * next page instead, like the "nextLink" member in Drive API.
+     *
+     * Pipelined pagination is disabled whenever the job is started, subclasses
+     * usually enable it from their start() implementation.
+     *
+     * @param nextPageMember Name of the reply member with the next page token
+     * @param pageTokenParam Name of the query parameter to send the token in
+     *
+     * @since 6.1
+     */
+    void enablePipelinedPagination(const QString &nextPageMember = QStringLiteral("nextPageToken"),
+                                   const QString &pageTokenParam = QStringLiteral("pageToken"));
+
+    /**
+     * @brief Parses items from a feed in a worker thread
+     *
+     * Parses @p rawData received in @p reply with @p parser in
+     * QThreadPool::globalInstance() and delivers the items as if they were
+     * returned by FetchJob::handleReplyWithItems. Subclasses call this from
+     * their handleReplyWithItems implementation when parseInThreadPool() is
+     * enabled, and return an empty list.
+     *
+     * The @p parser runs in another thread, so it must not access the job.
+     * The FeedData it has filled are passed to @p parsed, which is called in
+     * the thread of the job right before the items are delivered. Neither is
+     * called when the job has finished or has been destroyed in the meantime.
+     *
+     * @param reply Reply the @p rawData have been received in
+     * @param rawData Content of the @p reply
+     * @param parser Function that parses the items from the feed
+     * @param parsed Function called with the FeedData filled by @p parser
+     *
+     * @since 6.1
+     */
+    void parseItemsInThreadPool(const QNetworkReply *reply,
+                                const QByteArray &rawData,
+                                const std::function<ObjectsList(const QByteArray &rawData, FeedData &feedData)> &parser,
+                                const std::function<void(const FeedData &feedData)> &parsed = {});
+
 private:
+    void takeParsedItems();
+
     class Private;
     Private *const d;
     friend class Private;
@@ -8,78 +8,233 @@
 
 #include "job.h"
 #include "account.h"
+#include "tokenmanager.h"
 #include "authjob.h"
 #include "debug.h"
 #include "job_p.h"
 #include "networkaccessmanagerfactory_p.h"
+#include "private/batchrequest_p.h"
+#include "private/filelogger_p.h"
+#include "private/gzip_p.h"
+#include "ratelimiter.h"
+#include "requestmetrics.h"
+#include "transferstatistics.h"
 #include "utils.h"
 
+#include <QChildEvent>
 #include <QCoreApplication>
-#include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
-#include <QTextStream>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QRandomGenerator>
 #include <QUrlQuery>
 
 using namespace KGAPI2;
 
-FileLogger *FileLogger::sInstance = nullptr;
+namespace
+{
+// Identifies a dispatched request so that its reply can be matched to it
+static const auto RequestIdAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+// Identifies a dispatched batch request
+static const auto BatchIdAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 2);
+// ID of the request in the session log
+static const auto LogIdAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 3);
+
+// Maximum amount of requests Google accepts in a single batch request
+static const int MaxBatchSize = 100;
+
+// Matches the number of parallel connections Qt opens to a single HTTP/1.1 host
+static const int DefaultMaxConcurrentRequests = 6;
+
+static const int DefaultMaxRetries = 3;
+static const int DefaultRetryDelay = 1000;
+static const qint64 MaxRetryDelay = 32 * 1000;
 
-FileLogger::FileLogger()
+// Google compresses replies only for clients that mention gzip in their User-Agent
+static const QByteArray UserAgent = QByteArrayLiteral("libkgapi (gzip)");
+
+void requestCompressedReply(QNetworkRequest &request)
 {
-    if (!qEnvironmentVariableIsSet("KGAPI_SESSION_LOGFILE")) {
-        return;
+    const QByteArray userAgent = request.rawHeader("User-Agent");
+    if (userAgent.isEmpty()) {
+        request.setRawHeader("User-Agent", UserAgent);
+    } else if (!userAgent.contains("gzip")) {
+        request.setRawHeader("User-Agent", userAgent + " (gzip)");
     }
 
-    QString filename = QString::fromLocal8Bit(qgetenv("KGAPI_SESSION_LOGFILE")) + QLatin1Char('.') + QString::number(QCoreApplication::applicationPid());
-    mFile.reset(new QFile(filename));
-    if (!mFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        qCWarning(KGAPIDebug) << "Failed to open logging file" << filename << ":" << mFile->errorString();
-        mFile.reset();
+    // Setting the header explicitly disables decompression in QNetworkAccessManager,
+    // replies are decompressed by readReply() instead, so that the savings can be counted
+    if (!request.hasRawHeader("Accept-Encoding")) {
+        request.setRawHeader("Accept-Encoding", "gzip");
     }
 }
 
-FileLogger::~FileLogger()
+QByteArray readReply(QNetworkReply *reply)
 {
+    const QByteArray rawData = reply->readAll();
+    const QByteArray encoding = reply->rawHeader("Content-Encoding").trimmed().toLower();
+    if (rawData.isEmpty() || (encoding != "gzip" && encoding != "deflate")) {
+        return rawData;
+    }
+
+    const QByteArray data = Gzip::decompress(rawData);
+    if (data.isNull()) {
+        qCWarning(KGAPIDebug) << "Failed to decompress reply from" << reply->url();
+        return rawData;
+    }
+
+    TransferStatistics::instance()->addResponse(rawData.size(), data.size());
+    return data;
 }
 
-FileLogger *FileLogger::self()
+// Replies created by the shared manager while a job is dispatching a request
+struct ReplyCapture {
+    ReplyCapture();
+    ~ReplyCapture();
+
+    QList<QPointer<QObject>> created;
+    ReplyCapture *const previous;
+};
+
+static thread_local ReplyCapture *sReplyCapture = nullptr;
+
+ReplyCapture::ReplyCapture()
+    : previous(sReplyCapture)
+{
+    sReplyCapture = this;
+}
+
+ReplyCapture::~ReplyCapture()
+{
+    sReplyCapture = previous;
+}
+
+// QNetworkAccessManager creates replies as its children, this catches them as they are created
+class ReplyCatcher : public QObject
+{
+public:
+    using QObject::QObject;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (sReplyCapture && event->type() == QEvent::ChildAdded) {
+            // The child is still being constructed, it can only be cast once dispatching is done
+            sReplyCapture->created.append(static_cast<QChildEvent *>(event)->child());
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+// Returns how many milliseconds the server asks to wait before sending the request again, or 0
+qint64 retryAfter(const QNetworkReply *reply)
 {
-    if (!sInstance) {
-        sInstance = new FileLogger();
+    const QByteArray value = reply->rawHeader("Retry-After").trimmed();
+    if (value.isEmpty()) {
+        return 0;
     }
-    return sInstance;
+
+    bool ok = false;
+    const qint64 seconds = value.toLongLong(&ok);
+    if (ok) {
+        return qMax<qint64>(seconds, 0) * 1000;
+    }
+
+    const QDateTime date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+    return date.isValid() ? qMax<qint64>(QDateTime::currentDateTimeUtc().msecsTo(date), 0) : 0;
 }
 
-void FileLogger::logRequest(const QNetworkRequest &request, const QByteArray &rawData)
+QByteArray operationVerb(const QNetworkReply *reply)
 {
-    if (!mFile) {
-        return;
+    switch (reply->operation()) {
+    case QNetworkAccessManager::HeadOperation:
+        return "HEAD";
+    case QNetworkAccessManager::GetOperation:
+        return "GET";
+    case QNetworkAccessManager::PutOperation:
+        return "PUT";
+    case QNetworkAccessManager::PostOperation:
+        return "POST";
+    case QNetworkAccessManager::DeleteOperation:
+        return "DELETE";
+    default:
+        return reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray().toUpper();
     }
+}
 
-    QTextStream stream(mFile.data());
-    stream << "C: " << request.url().toDisplayString() << "\n";
-    const auto headers = request.rawHeaderList();
-    for (const auto &header : headers) {
-        stream << "   " << header << ": " << request.rawHeader(header) << "\n";
+// Stores time elapsed since the request was dispatched into @p field of its timer, unless it's already set
+void markTime(QHash<quint64, RequestTimer> &timers, quint64 id, qint64 RequestTimer::*field)
+{
+    const auto timer = timers.find(id);
+    if (timer != timers.end() && (*timer).*field < 0) {
+        (*timer).*field = timer->clock.nsecsElapsed() / 1000;
     }
-    stream << "   " << rawData << "\n\n";
-    mFile->flush();
 }
 
-void FileLogger::logReply(const QNetworkReply *reply, const QByteArray &rawData)
+// Whether sending the request again has the same effect as sending it once (RFC 9110, section 9.2.2)
+bool isIdempotent(const QNetworkReply *reply)
 {
-    if (!mFile) {
-        return;
+    switch (reply->operation()) {
+    case QNetworkAccessManager::HeadOperation:
+    case QNetworkAccessManager::GetOperation:
+    case QNetworkAccessManager::PutOperation:
+    case QNetworkAccessManager::DeleteOperation:
+        return true;
+    case QNetworkAccessManager::PostOperation:
+        return false;
+    default: {
+        // Custom requests and requests from a batch carry their verb in the attribute
+        const QByteArray verb = reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray().toUpper();
+        return verb == "GET" || verb == "HEAD" || verb == "PUT" || verb == "DELETE" || verb == "OPTIONS";
+    }
+    }
+}
+
+// Whether the request has failed before it could have reached the server
+bool isUnsent(QNetworkReply::NetworkError error)
+{
+    switch (error) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::ProxyConnectionRefusedError:
+    case QNetworkReply::ProxyNotFoundError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isTransient(QNetworkReply::NetworkError error)
+{
+    switch (error) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionClosedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return isUnsent(error);
     }
+}
 
-    QTextStream stream(mFile.data());
-    stream << "S: " << reply->url().toDisplayString() << "\n";
-    const auto headers = reply->rawHeaderList();
-    for (const auto &header : headers) {
-        stream << "   " << header << ": " << reply->rawHeader(header) << "\n";
+// Google rejects requests over the per-user quota with 403 and the reason in the body
+bool isRateLimitError(const QByteArray &rawData)
+{
+    const QJsonObject error = QJsonDocument::fromJson(rawData).object().value(QLatin1StringView("error")).toObject();
+    const QJsonArray errors = error.value(QLatin1StringView("errors")).toArray();
+    for (const auto &item : errors) {
+        const QString reason = item.toObject().value(QLatin1StringView("reason")).toString();
+        if (reason == QLatin1StringView("rateLimitExceeded") || reason == QLatin1StringView("userRateLimitExceeded")) {
+            return true;
+        }
     }
-    stream << "   " << rawData << "\n\n";
-    mFile->flush();
+    return false;
+}
 }
 
 Job::Private::Private(Job *parent)
@@ -87,7 +242,21 @@ Job::Private::Private(Job *parent)
     , error(KGAPI2::NoError)
     , accessManager(nullptr)
     , maxTimeout(0)
+    , maxConcurrentRequests(DefaultMaxConcurrentRequests)
     , prettyPrint(false)
+    , maxRetries(DefaultMaxRetries)
+    , retryDelay(DefaultRetryDelay)
+    , requestCompressionThreshold(-1)
+    , maxBatchSize(1)
+    , batchRecorder(nullptr)
+    , recordingBatch(false)
+    , nextRequestId(1)
+    , nextReplyId(1)
+    , nextBatchId(1)
+    , parseTime(-1)
+    , pendingParses(0)
+    , waitingForTokens(false)
+    , replayedRequests(0)
     , q(parent)
 {
 }
@@ -98,15 +267,49 @@ void Job::Private::init()
         _k_doStart();
     });
 
-    accessManager = NetworkAccessManagerFactory::instance()->networkAccessManager(q);
-    connect(accessManager, &QNetworkAccessManager::finished, q, [this](QNetworkReply *reply) {
-        _k_replyReceived(reply);
-    });
+    accessManager = sharedAccessManager();
 
     dispatchTimer = new QTimer(q);
     connect(dispatchTimer, &QTimer::timeout, q, [this]() {
         _k_dispatchTimeout();
     });
+
+    throttleTimer = new QTimer(q);
+    throttleTimer->setSingleShot(true);
+    connect(throttleTimer, &QTimer::timeout, q, [this]() {
+        _k_dispatchTimeout();
+    });
+}
+
+QNetworkAccessManager *Job::Private::sharedAccessManager()
+{
+    // All jobs in a thread share a single manager, so that connections, TLS sessions
+    // and HTTP/2 streams can be reused across jobs. Replies are routed back to their
+    // job by routeReply(), which needs to be connected only once per manager.
+    static thread_local QPointer<QNetworkAccessManager> routedManager;
+
+    QNetworkAccessManager *nam = NetworkAccessManagerFactory::instance()->sharedNetworkAccessManager();
+    if (routedManager != nam) {
+        routedManager = nam;
+        connect(nam, &QNetworkAccessManager::finished, nam, &Job::Private::routeReply);
+        nam->installEventFilter(new ReplyCatcher(nam));
+    }
+
+    return nam;
+}
+
+void Job::Private::routeReply(QNetworkReply *reply)
+{
+    auto job = qobject_cast<Job *>(reply->request().originatingObject());
+    if (!job) {
+        // The job that has sent the request has been destroyed in the meantime
+        qCDebug(KGAPIDebug) << "Discarding reply from" << reply->url() << "- the job no longer exists";
+        reply->deleteLater();
+        return;
+    }
+
+    job->d->liveReplies.removeOne(reply);
+    job->d->_k_replyReceived(reply);
 }
 
 QString Job::Private::parseErrorMessage(const QByteArray &json)
@@ -145,7 +348,466 @@ void Job::Private::_k_doEmitFinished()
     Q_EMIT q->finished(q);
 }
 
+QNetworkRequest Job::Private::authorizeRequest(const Request &r, quint64 id) const
+{
+    QNetworkRequest authorizedRequest = r.request;
+    if (account) {
+        authorizedRequest.setRawHeader("Authorization", "Bearer " + TokenManager::instance()->accessToken(account).toLatin1());
+    }
+
+    requestCompressedReply(authorizedRequest);
+
+    QUrl url = authorizedRequest.url();
+    QUrlQuery standardParamQuery(url);
+    if (!fields.isEmpty()) {
+        standardParamQuery.addQueryItem(Job::StandardParams::Fields, fields.join(QLatin1Char(',')));
+    }
+
+    if (!standardParamQuery.hasQueryItem(Job::StandardParams::PrettyPrint)) {
+        standardParamQuery.addQueryItem(Job::StandardParams::PrettyPrint, Utils::bool2Str(prettyPrint));
+    }
+
+    url.setQuery(standardParamQuery);
+    authorizedRequest.setUrl(url);
+    authorizedRequest.setOriginatingObject(q);
+    authorizedRequest.setAttribute(RequestIdAttribute, id);
+
+    return authorizedRequest;
+}
+
+void Job::Private::dispatch(const Request &r)
+{
+    const quint64 id = r.id ? r.id : nextRequestId++;
+    Request request = r;
+    request.id = id;
+    inFlightRequests.insert(id, request);
+    ++inFlightPerHost[r.request.url().host()];
+
+    QNetworkRequest authorizedRequest = authorizeRequest(r, id);
+
+    qCDebug(KGAPIDebug) << q << "Dispatching request to" << r.request.url();
+    authorizedRequest.setAttribute(LogIdAttribute, FileLogger::self()->logRequest(authorizedRequest, r.rawData));
+
+    const bool measured = RequestMetrics::instance()->isEnabled();
+    if (measured) {
+        RequestTimer &timer = requestTimers[id];
+        timer.clock.start();
+        timer.queueWait = r.queued.isValid() ? r.queued.nsecsElapsed() / 1000 : -1;
+        timer.retries = r.retries;
+        timer.bytesSent = r.rawData.size();
+    }
+
+    ReplyCapture capture;
+    q->dispatchRequest(accessManager, authorizedRequest, r.rawData, r.contentType);
+
+    for (const auto &child : std::as_const(capture.created)) {
+        auto reply = qobject_cast<QNetworkReply *>(child.data());
+        if (!reply || reply->request().originatingObject() != q) {
+            continue;
+        }
+        liveReplies.append(reply);
+        if (measured) {
+            trackReply(requestTimers, id, reply);
+        }
+    }
+}
+
+bool Job::Private::canBatch() const
+{
+    return maxBatchSize > 1 && batchUrl.isValid() && requestQueue.size() > 1;
+}
+
+void Job::Private::dispatchBatch()
+{
+    if (!batchRecorder) {
+        batchRecorder = new BatchRequestRecorder(q);
+    }
+
+    QList<quint64> ids;
+    while (!requestQueue.isEmpty() && ids.size() < maxBatchSize) {
+        const Request r = requestQueue.dequeue();
+        const quint64 id = r.id ? r.id : nextRequestId++;
+        Request request = r;
+        request.id = id;
+        inFlightRequests.insert(id, request);
+        ids << id;
+
+        // Let the job create the request as usual, but only record it instead of sending it
+        recordingBatch = true;
+        q->dispatchRequest(batchRecorder, authorizeRequest(r, id), r.rawData, r.contentType);
+        recordingBatch = false;
+    }
+
+    auto parts = batchRecorder->takeParts();
+    for (auto &part : parts) {
+        const quint64 id = part.request.attribute(RequestIdAttribute).toULongLong();
+        part.contentId = "item-" + QByteArray::number(id);
+        // Replies to the parts don't know their operation, but retry() needs to know the verb
+        inFlightRequests[id].request.setAttribute(QNetworkRequest::CustomVerbAttribute, part.verb);
+    }
+
+    QByteArray boundary;
+    const QByteArray rawData = BatchRequest::serialize(parts, boundary);
+
+    const quint64 batchId = nextBatchId++;
+    inFlightBatches.insert(batchId, ids);
+    ++inFlightPerHost[batchUrl.host()];
+
+    QNetworkRequest request(batchUrl);
+    if (account) {
+        request.setRawHeader("Authorization", "Bearer " + TokenManager::instance()->accessToken(account).toLatin1());
+    }
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArray("multipart/mixed; boundary=" + boundary));
+    requestCompressedReply(request);
+    request.setOriginatingObject(q);
+    request.setAttribute(BatchIdAttribute, batchId);
+
+    qCDebug(KGAPIDebug) << q << "Dispatching batch of" << ids.size() << "requests to" << batchUrl;
+    request.setAttribute(LogIdAttribute, FileLogger::self()->logRequest(request, rawData));
+
+    QNetworkReply *reply = accessManager->post(request, rawData);
+    liveReplies.append(reply);
+
+    if (RequestMetrics::instance()->isEnabled()) {
+        RequestTimer &timer = batchTimers[batchId];
+        timer.clock.start();
+        timer.bytesSent = rawData.size();
+        trackReply(batchTimers, batchId, reply);
+    }
+}
+
+void Job::Private::batchReplyReceived(QNetworkReply *reply, const QList<quint64> &ids)
+{
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QByteArray rawData = readReply(reply);
+
+    qCDebug(KGAPIDebug) << "Received batch reply from" << reply->url();
+    qCDebug(KGAPIDebug) << "Status code: " << replyCode;
+    FileLogger::self()->logReply(reply, rawData, reply->request().attribute(LogIdAttribute).toULongLong());
+
+    QHash<QByteArray, BatchRequest::Response> responses;
+    if (replyCode == KGAPI2::OK) {
+        const auto parsed = BatchRequest::parse(reply->rawHeader("Content-Type"), rawData);
+        for (const auto &response : parsed) {
+            responses.insert(response.contentId, response);
+        }
+    }
+
+    BatchRequest::RawHeaders replyHeaders;
+    if (replyCode != KGAPI2::OK) {
+        const auto headers = reply->rawHeaderList();
+        for (const auto &header : headers) {
+            replyHeaders.append({header, reply->rawHeader(header)});
+        }
+    }
+
+    for (const quint64 id : ids) {
+        auto part = new BatchPartReply(authorizeRequest(inFlightRequests.value(id), id), q);
+        const auto response = responses.constFind("item-" + QByteArray::number(id));
+        if (response != responses.cend()) {
+            part->setResponse(response->statusCode, response->headers, response->body);
+        } else if (replyCode != KGAPI2::OK) {
+            // The whole batch has failed, so has every request in it
+            part->setResponse(replyCode, replyHeaders, rawData);
+        } else {
+            qCWarning(KGAPIDebug) << "Batch reply is missing response for" << part->url();
+            part->setResponse(KGAPI2::InternalError, {}, QByteArrayLiteral("Missing response in batch reply"));
+        }
+        completedReplies.insert(id, part);
+    }
+}
+
+void Job::Private::clearPendingRequests()
+{
+    requestQueue.clear();
+    inFlightRequests.clear();
+    inFlightBatches.clear();
+    inFlightPerHost.clear();
+    for (QNetworkReply *reply : std::as_const(completedReplies)) {
+        reply->deleteLater();
+    }
+    completedReplies.clear();
+    requestTimers.clear();
+    batchTimers.clear();
+    // Replies to requests that are still on the wire will be discarded
+    nextReplyId = nextRequestId;
+
+    // The manager is shared with other jobs, so the requests have to be aborted explicitly.
+    // Aborting may emit the finished signal right away, the reply is discarded by then.
+    // The job may be partially destroyed already, so its own handlers must not be called.
+    const auto replies = liveReplies;
+    liveReplies.clear();
+    for (const auto &reply : replies) {
+        if (reply) {
+            QObject::disconnect(reply, nullptr, q, nullptr);
+            reply->abort();
+            reply->deleteLater();
+        }
+    }
+
+    waitingForTokens = false;
+    replayedRequests = 0;
+    QObject::disconnect(tokensConnection);
+}
+
+void Job::Private::waitForTokens()
+{
+    dispatchTimer->stop();
+    if (waitingForTokens) {
+        return;
+    }
+
+    qCDebug(KGAPIDebug) << q << "Waiting for tokens of" << account->accountName() << "to be refreshed";
+    waitingForTokens = true;
+    auto manager = TokenManager::instance();
+    tokensConnection = connect(manager, &TokenManager::tokensRefreshed, q, [this](const AccountPtr &refreshed, Error error, const QString &errorString) {
+        if (refreshed == account) {
+            tokensRefreshed(error, errorString);
+        }
+    });
+    manager->refreshTokens(account);
+}
+
+void Job::Private::tokensRefreshed(Error refreshError, const QString &refreshErrorString)
+{
+    QObject::disconnect(tokensConnection);
+    waitingForTokens = false;
+
+    if (refreshError != KGAPI2::NoError) {
+        q->setError(refreshError);
+        q->setErrorString(tr("Failed to refresh access token: %1").arg(refreshErrorString));
+        q->emitFinished();
+        return;
+    }
+
+    // The server may issue tokens that expire sooner than TokenManager::refreshMargin()
+    refreshedExpiration = TokenManager::instance()->expireDateTime(account);
+    if (!requestQueue.isEmpty()) {
+        dispatchTimer->start();
+    }
+}
+
+bool Job::Private::needsTokens() const
+{
+    return account && TokenManager::instance()->expireDateTime(account) != refreshedExpiration && TokenManager::instance()->needsRefresh(account);
+}
+
+QString Job::Private::rateLimitKey() const
+{
+    return account ? account->accountName() : QString();
+}
+
+void Job::Private::throttle(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const qint64 delay = RateLimiter::instance()->reportRateLimited(rateLimitKey(), currentRequest.request.url().host(), retryAfter(reply));
+    if (maxTimeout > 0 && delay > maxTimeout * 1000LL) {
+        const QString msg = parseErrorMessage(rawData);
+        q->setError(KGAPI2::QuotaExceeded);
+        q->setErrorString(tr("Maximum quota exceeded. Try again later.\n\nGoogle replied '%1'").arg(msg));
+        q->emitFinished();
+        return;
+    }
+
+    sendAgainLater(currentRequest, delay);
+}
+
+bool Job::Private::retry(const QNetworkReply *reply, int replyCode)
+{
+    if (currentRequest.retries >= maxRetries) {
+        return false;
+    }
+
+    if (replyCode == 0) {
+        if (!isTransient(reply->error()) || (!isUnsent(reply->error()) && !isIdempotent(reply))) {
+            return false;
+        }
+    } else if (!isIdempotent(reply)) {
+        // The server may have processed the request before failing, sending it again could duplicate it
+        return false;
+    }
+
+    Request r = currentRequest;
+    ++r.retries;
+    const qint64 backoff = qMin<qint64>(qint64(retryDelay) << qMin(r.retries - 1, 16), MaxRetryDelay);
+    // Random jitter, so that requests that failed at the same time are not sent again at the same time
+    const qint64 delay = backoff + QRandomGenerator::global()->bounded(backoff / 2 + 1);
+    qCWarning(KGAPIDebug) << "Request to" << reply->url() << "failed with" << replyCode << reply->error() << ", retrying in" << delay << "msecs, attempt" << r.retries;
+    sendAgainLater(r, delay);
+    return true;
+}
+
+void Job::Private::sendAgain(const Request &r)
+{
+    // Send the request ahead of the requests that have not been sent yet, in the order in which
+    // the requests sent again have been sent. The request keeps its ID, so replies to the requests
+    // sent after it are not handled before the reply to it, see _k_replyReceived().
+    Request request = r;
+    request.queued.start();
+    requestQueue.insert(replayedRequests++, request);
+    nextReplyId = qMin(nextReplyId, request.id);
+}
+
+void Job::Private::sendAgainLater(const Request &r, qint64 delay)
+{
+    // Send the request again once the delay is over
+    sendAgain(r);
+    dispatchTimer->stop();
+    if (!throttleTimer->isActive() || throttleTimer->remainingTime() < delay) {
+        qCDebug(KGAPIDebug) << q << "Pausing dispatching of requests for" << delay << "msecs";
+        throttleTimer->start(int(delay));
+    }
+}
+
+void Job::Private::trackReply(QHash<quint64, RequestTimer> &timers, quint64 id, QNetworkReply *reply)
+{
+    connect(reply, &QNetworkReply::socketStartedConnecting, q, [&timers, id]() {
+        markTime(timers, id, &RequestTimer::connectStarted);
+    });
+    connect(reply, &QNetworkReply::encrypted, q, [&timers, id]() {
+        markTime(timers, id, &RequestTimer::encrypted);
+    });
+    connect(reply, &QNetworkReply::requestSent, q, [&timers, id]() {
+        markTime(timers, id, &RequestTimer::requestSent);
+    });
+    connect(reply, &QNetworkReply::metaDataChanged, q, [&timers, id]() {
+        markTime(timers, id, &RequestTimer::firstByte);
+    });
+    connect(reply, &QNetworkReply::uploadProgress, q, [&timers, id](qint64 bytesSent) {
+        const auto timer = timers.find(id);
+        if (timer != timers.end() && bytesSent > 0) {
+            // The body may have been compressed by the job
+            timer->bytesSent = bytesSent;
+        }
+    });
+}
+
+void Job::Private::recordTiming(const RequestTimer &timer, const QNetworkReply *reply, qint64 parse)
+{
+    RequestTiming timing;
+    timing.url = reply->request().url();
+    timing.api = RequestMetrics::apiForUrl(timing.url);
+    timing.method = operationVerb(reply);
+    timing.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    timing.retries = timer.retries;
+    timing.bytesSent = timer.bytesSent;
+    timing.bytesReceived = timer.bytesReceived;
+
+    timing.queueWait = timer.queueWait;
+    // There is no connection phase when an open connection is reused
+    if (timer.connectStarted >= 0) {
+        const qint64 connected = timer.encrypted >= 0 ? timer.encrypted : timer.requestSent;
+        if (connected >= timer.connectStarted) {
+            timing.connect = connected - timer.connectStarted;
+        }
+    }
+    if (timer.firstByte >= 0) {
+        timing.timeToFirstByte = timer.firstByte - qMax<qint64>(timer.requestSent, 0);
+        if (timer.finished >= timer.firstByte) {
+            timing.transfer = timer.finished - timer.firstByte;
+        }
+    }
+    timing.parse = parse;
+    timing.total = timer.finished;
+
+    RequestMetrics::instance()->record(timing);
+}
+
+void Job::Private::finishIfIdle()
+{
+    if (isRunning && requestQueue.isEmpty() && inFlightRequests.isEmpty() && pendingParses == 0) {
+        q->emitFinished();
+    }
+}
+
+bool Job::Private::replayUnauthorized(const QNetworkReply *reply)
+{
+    if (!account || currentRequest.replayed || !TokenManager::instance()->isEnabled() || account->refreshToken().isEmpty()) {
+        return false;
+    }
+
+    // Send the request again once the token is refreshed
+    Request r = currentRequest;
+    r.replayed = true;
+    sendAgain(r);
+
+    // The token may have already been refreshed since the request was sent
+    const QByteArray authorization = "Bearer " + TokenManager::instance()->accessToken(account).toLatin1();
+    if (!waitingForTokens && reply->request().rawHeader("Authorization") != authorization) {
+        qCDebug(KGAPIDebug) << q << "Request was sent with an outdated token, sending it again";
+        return true;
+    }
+
+    waitForTokens();
+    return true;
+}
+
 void Job::Private::_k_replyReceived(QNetworkReply *reply)
+{
+    const quint64 batchId = reply->request().attribute(BatchIdAttribute).toULongLong();
+    const quint64 id = reply->request().attribute(RequestIdAttribute).toULongLong();
+    if (batchId ? !inFlightBatches.contains(batchId) : !inFlightRequests.contains(id)) {
+        qCDebug(KGAPIDebug) << "Discarding reply from" << reply->url() << "- the request is no longer pending";
+        reply->deleteLater();
+        return;
+    }
+
+    const QString host = reply->request().url().host();
+    if (--inFlightPerHost[host] <= 0) {
+        inFlightPerHost.remove(host);
+    }
+
+    auto &timers = batchId ? batchTimers : requestTimers;
+    const auto timer = timers.find(batchId ? batchId : id);
+    if (timer != timers.end()) {
+        timer->finished = timer->clock.nsecsElapsed() / 1000;
+        // Nothing has been read from the reply yet, so this is the size of the body as received
+        timer->bytesReceived = reply->bytesAvailable();
+    }
+
+    if (batchId) {
+        batchReplyReceived(reply, inFlightBatches.take(batchId));
+        if (batchTimers.contains(batchId)) {
+            recordTiming(batchTimers.take(batchId), reply, -1);
+        }
+        reply->deleteLater();
+    } else {
+        completedReplies.insert(id, reply);
+    }
+
+    // Requests may finish in any order, but replies are always handled in the
+    // order in which the requests were dispatched.
+    while (completedReplies.contains(nextReplyId)) {
+        const quint64 replyId = nextReplyId++;
+        QNetworkReply *nextReply = completedReplies.take(replyId);
+        currentRequest = inFlightRequests.take(replyId);
+        // Taken before handling the reply, which may clear all pending requests
+        const RequestTimer replyTimer = requestTimers.take(replyId);
+
+        parseTime = -1;
+        handleReply(nextReply);
+        if (replyTimer.clock.isValid()) {
+            recordTiming(replyTimer, nextReply, parseTime);
+        }
+        nextReply->deleteLater();
+    }
+
+    // handleReply has terminated the job, don't continue
+    if (!q->isRunning()) {
+        return;
+    }
+
+    qCDebug(KGAPIDebug) << requestQueue.length() << "requests in requestQueue," << inFlightRequests.size() << "requests in flight.";
+    if (requestQueue.isEmpty()) {
+        finishIfIdle();
+        return;
+    }
+
+    if (!dispatchTimer->isActive()) {
+        dispatchTimer->start();
+    }
+}
+
+void Job::Private::handleReply(QNetworkReply *reply)
 {
     int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     if (replyCode == 0) {
@@ -159,18 +821,36 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         }
     }
 
-    const QByteArray rawData = reply->readAll();
+    const QByteArray rawData = readReply(reply);
 
     qCDebug(KGAPIDebug) << "Received reply from" << reply->url();
     qCDebug(KGAPIDebug) << "Status code: " << replyCode;
-    FileLogger::self()->logReply(reply, rawData);
+    // Parts of batch replies are already logged as part of the whole batch reply
+    const QVariant logId = reply->request().attribute(LogIdAttribute);
+    if (logId.isValid()) {
+        FileLogger::self()->logReply(reply, rawData, logId.toULongLong());
+    }
+
+    // The request has failed without any reply from the server
+    if (replyCode == 0 && reply->error() != QNetworkReply::NoError) {
+        if (!q->handleError(replyCode, rawData) && !retry(reply, replyCode)) {
+            qCWarning(KGAPIDebug) << "Network error" << reply->error() << reply->errorString();
+            q->setError(KGAPI2::NetworkError);
+            q->setErrorString(tr("Network error: %1").arg(reply->errorString()));
+            q->emitFinished();
+        }
+        return;
+    }
 
     switch (replyCode) {
     case KGAPI2::NoError:
     case KGAPI2::OK: /** << OK status (fetched, updated, removed) */
     case KGAPI2::Created: /** << OK status (created) */
     case KGAPI2::NoContent: /** << OK status (removed task using Tasks API) */
+    case KGAPI2::PartialContent: /** << OK status (fetched requested range of content) */
     case KGAPI2::ResumeIncomplete: /** << OK status (partially uploaded a file via resumable upload) */
+    case KGAPI2::NotModified: /** << OK status (cached content is still valid, see ResponseCache) */
+        RateLimiter::instance()->reportSuccess(rateLimitKey(), currentRequest.request.url().host());
         q->handleReply(reply, rawData);
         break;
 
@@ -178,9 +858,9 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
                                                 method */
     case KGAPI2::TemporarilyMoved: { /** << Temporarily moved - Google provides a new URL where to send the request */
         qCDebug(KGAPIDebug) << "Google says: Temporarily moved to " << reply->header(QNetworkRequest::LocationHeader).toUrl();
-        QNetworkRequest request = currentRequest.request;
-        request.setUrl(reply->header(QNetworkRequest::LocationHeader).toUrl());
-        q->enqueueRequest(request, currentRequest.rawData, currentRequest.contentType);
+        Request r = currentRequest;
+        r.request.setUrl(reply->header(QNetworkRequest::LocationHeader).toUrl());
+        sendAgain(r);
         break;
     }
 
@@ -195,6 +875,10 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         break;
 
     case KGAPI2::Unauthorized: /** << Unauthorized - Access token has expired, request a new token */
+        if (replayUnauthorized(reply)) {
+            qCDebug(KGAPIDebug) << "Unauthorized, sending the request again with refreshed access token";
+            break;
+        }
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "Unauthorized. Access token has expired or is invalid.";
             q->setError(KGAPI2::Unauthorized);
@@ -205,6 +889,11 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         break;
 
     case KGAPI2::Forbidden:
+        if (isRateLimitError(rawData)) {
+            qCWarning(KGAPIDebug) << "User rate limit exceeded.";
+            throttle(reply, rawData);
+            return;
+        }
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "Requested resource is forbidden.";
             const QString msg = parseErrorMessage(rawData);
@@ -249,7 +938,7 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         break;
 
     case KGAPI2::InternalError:
-        if (!q->handleError(replyCode, rawData)) {
+        if (!q->handleError(replyCode, rawData) && !retry(reply, replyCode)) {
             qCWarning(KGAPIDebug) << "Internal server error.";
             const QString msg = parseErrorMessage(rawData);
             q->setError(KGAPI2::InternalError);
@@ -259,37 +948,26 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         }
         break;
 
-    case KGAPI2::QuotaExceeded: {
+    case KGAPI2::TooManyRequests:
+    case KGAPI2::QuotaExceeded:
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "User quota exceeded.";
+            throttle(reply, rawData);
+            return;
+        }
+        break;
 
-            // Extend the interval (if possible) and enqueue the request again
-            int interval = dispatchTimer->interval() / 1000;
-            if (interval == 0) {
-                interval = 1;
-            } else if (interval == 1) {
-                interval = 2;
-            } else if ((interval > maxTimeout) && (maxTimeout > 0)) {
-                const QString msg = parseErrorMessage(rawData);
-                q->setError(KGAPI2::QuotaExceeded);
-                q->setErrorString(tr("Maximum quota exceeded. Try again later.\n\nGoogle replied '%1'").arg(msg));
-                q->emitFinished();
-                return;
-            } else {
-                interval = interval ^ 2;
-            }
-            qCDebug(KGAPIDebug) << "Increasing dispatch interval to" << interval * 1000 << "msecs";
-            dispatchTimer->setInterval(interval * 1000);
-
-            const QNetworkRequest request = reply->request();
-            q->enqueueRequest(request);
-            if (!dispatchTimer->isActive()) {
-                dispatchTimer->start();
-            }
+    case KGAPI2::BadGateway:
+    case KGAPI2::GatewayTimeout:
+        if (!q->handleError(replyCode, rawData) && !retry(reply, replyCode)) {
+            qCWarning(KGAPIDebug) << "Server is temporarily unavailable" << replyCode;
+            const QString msg = parseErrorMessage(rawData);
+            q->setError(KGAPI2::UnknownError);
+            q->setErrorString(tr("Server is temporarily unavailable. Try again later.\n\nGoogle replied '%1'").arg(msg));
+            q->emitFinished();
             return;
         }
         break;
-    }
 
     default: /** Something went wrong, there's nothing we can do about it */
         if (!q->handleError(replyCode, rawData)) {
@@ -302,56 +980,48 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         }
         break;
     }
-
-    // handleReply has terminated the job, don't continue
-    if (!q->isRunning()) {
-        return;
-    }
-
-    qCDebug(KGAPIDebug) << requestQueue.length() << "requests in requestQueue.";
-    if (requestQueue.isEmpty()) {
-        q->emitFinished();
-        return;
-    }
-
-    if (!dispatchTimer->isActive()) {
-        dispatchTimer->start();
-    }
 }
 
 void Job::Private::_k_dispatchTimeout()
 {
-    if (requestQueue.isEmpty()) {
-        dispatchTimer->stop();
+    // Don't send requests with a token that is known to be expired
+    if (waitingForTokens || (!requestQueue.isEmpty() && needsTokens())) {
+        waitForTokens();
         return;
     }
-
-    const Request r = requestQueue.dequeue();
-    currentRequest = r;
-
-    QNetworkRequest authorizedRequest = r.request;
-    if (account) {
-        authorizedRequest.setRawHeader("Authorization", "Bearer " + account->accessToken().toLatin1());
+    // Wait until the account is no longer backed off, the throttle timer will resume dispatching
+    if (throttleTimer->isActive()) {
+        dispatchTimer->stop();
+        return;
     }
+    // Replayed requests are about to be dequeued
+    replayedRequests = 0;
+
+    while (!requestQueue.isEmpty()) {
+        const bool batch = canBatch();
+        const QString host = batch ? batchUrl.host() : requestQueue.head().request.url().host();
+        if (inFlightPerHost.value(host) >= maxConcurrentRequests) {
+            // Wait until a reply frees a slot, _k_replyReceived() will restart the timer
+            dispatchTimer->stop();
+            return;
+        }
 
-    QUrl url = authorizedRequest.url();
-    QUrlQuery standardParamQuery(url);
-    if (!fields.isEmpty()) {
-        standardParamQuery.addQueryItem(Job::StandardParams::Fields, fields.join(QLatin1Char(',')));
-    }
+        // Requests in a batch count against the quota individually
+        const int cost = batch ? qMin<int>(requestQueue.size(), maxBatchSize) : 1;
+        const qint64 wait = RateLimiter::instance()->acquire(rateLimitKey(), host, cost);
+        if (wait > 0) {
+            dispatchTimer->stop();
+            throttleTimer->start(int(wait));
+            return;
+        }
 
-    if (!standardParamQuery.hasQueryItem(Job::StandardParams::PrettyPrint)) {
-        standardParamQuery.addQueryItem(Job::StandardParams::PrettyPrint, Utils::bool2Str(prettyPrint));
+        if (batch) {
+            dispatchBatch();
+        } else {
+            dispatch(requestQueue.dequeue());
+        }
     }
 
-    url.setQuery(standardParamQuery);
-    authorizedRequest.setUrl(url);
-
-    qCDebug(KGAPIDebug) << q << "Dispatching request to" << r.request.url();
-    FileLogger::self()->logRequest(authorizedRequest, r.rawData);
-
-    q->dispatchRequest(accessManager, authorizedRequest, r.rawData, r.contentType);
-
     if (requestQueue.isEmpty()) {
         dispatchTimer->stop();
     }
@@ -380,6 +1050,7 @@ Job::Job(const AccountPtr &account, QObject *parent)
 
 Job::~Job()
 {
+    d->clearPendingRequests();
     delete d;
 }
 
@@ -423,6 +1094,99 @@ int Job::maxTimeout() const
     return d->maxTimeout;
 }
 
+int Job::maxConcurrentRequests() const
+{
+    return d->maxConcurrentRequests;
+}
+
+void Job::setMaxConcurrentRequests(int maxConcurrentRequests)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setMaxConcurrentRequests() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxConcurrentRequests = qMax(1, maxConcurrentRequests);
+}
+
+int Job::maxRetries() const
+{
+    return d->maxRetries;
+}
+
+void Job::setMaxRetries(int maxRetries)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setMaxRetries() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxRetries = qMax(0, maxRetries);
+}
+
+int Job::retryDelay() const
+{
+    return d->retryDelay;
+}
+
+void Job::setRetryDelay(int msecs)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setRetryDelay() on running job. Ignoring.";
+        return;
+    }
+
+    d->retryDelay = qMax(0, msecs);
+}
+
+int Job::requestCompressionThreshold() const
+{
+    return d->requestCompressionThreshold;
+}
+
+void Job::setRequestCompressionThreshold(int bytes)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setRequestCompressionThreshold() on running job. Ignoring.";
+        return;
+    }
+
+    d->requestCompressionThreshold = bytes;
+}
+
+QByteArray Job::compressRequestBody(QNetworkRequest &request, const QByteArray &data) const
+{
+    // Parts of a batch request can't be compressed individually
+    if (d->requestCompressionThreshold < 0 || data.size() <= d->requestCompressionThreshold || d->recordingBatch
+        || request.hasRawHeader("Content-Encoding")) {
+        return data;
+    }
+
+    const QByteArray compressed = Gzip::compress(data);
+    if (compressed.isNull() || compressed.size() >= data.size()) {
+        return data;
+    }
+
+    request.setRawHeader("Content-Encoding", "gzip");
+    TransferStatistics::instance()->addRequest(data.size(), compressed.size());
+    return compressed;
+}
+
+int Job::maxBatchSize() const
+{
+    return d->maxBatchSize;
+}
+
+void Job::setMaxBatchSize(int maxBatchSize)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setMaxBatchSize() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxBatchSize = qBound(1, maxBatchSize, MaxBatchSize);
+}
+
 void Job::setMaxTimeout(int maxTimeout)
 {
     if (isRunning()) {
@@ -496,7 +1260,8 @@ void Job::emitFinished()
 
     d->isRunning = false;
     d->dispatchTimer->stop();
-    d->requestQueue.clear();
+    d->throttleTimer->stop();
+    d->clearPendingRequests();
 
     // Emit in next event loop iteration so that the method caller can finish
     // before user is notified
@@ -505,6 +1270,28 @@ void Job::emitFinished()
     });
 }
 
+QNetworkRequest Job::currentRequest() const
+{
+    return d->currentRequest.request;
+}
+
+void Job::sendCurrentRequestAgain(const QNetworkRequest &request)
+{
+    Request r = d->currentRequest;
+    r.request = request;
+    d->sendAgain(r);
+}
+
+QUrl Job::batchUrl() const
+{
+    return d->batchUrl;
+}
+
+void Job::setBatchUrl(const QUrl &batchUrl)
+{
+    d->batchUrl = batchUrl;
+}
+
 void Job::emitProgress(int processed, int total)
 {
     Q_EMIT progress(this, processed, total);
@@ -524,6 +1311,7 @@ void Job::enqueueRequest(const QNetworkRequest &request, const QByteArray &data,
     r_.request = request;
     r_.rawData = data;
     r_.contentType = contentType;
+    r_.queued.start();
 
     d->requestQueue.enqueue(r_);
 
@@ -532,6 +1320,32 @@ void Job::enqueueRequest(const QNetworkRequest &request, const QByteArray &data,
     }
 }
 
+void Job::dispatchQueuedRequests()
+{
+    // When throttled, leave the dispatching to the timer
+    if (!isRunning() || d->throttleTimer->isActive()) {
+        return;
+    }
+
+    d->_k_dispatchTimeout();
+}
+
+void Job::beginDeferredParse()
+{
+    ++d->pendingParses;
+}
+
+void Job::endDeferredParse()
+{
+    --d->pendingParses;
+    d->finishIfIdle();
+}
+
+void Job::setParseTime(qint64 parseTime)
+{
+    d->parseTime = parseTime;
+}
+
 void Job::aboutToFinish()
 {
 }
@@ -543,7 +1357,7 @@ void Job::aboutToStart()
     d->currentRequest.contentType.clear();
     d->currentRequest.rawData.clear();
     d->currentRequest.request = QNetworkRequest();
-    d->dispatchTimer->setInterval(0);
+    d->pendingParses = 0;
 }
 
 bool Job::handleError(int errorCode, const QByteArray &rawData)
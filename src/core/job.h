@@ -34,6 +34,10 @@ namespace KGAPI2
  *
  * Job is automatically started when program enters an event loop.
  *
+ * When multiple requests are enqueued, up to Job::maxConcurrentRequests of them
+ * are sent to the same host at the same time. The replies are always passed to
+ * Job::handleReply in the order in which the requests have been dispatched.
+ *
  * @author Daniel Vrátil <dvratil@redhat.com>
  * @since 2.0
  */
@@ -45,16 +49,84 @@ class KGAPICORE_EXPORT Job : public QObject
      * @brief Maximum interval between requests.
      *
      * Some Google APIs have a quota on maximum amount of requests per account
-     * per second. When this quota is exceeded, the Job will automatically increase
-     * the interval between dispatching requests, wait for a while and then try
-     * again. If however the interval is increased over @p maxTimeout, the job
-     * will fail and finish immediately. By default @p maxTimeout is @p -1, which
-     * allows the interval to be increased indefinitely.
+     * per second. When this quota is exceeded, the Job will automatically back
+     * off, wait for a while and then try again. The backoff is shared by all
+     * jobs of the same account, see KGAPI2::RateLimiter. If however the backoff
+     * grows over @p maxTimeout, the job will fail and finish immediately. By
+     * default @p maxTimeout is @p -1, which allows to back off indefinitely.
      *
      * @see Job::maxTimeout, Job::setMaxTimeout
      */
     Q_PROPERTY(int maxTimeout READ maxTimeout WRITE setMaxTimeout)
 
+    /**
+     * @brief Maximum amount of requests in flight to a single host.
+     *
+     * Enqueued requests are dispatched concurrently, but no more than
+     * @p maxConcurrentRequests requests to the same host are waiting for a
+     * reply at any time. Replies are still handled in the order in which the
+     * requests have been dispatched. Default is 6; setting it to 1 makes the
+     * job send its requests strictly one after another.
+     *
+     * @see Job::maxConcurrentRequests, Job::setMaxConcurrentRequests
+     * @since 6.1
+     */
+    Q_PROPERTY(int maxConcurrentRequests READ maxConcurrentRequests WRITE setMaxConcurrentRequests)
+
+    /**
+     * @brief Maximum amount of requests packed into a single batch request.
+     *
+     * Jobs that support it can send multiple queued requests in a single
+     * multipart/mixed batch request, which saves a round-trip per request.
+     * The replies are still handled one by one as if the requests were sent
+     * separately. Default is 1, which disables batching. Google accepts at
+     * most 100 requests in a batch.
+     *
+     * @see Job::maxBatchSize, Job::setMaxBatchSize
+     * @since 6.1
+     */
+    Q_PROPERTY(int maxBatchSize READ maxBatchSize WRITE setMaxBatchSize)
+
+    /**
+     * @brief Maximum amount of times a failed request is sent again.
+     *
+     * Requests that fail due to a transient error, like an interrupted
+     * connection or a 500, 502 or 504 reply from the server, are sent again
+     * after an exponentially growing delay, without restarting the whole job.
+     * Only requests that can be safely repeated (GET, HEAD, PUT and DELETE)
+     * are retried after they may have reached the server, other requests are
+     * retried only when they could not be sent at all. Default is 3; setting
+     * it to 0 disables retrying.
+     *
+     * @see Job::maxRetries, Job::setMaxRetries, Job::retryDelay
+     * @since 6.1
+     */
+    Q_PROPERTY(int maxRetries READ maxRetries WRITE setMaxRetries)
+
+    /**
+     * @brief Delay in milliseconds before a failed request is sent again.
+     *
+     * The delay is doubled with every further attempt to send the same
+     * request. Default is 1000 milliseconds.
+     *
+     * @see Job::retryDelay, Job::setRetryDelay, Job::maxRetries
+     * @since 6.1
+     */
+    Q_PROPERTY(int retryDelay READ retryDelay WRITE setRetryDelay)
+
+    /**
+     * @brief Size in bytes above which request bodies are compressed.
+     *
+     * Replies are always requested compressed. Request bodies larger than
+     * @p requestCompressionThreshold are sent compressed with gzip by jobs
+     * that create or modify resources. Not all Google APIs accept compressed
+     * requests, so this is disabled by default (@p -1).
+     *
+     * @see Job::requestCompressionThreshold, Job::setRequestCompressionThreshold, KGAPI2::TransferStatistics
+     * @since 6.1
+     */
+    Q_PROPERTY(int requestCompressionThreshold READ requestCompressionThreshold WRITE setRequestCompressionThreshold)
+
     /**
      * @brief Whether the job is running
      *
@@ -123,7 +195,8 @@ public:
      * a request that has previously failed due to exceeded quota.
      *
      * Default timeout is 1 seconds, then after every failed request the timeout
-     * is increased exponentially until reaching @p maxTimeout.
+     * is increased exponentially until reaching @p maxTimeout. When the server
+     * tells how long to wait via the Retry-After header, that delay is used instead.
      *
      * @param maxTimeout Maximum timeout (in seconds), or @p -1 for no timeout
      */
@@ -137,6 +210,97 @@ public:
      */
     int maxTimeout() const;
 
+    /**
+     * @brief Set maximum amount of concurrent requests per host
+     *
+     * This method can only be called before the job is started.
+     *
+     * @param maxConcurrentRequests Maximum amount of requests to a single host
+     *        that can be in flight at the same time. Values lower than 1 are
+     *        treated as 1.
+     */
+    void setMaxConcurrentRequests(int maxConcurrentRequests);
+
+    /**
+     * @brief Maximum amount of concurrent requests per host
+     *
+     * @return Returns maximum amount of requests to a single host that can be
+     *         in flight at the same time.
+     * @see Job::setMaxConcurrentRequests
+     */
+    int maxConcurrentRequests() const;
+
+    /**
+     * @brief Set maximum amount of requests in a single batch request
+     *
+     * This method can only be called before the job is started. Batching
+     * only has effect for jobs that support it and when more than one
+     * request is queued.
+     *
+     * @param maxBatchSize Maximum amount of requests in a batch request,
+     *        between 1 (no batching) and 100.
+     */
+    void setMaxBatchSize(int maxBatchSize);
+
+    /**
+     * @brief Maximum amount of requests in a single batch request
+     *
+     * @return Returns maximum amount of requests packed into a single batch
+     *         request, 1 when batching is disabled.
+     * @see Job::setMaxBatchSize
+     */
+    int maxBatchSize() const;
+
+    /**
+     * @brief Set maximum amount of times a failed request is sent again
+     *
+     * This method can only be called before the job is started.
+     *
+     * @param maxRetries Maximum amount of retries of a single request, 0 to
+     *        never retry.
+     */
+    void setMaxRetries(int maxRetries);
+
+    /**
+     * @brief Maximum amount of times a failed request is sent again
+     *
+     * @see Job::setMaxRetries
+     */
+    int maxRetries() const;
+
+    /**
+     * @brief Set delay before a failed request is sent again for the first time
+     *
+     * This method can only be called before the job is started.
+     *
+     * @param msecs Delay in milliseconds
+     */
+    void setRetryDelay(int msecs);
+
+    /**
+     * @brief Delay before a failed request is sent again for the first time
+     *
+     * @see Job::setRetryDelay
+     */
+    int retryDelay() const;
+
+    /**
+     * @brief Set size in bytes above which request bodies are compressed
+     *
+     * This method can only be called before the job is started.
+     *
+     * @param bytes Minimum size of compressed request bodies, or @p -1 to
+     *        never compress request bodies.
+     */
+    void setRequestCompressionThreshold(int bytes);
+
+    /**
+     * @brief Size in bytes above which request bodies are compressed
+     *
+     * @see Job::setRequestCompressionThreshold
+     */
+    int requestCompressionThreshold() const;
+
     /**
      * @brief Whether job is running
      *
@@ -321,6 +485,19 @@ protected:
      */
     virtual void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) = 0;
 
+    /**
+     * @brief Compresses @p data to be sent in the body of @p request
+     *
+     * Subclasses that send @p data passed to Job::dispatchRequest as is can
+     * call this method to compress it according to requestCompressionThreshold().
+     * The Content-Encoding header is set on @p request when @p data has been
+     * compressed.
+     *
+     * @return Data to send in the body of @p request
+     * @since 6.1
+     */
+    QByteArray compressRequestBody(QNetworkRequest &request, const QByteArray &data) const;
+
     /**
      * @brief Called when a reply is received.
      *
@@ -348,6 +525,32 @@ protected:
      */
     virtual bool handleError(int statusCode, const QByteArray &rawData);
 
+    /**
+     * @brief Returns the request whose reply is being handled
+     *
+     * Only valid during handleReply() and handleError(). Subclasses that
+     * have multiple different requests in flight can use it to find out
+     * which of them the reply belongs to.
+     *
+     * @since 6.1
+     */
+    QNetworkRequest currentRequest() const;
+
+    /**
+     * @brief Sends the request whose reply is being handled again
+     *
+     * Unlike Job::enqueueRequest, the request keeps its place in the job:
+     * it is sent before the requests that are still enqueued, and replies to
+     * the requests sent after it are only handled after the reply to it.
+     * The data and content type of the original request are sent again too.
+     *
+     * Only valid during handleReply() and handleError().
+     *
+     * @param request The request to send, usually a modified Job::currentRequest
+     * @since 6.1
+     */
+    void sendCurrentRequestAgain(const QNetworkRequest &request);
+
     /**
      * @brief Enqueues @p request in dispatcher queue
      *
@@ -361,6 +564,74 @@ protected:
      */
     virtual void enqueueRequest(const QNetworkRequest &request, const QByteArray &data = QByteArray(), const QString &contentType = QString());
 
+    /**
+     * @brief Dispatches enqueued requests right away
+     *
+     * Enqueued requests are normally dispatched once the control returns to
+     * the event loop. Subclasses that are about to do a lengthy processing
+     * can call this method to put the enqueued requests on the wire first.
+     *
+     * Requests that are throttled, or that don't fit into the
+     * Job::maxConcurrentRequests window, are still dispatched later.
+     *
+     * @since 6.1
+     */
+    void dispatchQueuedRequests();
+
+    /**
+     * @brief Marks the beginning of a deferred processing of a reply
+     *
+     * Subclasses that finish processing a reply asynchronously, after
+     * Job::handleReply has returned, call this method before returning from
+     * it. The job does not finish until Job::endDeferredParse is called for
+     * every call of this method, even when there are no requests left.
+     *
+     * @since 6.1
+     */
+    void beginDeferredParse();
+
+    /**
+     * @brief Marks the end of a deferred processing of a reply
+     *
+     * Finishes the job when there are no more requests to send and no more
+     * replies being processed.
+     *
+     * @see Job::beginDeferredParse
+     * @since 6.1
+     */
+    void endDeferredParse();
+
+    /**
+     * @brief Sets how long it took to parse the reply being handled
+     *
+     * Reported to RequestMetrics along with the timing of the request. Only
+     * valid during Job::handleReply, subclasses that parse the reply in
+     * Job::handleReply may call it to report the time spent by parsing.
+     *
+     * @param parseTime Time in microseconds, -1 when unknown
+     * @since 6.1
+     */
+    void setParseTime(qint64 parseTime);
+
+    /**
+     * @brief Sets URL of the batch endpoint of the API used by this job
+     *
+     * Subclasses that support sending their requests in batches should set
+     * the URL of the batch endpoint of their API. When batching is enabled
+     * by Job::setMaxBatchSize, the requests created by Job::dispatchRequest
+     * are packed into batch requests sent to @p batchUrl.
+     *
+     * @param batchUrl URL of the batch endpoint
+     */
+    void setBatchUrl(const QUrl &batchUrl);
+
+    /**
+     * @brief Returns URL of the batch endpoint
+     *
+     * @see Job::setBatchUrl
+     */
+    QUrl batchUrl() const;
+
 private:
     class Private;
     Private *const d;
@@ -10,37 +10,46 @@
 
 #include "job.h"
 
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QQueue>
 #include <QScopedPointer>
 #include <QTimer>
 
-class QFile;
-
 namespace KGAPI2
 {
 
+class BatchRequestRecorder;
+
 struct Request {
     QNetworkRequest request;
     QByteArray rawData;
     QString contentType;
+    // Whether the request is being sent again after it has been rejected as unauthorized
+    bool replayed = false;
+    // How many times the request has been sent again after a transient error
+    int retries = 0;
+    // Started when the request is queued, for RequestMetrics
+    QElapsedTimer queued;
+    // Position of the request in the order in which replies are handled, kept when it's sent again
+    quint64 id = 0;
 };
 
-class Q_DECL_HIDDEN FileLogger
-{
-public:
-    ~FileLogger();
-
-    static FileLogger *self();
-
-    void logRequest(const QNetworkRequest &request, const QByteArray &rawData);
-    void logReply(const QNetworkReply *reply, const QByteArray &rawData);
-
-private:
-    FileLogger();
-    QScopedPointer<QFile> mFile;
-
-    static FileLogger *sInstance;
+// Times in microseconds since the request was dispatched, collected for RequestMetrics
+struct RequestTimer {
+    QElapsedTimer clock;
+    qint64 queueWait = -1;
+    qint64 connectStarted = -1;
+    qint64 encrypted = -1;
+    qint64 requestSent = -1;
+    qint64 firstByte = -1;
+    qint64 finished = -1;
+    qint64 bytesSent = 0;
+    qint64 bytesReceived = 0;
+    int retries = 0;
 };
 
 class Q_DECL_HIDDEN Job::Private
@@ -49,8 +58,31 @@ public:
     Private(Job *parent);
     void init();
 
+    static QNetworkAccessManager *sharedAccessManager();
+    static void routeReply(QNetworkReply *reply);
+
     QString parseErrorMessage(const QByteArray &json);
 
+    QNetworkRequest authorizeRequest(const Request &r, quint64 id) const;
+    void dispatch(const Request &r);
+    bool canBatch() const;
+    void dispatchBatch();
+    void batchReplyReceived(QNetworkReply *reply, const QList<quint64> &ids);
+    void handleReply(QNetworkReply *reply);
+    void clearPendingRequests();
+    void waitForTokens();
+    void tokensRefreshed(Error refreshError, const QString &refreshErrorString);
+    bool replayUnauthorized(const QNetworkReply *reply);
+    bool needsTokens() const;
+    void throttle(const QNetworkReply *reply, const QByteArray &rawData);
+    bool retry(const QNetworkReply *reply, int replyCode);
+    void sendAgain(const Request &r);
+    void sendAgainLater(const Request &r, qint64 delay);
+    QString rateLimitKey() const;
+    void trackReply(QHash<quint64, RequestTimer> &timers, quint64 id, QNetworkReply *reply);
+    void recordTiming(const RequestTimer &timer, const QNetworkReply *reply, qint64 parse);
+    void finishIfIdle();
+
     void _k_doStart();
     void _k_doEmitFinished();
     void _k_replyReceived(QNetworkReply *reply);
@@ -65,12 +97,50 @@ public:
     QNetworkAccessManager *accessManager;
     QQueue<Request> requestQueue;
     QTimer *dispatchTimer;
+    // Dispatching is paused while the account is throttled by RateLimiter
+    QTimer *throttleTimer;
     int maxTimeout;
+    int maxConcurrentRequests;
     bool prettyPrint;
     QStringList fields;
 
+    int maxRetries;
+    int retryDelay;
+    int requestCompressionThreshold;
+
+    int maxBatchSize;
+    QUrl batchUrl;
+    BatchRequestRecorder *batchRecorder;
+    // Whether the requests created by dispatchRequest() are being packed into a batch
+    bool recordingBatch;
+
+    quint64 nextRequestId;
+    quint64 nextReplyId;
+    quint64 nextBatchId;
+    QHash<quint64, Request> inFlightRequests;
+    QHash<quint64, QList<quint64>> inFlightBatches;
+    QHash<QString, int> inFlightPerHost;
+    QHash<quint64, QNetworkReply *> completedReplies;
+    // Replies of the requests that are still on the wire, aborted when the job finishes or is destroyed
+    QList<QPointer<QNetworkReply>> liveReplies;
+
     Request currentRequest;
 
+    // Requests and batches measured for RequestMetrics
+    QHash<quint64, RequestTimer> requestTimers;
+    QHash<quint64, RequestTimer> batchTimers;
+    // Set by FetchJob while handling the current reply
+    qint64 parseTime;
+    // Replies being parsed by FetchJob in the thread pool, the job can't finish until they are done
+    int pendingParses;
+
+    // Dispatching is paused while tokens of the account are being refreshed
+    bool waitingForTokens;
+    int replayedRequests;
+    // Expiration of the token received by the last refresh, so that it isn't refreshed again
+    QDateTime refreshedExpiration;
+    QMetaObject::Connection tokensConnection;
+
 private:
     Job *const q;
 };
@@ -12,6 +12,7 @@
 
 #include <QBuffer>
 #include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include <QNetworkRequest>
 
 using namespace KGAPI2;
@@ -20,7 +21,6 @@ class Q_DECL_HIDDEN ModifyJob::Private
 {
 public:
     ObjectsList items;
-    QBuffer buffer;
 };
 
 ModifyJob::ModifyJob(QObject *parent)
@@ -61,12 +61,15 @@ void ModifyJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNet
     // Using sendCustomRequest() works just fine.
     // accessManager->put(r, data);
     if (!data.isEmpty()) {
-        r.setHeader(QNetworkRequest::ContentLengthHeader, data.size());
-
-        d->buffer.close();
-        d->buffer.setData(data);
-        d->buffer.open(QIODevice::ReadOnly);
-        accessManager->sendCustomRequest(r, "PUT", &d->buffer);
+        const QByteArray body = compressRequestBody(r, data);
+        r.setHeader(QNetworkRequest::ContentLengthHeader, body.size());
+
+        // Every request needs its own buffer, multiple requests can be in flight at once
+        auto buffer = new QBuffer;
+        buffer->setData(body);
+        buffer->open(QIODevice::ReadOnly);
+        QNetworkReply *reply = accessManager->sendCustomRequest(r, "PUT", buffer);
+        buffer->setParent(reply);
     } else {
         accessManager->sendCustomRequest(r, "PUT");
     }
@@ -74,7 +77,6 @@ void ModifyJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNet
 
 void ModifyJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
-    d->buffer.close();
     d->items << handleReplyWithItems(reply, rawData);
 }
 
@@ -10,6 +10,7 @@
 #include "networkaccessmanagerfactory_p.h"
 
 #include <QNetworkAccessManager>
+#include <QThread>
 
 using namespace KGAPI2;
 
@@ -27,6 +28,16 @@ public:
     }
 };
 
+NetworkAccessManagerFactory::~NetworkAccessManagerFactory()
+{
+    // The managers may live in other threads, so let their own event loops delete them
+    for (const auto &nam : std::as_const(mSharedManagers)) {
+        if (nam) {
+            nam->deleteLater();
+        }
+    }
+}
+
 void NetworkAccessManagerFactory::setFactory(NetworkAccessManagerFactory *factory)
 {
     sInstance.reset(factory);
@@ -39,3 +50,18 @@ NetworkAccessManagerFactory *NetworkAccessManagerFactory::instance()
     }
     return sInstance.get();
 }
+
+QNetworkAccessManager *NetworkAccessManagerFactory::sharedNetworkAccessManager()
+{
+    QThread *thread = QThread::currentThread();
+
+    QMutexLocker locker(&mSharedManagersLock);
+    QPointer<QNetworkAccessManager> &nam = mSharedManagers[thread];
+    if (!nam) {
+        qCDebug(KGAPIDebug) << "Creating shared QNetworkAccessManager for thread" << thread;
+        nam = networkAccessManager(nullptr);
+        QObject::connect(thread, &QThread::finished, nam, &QObject::deleteLater);
+    }
+
+    return nam;
+}
@@ -10,9 +10,14 @@
 
 class QNetworkAccessManager;
 class QObject;
+class QThread;
 
 #include "kgapicore_export.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QPointer>
+
 #include <memory>
 
 namespace KGAPI2
@@ -22,17 +27,35 @@ namespace KGAPI2
 class KGAPICORE_EXPORT NetworkAccessManagerFactory
 {
 public:
-    virtual ~NetworkAccessManagerFactory() = default;
+    virtual ~NetworkAccessManagerFactory();
 
     static NetworkAccessManagerFactory *instance();
     static void setFactory(NetworkAccessManagerFactory *factory);
 
     virtual QNetworkAccessManager *networkAccessManager(QObject *parent = nullptr) const = 0;
 
+    /**
+     * Returns a QNetworkAccessManager shared by all jobs living in the calling thread.
+     *
+     * Sharing the manager allows jobs to reuse keep-alive connections, TLS sessions
+     * and HTTP/2 connections instead of establishing new ones for every job. The
+     * manager is created on first use by networkAccessManager() and is destroyed
+     * when the thread finishes or when the factory is replaced.
+     *
+     * Replies of the shared manager must be routed to their sender by the caller,
+     * the manager-wide QNetworkAccessManager::finished signal is emitted for replies
+     * of all jobs.
+     */
+    QNetworkAccessManager *sharedNetworkAccessManager();
+
 protected:
     static std::unique_ptr<NetworkAccessManagerFactory> sInstance;
 
     explicit NetworkAccessManagerFactory() = default;
+
+private:
+    QMutex mSharedManagersLock;
+    QHash<QThread *, QPointer<QNetworkAccessManager>> mSharedManagers;
 };
 
 }
@@ -0,0 +1,273 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "batchrequest_p.h"
+#include "debug.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace KGAPI2;
+
+namespace
+{
+
+QByteArray operationVerb(QNetworkAccessManager::Operation op, const QNetworkRequest &request)
+{
+    switch (op) {
+    case QNetworkAccessManager::HeadOperation:
+        return QByteArrayLiteral("HEAD");
+    case QNetworkAccessManager::GetOperation:
+        return QByteArrayLiteral("GET");
+    case QNetworkAccessManager::PutOperation:
+        return QByteArrayLiteral("PUT");
+    case QNetworkAccessManager::PostOperation:
+        return QByteArrayLiteral("POST");
+    case QNetworkAccessManager::DeleteOperation:
+        return QByteArrayLiteral("DELETE");
+    case QNetworkAccessManager::CustomOperation:
+        return request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+    case QNetworkAccessManager::UnknownOperation:
+        break;
+    }
+
+    return QByteArray();
+}
+
+/**
+ * Parses header lines of a MIME part or of an HTTP message from @p data,
+ * starting at @p pos. Returns position of the first byte after the empty
+ * line that terminates the headers.
+ */
+qsizetype parseHeaders(const QByteArray &data, qsizetype pos, BatchRequest::RawHeaders &headers, QByteArray *firstLine = nullptr)
+{
+    bool first = firstLine != nullptr;
+    while (pos < data.size()) {
+        qsizetype end = data.indexOf('\n', pos);
+        if (end < 0) {
+            end = data.size();
+        }
+        QByteArray line = data.mid(pos, end - pos);
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        pos = end + 1;
+
+        if (first) {
+            // Skip any empty lines in front of the status line
+            if (!line.isEmpty()) {
+                *firstLine = line;
+                first = false;
+            }
+            continue;
+        }
+        if (line.isEmpty()) {
+            break;
+        }
+
+        const qsizetype colon = line.indexOf(':');
+        if (colon > 0) {
+            headers.append({line.left(colon).trimmed(), line.mid(colon + 1).trimmed()});
+        }
+    }
+
+    return qMin(pos, data.size());
+}
+
+QByteArray headerValue(const BatchRequest::RawHeaders &headers, const QByteArray &name)
+{
+    for (const auto &header : headers) {
+        if (header.first.compare(name, Qt::CaseInsensitive) == 0) {
+            return header.second;
+        }
+    }
+    return QByteArray();
+}
+
+}
+
+QByteArray BatchRequest::serialize(const QList<Part> &parts, QByteArray &boundary)
+{
+    // The boundary must not appear anywhere in the parts
+    boundary = QByteArrayLiteral("batch_kgapi");
+    for (int attempt = 1;; ++attempt) {
+        const bool collides = std::any_of(parts.cbegin(), parts.cend(), [&boundary](const Part &part) {
+            return part.body.contains(boundary);
+        });
+        if (!collides) {
+            break;
+        }
+        boundary = QByteArrayLiteral("batch_kgapi_") + QByteArray::number(attempt);
+    }
+
+    QByteArray data;
+    for (const auto &part : parts) {
+        data += "--" + boundary + "\r\n";
+        data += "Content-Type: application/http\r\n";
+        data += "Content-ID: <" + part.contentId + ">\r\n\r\n";
+
+        const QUrl url = part.request.url();
+        data += part.verb + ' ' + url.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemoveFragment) + " HTTP/1.1\r\n";
+        const auto headers = part.request.rawHeaderList();
+        for (const auto &header : headers) {
+            if (header.compare("Content-Length", Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+            data += header + ": " + part.request.rawHeader(header) + "\r\n";
+        }
+        if (!part.body.isEmpty()) {
+            data += "Content-Length: " + QByteArray::number(part.body.size()) + "\r\n";
+        }
+        data += "\r\n";
+        data += part.body;
+        data += "\r\n";
+    }
+    data += "--" + boundary + "--\r\n";
+
+    return data;
+}
+
+QList<BatchRequest::Response> BatchRequest::parse(const QByteArray &contentType, const QByteArray &data)
+{
+    QList<Response> responses;
+
+    QByteArray boundary;
+    const auto params = contentType.split(';');
+    for (const auto &param : params) {
+        const QByteArray trimmed = param.trimmed();
+        if (trimmed.startsWith("boundary=")) {
+            boundary = trimmed.mid(9);
+            if (boundary.startsWith('"') && boundary.endsWith('"') && boundary.size() > 1) {
+                boundary = boundary.mid(1, boundary.size() - 2);
+            }
+        }
+    }
+    if (boundary.isEmpty()) {
+        qCWarning(KGAPIDebug) << "Batch reply has no multipart boundary:" << contentType;
+        return responses;
+    }
+
+    const QByteArray delimiter = "--" + boundary;
+    qsizetype pos = data.indexOf(delimiter);
+    while (pos >= 0) {
+        pos += delimiter.size();
+        if (data.mid(pos, 2) == "--") {
+            // Closing delimiter
+            break;
+        }
+
+        qsizetype end = data.indexOf(delimiter, pos);
+        if (end < 0) {
+            end = data.size();
+        }
+        // The line break in front of the delimiter belongs to the delimiter
+        QByteArray partData = data.mid(pos, end - pos);
+        if (partData.endsWith("\r\n")) {
+            partData.chop(2);
+        } else if (partData.endsWith('\n')) {
+            partData.chop(1);
+        }
+        // Skip the line break that follows the delimiter
+        qsizetype partPos = partData.startsWith("\r\n") ? 2 : partData.startsWith('\n') ? 1 : 0;
+
+        RawHeaders partHeaders;
+        partPos = parseHeaders(partData, partPos, partHeaders);
+
+        Response response;
+        response.contentId = headerValue(partHeaders, "Content-ID");
+        if (response.contentId.startsWith('<') && response.contentId.endsWith('>')) {
+            response.contentId = response.contentId.mid(1, response.contentId.size() - 2);
+        }
+        if (response.contentId.startsWith("response-")) {
+            response.contentId = response.contentId.mid(9);
+        }
+
+        QByteArray statusLine;
+        partPos = parseHeaders(partData, partPos, response.headers, &statusLine);
+        // "HTTP/1.1 200 OK"
+        const auto statusParts = statusLine.split(' ');
+        if (statusParts.size() >= 2) {
+            response.statusCode = statusParts.at(1).toInt();
+        }
+        response.body = partData.mid(partPos);
+
+        responses.append(response);
+        pos = end < data.size() ? end : -1;
+    }
+
+    return responses;
+}
+
+BatchRequestRecorder::BatchRequestRecorder(QObject *parent)
+    : QNetworkAccessManager(parent)
+{
+}
+
+QList<BatchRequest::Part> BatchRequestRecorder::takeParts()
+{
+    return std::exchange(mParts, {});
+}
+
+QNetworkReply *BatchRequestRecorder::createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+    BatchRequest::Part part;
+    part.verb = operationVerb(op, request);
+    part.request = request;
+    if (outgoingData) {
+        part.body = outgoingData->readAll();
+    }
+    mParts.append(part);
+
+    // The reply is never finished, the response is delivered through a BatchPartReply
+    // created from the batch reply.
+    auto reply = new BatchPartReply(request, this);
+    reply->deleteLater();
+    return reply;
+}
+
+BatchPartReply::BatchPartReply(const QNetworkRequest &request, QObject *parent)
+    : QNetworkReply(parent)
+{
+    setRequest(request);
+    setUrl(request.url());
+}
+
+void BatchPartReply::setResponse(int statusCode, const BatchRequest::RawHeaders &headers, const QByteArray &body)
+{
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, statusCode);
+    for (const auto &header : headers) {
+        setRawHeader(header.first, header.second);
+    }
+
+    mBuffer.setData(body);
+    mBuffer.open(QIODevice::ReadOnly);
+    open(QIODevice::ReadOnly);
+    setFinished(true);
+}
+
+void BatchPartReply::abort()
+{
+    // NOOP
+}
+
+qint64 BatchPartReply::bytesAvailable() const
+{
+    return mBuffer.bytesAvailable() + QNetworkReply::bytesAvailable();
+}
+
+bool BatchPartReply::isSequential() const
+{
+    return true;
+}
+
+qint64 BatchPartReply::readData(char *data, qint64 maxLen)
+{
+    return mBuffer.read(data, maxLen);
+}
+
+#include "moc_batchrequest_p.cpp"
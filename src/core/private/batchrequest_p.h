@@ -0,0 +1,111 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPair>
+
+namespace KGAPI2
+{
+
+namespace BatchRequest
+{
+
+using RawHeaders = QList<QPair<QByteArray, QByteArray>>;
+
+/**
+ * A single request packed into a batch request
+ */
+struct Part {
+    QByteArray contentId;
+    QByteArray verb;
+    QNetworkRequest request;
+    QByteArray body;
+};
+
+/**
+ * A single response unpacked from a batch reply
+ */
+struct Response {
+    QByteArray contentId;
+    int statusCode = 0;
+    RawHeaders headers;
+    QByteArray body;
+};
+
+/**
+ * Serializes @p parts into a multipart/mixed body of a batch request.
+ *
+ * @param boundary Is set to the boundary used to separate the parts, it
+ *        must be sent in the Content-Type header of the batch request.
+ */
+QByteArray serialize(const QList<Part> &parts, QByteArray &boundary);
+
+/**
+ * Parses multipart/mixed body of a batch reply with given @p contentType.
+ *
+ * The returned responses have their Content-ID stripped of angle brackets
+ * and of the "response-" prefix that Google adds, so that they match the
+ * Content-ID of the respective Part.
+ */
+QList<Response> parse(const QByteArray &contentType, const QByteArray &data);
+
+}
+
+/**
+ * A QNetworkAccessManager that does not send any requests, but only records
+ * them, so that requests created by Job::dispatchRequest() implementations
+ * can be packed into a single batch request.
+ */
+class Q_DECL_HIDDEN BatchRequestRecorder : public QNetworkAccessManager
+{
+    Q_OBJECT
+public:
+    explicit BatchRequestRecorder(QObject *parent = nullptr);
+
+    /**
+     * Returns all requests recorded since last call
+     */
+    QList<BatchRequest::Part> takeParts();
+
+protected:
+    QNetworkReply *createRequest(Operation op, const QNetworkRequest &request, QIODevice *outgoingData) override;
+
+private:
+    QList<BatchRequest::Part> mParts;
+};
+
+/**
+ * A finished reply to a single request from a batch request
+ */
+class Q_DECL_HIDDEN BatchPartReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    explicit BatchPartReply(const QNetworkRequest &request, QObject *parent = nullptr);
+
+    void setResponse(int statusCode, const BatchRequest::RawHeaders &headers, const QByteArray &body);
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override;
+
+protected:
+    qint64 readData(char *data, qint64 maxLen) override;
+
+private:
+    QBuffer mBuffer;
+};
+
+}
@@ -0,0 +1,365 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filelogger_p.h"
+#include "debug.h"
+
+#include <QAtomicInteger>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRegularExpression>
+#include <QStringDecoder>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <functional>
+#include <utility>
+
+using namespace KGAPI2;
+
+namespace
+{
+static const qsizetype DefaultMaxBodySize = 64 * 1024;
+static const qint64 DefaultMaxFileSize = 32 * 1024 * 1024;
+static const int RotatedFiles = 3;
+// How many records can wait for the writer before new ones are dropped
+static const qsizetype BufferCapacity = 4096;
+
+qint64 envNumber(const char *name, qint64 defaultValue)
+{
+    bool ok = false;
+    const qint64 value = qEnvironmentVariable(name).toLongLong(&ok);
+    return ok ? value : defaultValue;
+}
+
+QByteArray redactHeader(const QByteArray &name, const QByteArray &value)
+{
+    const QByteArray lower = name.toLower();
+    if (lower == "authorization") {
+        // Keep the scheme, it's useful when debugging
+        const qsizetype space = value.indexOf(' ');
+        return (space > 0 ? value.left(space + 1) : QByteArray()) + "<redacted>";
+    }
+    if (lower == "cookie" || lower == "set-cookie") {
+        return "<redacted>";
+    }
+    return value;
+}
+
+QString redactBody(QString text)
+{
+    // JSON members and form fields of token requests and replies, the value may have been cut off by truncation
+    static const QRegularExpression jsonSecret(QStringLiteral(R"(("(?:access_token|refresh_token|id_token|client_secret)"\s*:\s*")[^"]*("|$))"));
+    static const QRegularExpression formSecret(QStringLiteral(R"(((?:^|&)(?:access_token|refresh_token|client_secret|code)=)[^&]*)"));
+
+    if (!text.contains(QLatin1StringView("token")) && !text.contains(QLatin1StringView("secret")) && !text.contains(QLatin1StringView("code="))) {
+        return text;
+    }
+
+    text.replace(jsonSecret, QStringLiteral("\\1<redacted>\\2"));
+    text.replace(formSecret, QStringLiteral("\\1<redacted>"));
+    return text;
+}
+
+QJsonObject headersObject(const QList<QByteArray> &names, const std::function<QByteArray(const QByteArray &)> &value)
+{
+    QJsonObject headers;
+    for (const auto &name : names) {
+        headers.insert(QString::fromLatin1(name), QString::fromLatin1(redactHeader(name, value(name))));
+    }
+    return headers;
+}
+}
+
+class Q_DECL_HIDDEN FileLogger::Private
+{
+public:
+    void addBody(QJsonObject &record, const QByteArray &rawData) const;
+    void enqueue(const QJsonObject &record);
+
+    void run();
+    void write(const QByteArray &data);
+    void rotate();
+    void stop();
+
+    QString fileName;
+    QScopedPointer<QFile> file;
+    qsizetype maxBodySize = DefaultMaxBodySize;
+    qint64 maxFileSize = DefaultMaxFileSize;
+    QThread *writer = nullptr;
+    QAtomicInteger<quint64> nextId = 1;
+
+    QMutex lock;
+    QWaitCondition recordsAvailable;
+    QWaitCondition recordsWritten;
+    // Ring buffer of serialized records
+    QList<QByteArray> buffer;
+    qsizetype head = 0;
+    qsizetype count = 0;
+    qint64 dropped = 0;
+    bool writing = false;
+    bool stopping = false;
+};
+
+void FileLogger::Private::addBody(QJsonObject &record, const QByteArray &rawData) const
+{
+    record.insert(QStringLiteral("size"), rawData.size());
+    if (rawData.isEmpty()) {
+        return;
+    }
+
+    // Only the logged part of the body is processed, so that large bodies don't slow down the caller
+    QByteArray body = rawData;
+    if (maxBodySize >= 0 && body.size() > maxBodySize) {
+        body.truncate(maxBodySize);
+        // Don't cut a multibyte UTF-8 sequence in half
+        qsizetype end = body.size();
+        while (end > 0 && (uchar(body.at(end - 1)) & 0xC0) == 0x80) {
+            --end;
+        }
+        if (end > 0 && uchar(body.at(end - 1)) >= 0xC0) {
+            body.truncate(end - 1);
+        }
+        record.insert(QStringLiteral("truncated"), true);
+    }
+
+    QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+    const QString text = decoder.decode(body);
+    if (decoder.hasError()) {
+        record.insert(QStringLiteral("bodyBase64"), QString::fromLatin1(body.toBase64()));
+    } else {
+        record.insert(QStringLiteral("body"), redactBody(text));
+    }
+}
+
+void FileLogger::Private::enqueue(const QJsonObject &record)
+{
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact);
+    line += '\n';
+
+    QMutexLocker locker(&lock);
+    if (count == buffer.size()) {
+        ++dropped;
+        return;
+    }
+    buffer[(head + count) % buffer.size()] = std::move(line);
+    ++count;
+    recordsAvailable.wakeOne();
+}
+
+void FileLogger::Private::run()
+{
+    QList<QByteArray> records;
+    qint64 droppedRecords = 0;
+    forever {
+        {
+            QMutexLocker locker(&lock);
+            writing = false;
+            while (count == 0 && !stopping) {
+                recordsWritten.wakeAll();
+                recordsAvailable.wait(&lock);
+            }
+            if (count == 0) {
+                recordsWritten.wakeAll();
+                return;
+            }
+
+            records.reserve(count);
+            for (; count > 0; --count) {
+                records.append(std::move(buffer[head]));
+                buffer[head] = QByteArray();
+                head = (head + 1) % buffer.size();
+            }
+            droppedRecords = std::exchange(dropped, 0);
+            writing = true;
+        }
+
+        if (droppedRecords > 0) {
+            write(QJsonDocument(QJsonObject{{QStringLiteral("type"), QStringLiteral("dropped")}, {QStringLiteral("count"), droppedRecords}})
+                      .toJson(QJsonDocument::Compact)
+                  + '\n');
+        }
+        for (const auto &record : std::as_const(records)) {
+            write(record);
+        }
+        records.clear();
+        file->flush();
+    }
+}
+
+void FileLogger::Private::write(const QByteArray &data)
+{
+    if (maxFileSize > 0 && file->size() > 0 && file->size() + data.size() > maxFileSize) {
+        rotate();
+    }
+    file->write(data);
+}
+
+void FileLogger::Private::rotate()
+{
+    file->close();
+    QFile::remove(fileName + QLatin1Char('.') + QString::number(RotatedFiles));
+    for (int i = RotatedFiles - 1; i > 0; --i) {
+        QFile::rename(fileName + QLatin1Char('.') + QString::number(i), fileName + QLatin1Char('.') + QString::number(i + 1));
+    }
+    QFile::rename(fileName, fileName + QStringLiteral(".1"));
+
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(KGAPIDebug) << "Failed to open logging file" << fileName << ":" << file->errorString();
+    }
+}
+
+void FileLogger::Private::stop()
+{
+    {
+        QMutexLocker locker(&lock);
+        stopping = true;
+        recordsAvailable.wakeOne();
+    }
+    writer->wait();
+}
+
+FileLogger *FileLogger::sInstance = nullptr;
+
+FileLogger::FileLogger()
+    : d(new Private)
+{
+    if (!qEnvironmentVariableIsSet("KGAPI_SESSION_LOGFILE")) {
+        return;
+    }
+
+    d->fileName = qEnvironmentVariable("KGAPI_SESSION_LOGFILE") + QLatin1Char('.') + QString::number(QCoreApplication::applicationPid());
+    d->file.reset(new QFile(d->fileName));
+    if (!d->file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(KGAPIDebug) << "Failed to open logging file" << d->fileName << ":" << d->file->errorString();
+        d->file.reset();
+        return;
+    }
+
+    d->maxBodySize = envNumber("KGAPI_SESSION_LOG_MAX_BODY", DefaultMaxBodySize);
+    d->maxFileSize = envNumber("KGAPI_SESSION_LOG_MAX_SIZE", DefaultMaxFileSize);
+    d->buffer.resize(BufferCapacity);
+
+    d->writer = QThread::create([this]() {
+        d->run();
+    });
+    d->writer->start(QThread::LowPriority);
+
+    // Write out whatever is left before the application exits
+    qAddPostRoutine([]() {
+        if (sInstance && sInstance->isEnabled()) {
+            sInstance->d->stop();
+        }
+    });
+}
+
+FileLogger::~FileLogger()
+{
+    if (d->writer) {
+        d->stop();
+        delete d->writer;
+    }
+}
+
+FileLogger *FileLogger::self()
+{
+    if (!sInstance) {
+        sInstance = new FileLogger();
+    }
+    return sInstance;
+}
+
+bool FileLogger::isEnabled() const
+{
+    return d->writer != nullptr;
+}
+
+quint64 FileLogger::logRequest(const QNetworkRequest &request, const QByteArray &rawData)
+{
+    if (!d->writer) {
+        return 0;
+    }
+
+    const quint64 id = d->nextId.fetchAndAddRelaxed(1);
+    QJsonObject record{
+        {QStringLiteral("time"), QDateTime::currentMSecsSinceEpoch()},
+        {QStringLiteral("type"), QStringLiteral("request")},
+        {QStringLiteral("id"), qint64(id)},
+        {QStringLiteral("url"), request.url().toString(QUrl::FullyEncoded)},
+        {QStringLiteral("headers"), headersObject(request.rawHeaderList(), [&request](const QByteArray &name) {
+             return request.rawHeader(name);
+         })},
+    };
+    d->addBody(record, rawData);
+    d->enqueue(record);
+    return id;
+}
+
+void FileLogger::logReply(const QNetworkReply *reply, const QByteArray &rawData, quint64 requestId)
+{
+    if (!d->writer) {
+        return;
+    }
+
+    QByteArray method;
+    switch (reply->operation()) {
+    case QNetworkAccessManager::HeadOperation:
+        method = "HEAD";
+        break;
+    case QNetworkAccessManager::GetOperation:
+        method = "GET";
+        break;
+    case QNetworkAccessManager::PutOperation:
+        method = "PUT";
+        break;
+    case QNetworkAccessManager::PostOperation:
+        method = "POST";
+        break;
+    case QNetworkAccessManager::DeleteOperation:
+        method = "DELETE";
+        break;
+    default:
+        method = reply->request().attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+        break;
+    }
+
+    QJsonObject record{
+        {QStringLiteral("time"), QDateTime::currentMSecsSinceEpoch()},
+        {QStringLiteral("type"), QStringLiteral("reply")},
+        {QStringLiteral("id"), qint64(requestId)},
+        {QStringLiteral("url"), reply->url().toString(QUrl::FullyEncoded)},
+        {QStringLiteral("method"), QString::fromLatin1(method)},
+        {QStringLiteral("status"), reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()},
+        {QStringLiteral("headers"), headersObject(reply->rawHeaderList(), [reply](const QByteArray &name) {
+             return reply->rawHeader(name);
+         })},
+    };
+    if (reply->error() != QNetworkReply::NoError) {
+        record.insert(QStringLiteral("error"), reply->errorString());
+    }
+    d->addBody(record, rawData);
+    d->enqueue(record);
+}
+
+void FileLogger::flush()
+{
+    if (!d->writer) {
+        return;
+    }
+
+    QMutexLocker locker(&d->lock);
+    while ((d->count > 0 || d->writing) && !d->writer->isFinished()) {
+        d->recordsWritten.wait(&d->lock);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QScopedPointer>
+
+#include "kgapicore_export.h"
+
+class QNetworkReply;
+class QNetworkRequest;
+
+namespace KGAPI2
+{
+
+/**
+ * Logs all requests and replies into the file set in the KGAPI_SESSION_LOGFILE
+ * environment variable, suffixed with the PID of the process.
+ *
+ * Every request and reply is written as a single line of JSON (NDJSON):
+ *
+ * {"time":..., "type":"request", "id":..., "url":..., "headers":{...}, "size":..., "body":...}
+ * {"time":..., "type":"reply", "id":..., "url":..., "method":..., "status":..., "headers":{...}, "size":..., "body":...}
+ *
+ * "id" matches replies to requests, "size" is the full size of the body. Bodies
+ * longer than KGAPI_SESSION_LOG_MAX_BODY bytes (64 KiB by default, -1 for no limit)
+ * are truncated and marked with "truncated":true, bodies that are not valid UTF-8
+ * are stored in "bodyBase64" instead. Tokens and client secrets are redacted.
+ *
+ * The records are only serialized by the calling thread and queued in a bounded
+ * buffer, the file is written by a background thread. When the writer falls
+ * behind and the buffer is full, new records are dropped and their count is
+ * logged as {"type":"dropped","count":...}. Once the file grows over
+ * KGAPI_SESSION_LOG_MAX_SIZE bytes (32 MiB by default), it's rotated and up to
+ * three older files are kept with ".1" to ".3" suffix.
+ */
+class KGAPICORE_EXPORT FileLogger
+{
+public:
+    ~FileLogger();
+
+    static FileLogger *self();
+
+    bool isEnabled() const;
+
+    /**
+     * Logs the request and returns its ID, which should be passed to logReply()
+     * with the reply to the request
+     */
+    quint64 logRequest(const QNetworkRequest &request, const QByteArray &rawData);
+    void logReply(const QNetworkReply *reply, const QByteArray &rawData, quint64 requestId);
+
+    /**
+     * Blocks until all queued records have been written
+     */
+    void flush();
+
+private:
+    FileLogger();
+    Q_DISABLE_COPY(FileLogger)
+
+    class Private;
+    QScopedPointer<Private> const d;
+
+    static FileLogger *sInstance;
+};
+
+}
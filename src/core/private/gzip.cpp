@@ -0,0 +1,85 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "gzip_p.h"
+#include "debug.h"
+
+#include <zlib.h>
+
+using namespace KGAPI2;
+
+namespace
+{
+// Adding 16 to the window bits selects the gzip format, adding 32 detects gzip or zlib automatically
+static const int GzipWindowBits = MAX_WBITS + 16;
+static const int AutoDetectWindowBits = MAX_WBITS + 32;
+
+static const int ChunkSize = 64 * 1024;
+}
+
+QByteArray Gzip::compress(const QByteArray &data)
+{
+    z_stream stream = {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        qCWarning(KGAPIDebug) << "Failed to initialize gzip compression";
+        return QByteArray();
+    }
+
+    QByteArray result(deflateBound(&stream, data.size()), Qt::Uninitialized);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef *>(result.data());
+    stream.avail_out = result.size();
+
+    // The output buffer is large enough to compress everything at once
+    const int ret = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (ret != Z_STREAM_END) {
+        qCWarning(KGAPIDebug) << "Failed to compress data:" << ret;
+        return QByteArray();
+    }
+
+    result.truncate(stream.total_out);
+    return result;
+}
+
+QByteArray Gzip::decompress(const QByteArray &data)
+{
+    z_stream stream = {};
+    if (inflateInit2(&stream, AutoDetectWindowBits) != Z_OK) {
+        qCWarning(KGAPIDebug) << "Failed to initialize gzip decompression";
+        return QByteArray();
+    }
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    stream.avail_in = data.size();
+
+    QByteArray result;
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        // JSON usually compresses several times, so start with a buffer larger than the input
+        const qsizetype offset = result.size();
+        result.resize(offset + qMax<qsizetype>(ChunkSize, data.size() * 4));
+        stream.next_out = reinterpret_cast<Bytef *>(result.data() + offset);
+        stream.avail_out = result.size() - offset;
+
+        ret = inflate(&stream, Z_NO_FLUSH);
+        result.truncate(stream.total_out);
+        if (ret == Z_BUF_ERROR && stream.avail_in > 0) {
+            ret = Z_OK;
+        }
+    }
+    inflateEnd(&stream);
+
+    if (ret != Z_STREAM_END) {
+        qCWarning(KGAPIDebug) << "Failed to decompress data:" << ret;
+        return QByteArray();
+    }
+
+    return result;
+}
@@ -0,0 +1,38 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include "kgapicore_export.h"
+
+namespace KGAPI2
+{
+
+namespace Gzip
+{
+
+/**
+ * Compresses @p data into the gzip format (RFC 1952).
+ *
+ * @return Compressed data, or a null array on failure.
+ */
+KGAPICORE_EXPORT QByteArray compress(const QByteArray &data);
+
+/**
+ * Decompresses @p data in the gzip or zlib format, as sent by servers
+ * in replies with "gzip" or "deflate" Content-Encoding.
+ *
+ * @return Decompressed data, or a null array when @p data is corrupted.
+ */
+KGAPICORE_EXPORT QByteArray decompress(const QByteArray &data);
+
+}
+
+}
@@ -0,0 +1,623 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "jsonreader_p.h"
+
+#include <QVariantList>
+#include <QVariantMap>
+
+using namespace KGAPI2;
+
+namespace
+{
+
+// Same limit as QJsonDocument uses
+constexpr int MaxDepth = 1024;
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+int readHex4(QByteArrayView data, qsizetype pos)
+{
+    if (pos + 4 > data.size()) {
+        return -1;
+    }
+    int value = 0;
+    for (qsizetype i = pos; i < pos + 4; ++i) {
+        const int digit = hexValue(data.at(i));
+        if (digit < 0) {
+            return -1;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+void appendUtf8(QByteArray &out, char32_t ucs)
+{
+    if (ucs < 0x80) {
+        out += static_cast<char>(ucs);
+    } else if (ucs < 0x800) {
+        out += static_cast<char>(0xc0 | (ucs >> 6));
+        out += static_cast<char>(0x80 | (ucs & 0x3f));
+    } else if (ucs < 0x10000) {
+        out += static_cast<char>(0xe0 | (ucs >> 12));
+        out += static_cast<char>(0x80 | ((ucs >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (ucs & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (ucs >> 18));
+        out += static_cast<char>(0x80 | ((ucs >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((ucs >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (ucs & 0x3f));
+    }
+}
+
+bool isIntegerLiteral(QByteArrayView literal)
+{
+    return !literal.contains('.') && !literal.contains('e') && !literal.contains('E');
+}
+
+}
+
+JsonReader::JsonReader(QByteArrayView data)
+    : mData(data)
+{
+}
+
+bool JsonReader::hasError() const
+{
+    return !mError.isEmpty();
+}
+
+QString JsonReader::errorString() const
+{
+    return mError;
+}
+
+void JsonReader::setError(const char *error)
+{
+    if (mError.isEmpty()) {
+        mError = QStringLiteral("%1 at offset %2").arg(QLatin1StringView(error)).arg(mPos);
+    }
+}
+
+void JsonReader::skipWhitespace()
+{
+    while (mPos < mData.size()) {
+        const char c = mData.at(mPos);
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            break;
+        }
+        ++mPos;
+    }
+}
+
+JsonReader::Type JsonReader::peek()
+{
+    if (hasError()) {
+        return Type::Invalid;
+    }
+
+    skipWhitespace();
+    if (mPos >= mData.size()) {
+        return Type::End;
+    }
+
+    switch (mData.at(mPos)) {
+    case '{':
+        return Type::Object;
+    case '[':
+        return Type::Array;
+    case '"':
+        return Type::String;
+    case 't':
+    case 'f':
+        return Type::Bool;
+    case 'n':
+        return Type::Null;
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return Type::Number;
+    case '}':
+    case ']':
+        return Type::End;
+    default:
+        return Type::Invalid;
+    }
+}
+
+bool JsonReader::beginObject()
+{
+    const Type type = peek();
+    if (type == Type::Object) {
+        ++mPos;
+        mAfterValue = false;
+        return true;
+    }
+
+    skipValue();
+    return false;
+}
+
+bool JsonReader::endObject()
+{
+    while (hasNext()) {
+        nextName();
+        skipValue();
+    }
+    if (hasError()) {
+        return false;
+    }
+
+    if (mData.at(mPos) != '}') {
+        setError("Expected end of object");
+        return false;
+    }
+    ++mPos;
+    mAfterValue = true;
+    return true;
+}
+
+bool JsonReader::beginArray()
+{
+    const Type type = peek();
+    if (type == Type::Array) {
+        ++mPos;
+        mAfterValue = false;
+        return true;
+    }
+
+    skipValue();
+    return false;
+}
+
+bool JsonReader::endArray()
+{
+    while (hasNext()) {
+        skipValue();
+    }
+    if (hasError()) {
+        return false;
+    }
+
+    if (mData.at(mPos) != ']') {
+        setError("Expected end of array");
+        return false;
+    }
+    ++mPos;
+    mAfterValue = true;
+    return true;
+}
+
+bool JsonReader::hasNext()
+{
+    if (hasError()) {
+        return false;
+    }
+
+    skipWhitespace();
+    if (mPos >= mData.size()) {
+        setError("Unexpected end of data");
+        return false;
+    }
+
+    char c = mData.at(mPos);
+    if (c == '}' || c == ']') {
+        return false;
+    }
+
+    if (mAfterValue) {
+        if (c != ',') {
+            setError("Expected ','");
+            return false;
+        }
+        ++mPos;
+        mAfterValue = false;
+
+        skipWhitespace();
+        if (mPos >= mData.size()) {
+            setError("Unexpected end of data");
+            return false;
+        }
+        c = mData.at(mPos);
+        if (c == '}' || c == ']') {
+            setError("Unexpected ','");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QByteArrayView JsonReader::nextName()
+{
+    if (peek() != Type::String) {
+        setError("Expected member name");
+        return {};
+    }
+
+    QByteArrayView name;
+    bool hasEscapes = false;
+    if (!scanString(name, hasEscapes)) {
+        return {};
+    }
+    if (hasEscapes) {
+        mNameBuffer = unescape(name);
+        name = mNameBuffer;
+    }
+
+    skipWhitespace();
+    if (mPos >= mData.size() || mData.at(mPos) != ':') {
+        setError("Expected ':'");
+        return {};
+    }
+    ++mPos;
+    mAfterValue = false;
+
+    return name;
+}
+
+bool JsonReader::scanString(QByteArrayView &value, bool &hasEscapes)
+{
+    // Skip the opening quote
+    const qsizetype start = ++mPos;
+    hasEscapes = false;
+    while (mPos < mData.size()) {
+        const char c = mData.at(mPos);
+        if (c == '"') {
+            value = mData.sliced(start, mPos - start);
+            ++mPos;
+            mAfterValue = true;
+            return true;
+        } else if (c == '\\') {
+            hasEscapes = true;
+            mPos += 2;
+        } else if (static_cast<uchar>(c) < 0x20) {
+            setError("Control character in string");
+            return false;
+        } else {
+            ++mPos;
+        }
+    }
+
+    mPos = mData.size();
+    setError("Unterminated string");
+    return false;
+}
+
+QByteArrayView JsonReader::scanLiteral()
+{
+    const qsizetype start = mPos;
+    while (mPos < mData.size()) {
+        const char c = mData.at(mPos);
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E') {
+            ++mPos;
+        } else {
+            break;
+        }
+    }
+    mAfterValue = true;
+
+    const QByteArrayView literal = mData.sliced(start, mPos - start);
+    if (literal.isEmpty() || (literal.at(0) >= 'a' && literal != "true" && literal != "false" && literal != "null")) {
+        setError("Invalid literal");
+        return {};
+    }
+    return literal;
+}
+
+QByteArray JsonReader::unescape(QByteArrayView value)
+{
+    QByteArray out;
+    out.reserve(value.size());
+    for (qsizetype i = 0; i < value.size(); ++i) {
+        const char c = value.at(i);
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+
+        if (++i >= value.size()) {
+            break;
+        }
+        switch (value.at(i)) {
+        case '"':
+            out += '"';
+            break;
+        case '\\':
+            out += '\\';
+            break;
+        case '/':
+            out += '/';
+            break;
+        case 'b':
+            out += '\b';
+            break;
+        case 'f':
+            out += '\f';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'u': {
+            int ucs = readHex4(value, i + 1);
+            if (ucs < 0) {
+                setError("Invalid escape sequence");
+                return out;
+            }
+            i += 4;
+            // Surrogate pair
+            if (ucs >= 0xd800 && ucs < 0xdc00 && i + 2 < value.size() && value.at(i + 1) == '\\' && value.at(i + 2) == 'u') {
+                const int low = readHex4(value, i + 3);
+                if (low >= 0xdc00 && low < 0xe000) {
+                    ucs = 0x10000 + ((ucs - 0xd800) << 10) + (low - 0xdc00);
+                    i += 6;
+                }
+            }
+            appendUtf8(out, static_cast<char32_t>(ucs));
+            break;
+        }
+        default:
+            setError("Invalid escape sequence");
+            return out;
+        }
+    }
+
+    return out;
+}
+
+QString JsonReader::decodeString()
+{
+    QByteArrayView value;
+    bool hasEscapes = false;
+    if (!scanString(value, hasEscapes)) {
+        return QString();
+    }
+    return hasEscapes ? QString::fromUtf8(unescape(value)) : QString::fromUtf8(value);
+}
+
+QString JsonReader::readString()
+{
+    switch (peek()) {
+    case Type::String:
+        return decodeString();
+    case Type::Number:
+    case Type::Bool:
+        return QString::fromLatin1(scanLiteral());
+    case Type::Null:
+        scanLiteral();
+        return QString();
+    default:
+        skipValue();
+        return QString();
+    }
+}
+
+bool JsonReader::readBool()
+{
+    switch (peek()) {
+    case Type::Bool:
+        return scanLiteral() == "true";
+    case Type::String: {
+        const QString value = decodeString();
+        return !value.isEmpty() && value != QLatin1StringView("0") && value.compare(QLatin1StringView("false"), Qt::CaseInsensitive) != 0;
+    }
+    case Type::Number:
+        return scanLiteral().toDouble() != 0.0;
+    default:
+        skipValue();
+        return false;
+    }
+}
+
+qint64 JsonReader::readInteger()
+{
+    QByteArrayView literal;
+    QByteArray decoded;
+    switch (peek()) {
+    case Type::Number:
+        literal = scanLiteral();
+        break;
+    case Type::String: {
+        // Google APIs encode 64-bit integers as strings
+        bool hasEscapes = false;
+        if (!scanString(literal, hasEscapes)) {
+            return 0;
+        }
+        if (hasEscapes) {
+            decoded = unescape(literal);
+            literal = decoded;
+        }
+        break;
+    }
+    case Type::Bool:
+        return scanLiteral() == "true" ? 1 : 0;
+    default:
+        skipValue();
+        return 0;
+    }
+
+    bool ok = false;
+    const qint64 value = literal.trimmed().toLongLong(&ok);
+    if (ok) {
+        return value;
+    }
+    return static_cast<qint64>(literal.trimmed().toDouble());
+}
+
+double JsonReader::readDouble()
+{
+    switch (peek()) {
+    case Type::Number:
+        return scanLiteral().toDouble();
+    case Type::String:
+        return decodeString().toDouble();
+    case Type::Bool:
+        return scanLiteral() == "true" ? 1.0 : 0.0;
+    default:
+        skipValue();
+        return 0.0;
+    }
+}
+
+QVariant JsonReader::readVariant()
+{
+    return readVariant(0);
+}
+
+QVariant JsonReader::readVariant(int depth)
+{
+    if (depth > MaxDepth) {
+        setError("Document too deeply nested");
+        return QVariant();
+    }
+
+    switch (peek()) {
+    case Type::Object: {
+        QVariantMap map;
+        beginObject();
+        while (hasNext()) {
+            const QString name = QString::fromUtf8(nextName());
+            map.insert(name, readVariant(depth + 1));
+        }
+        endObject();
+        return map;
+    }
+    case Type::Array: {
+        QVariantList list;
+        beginArray();
+        while (hasNext()) {
+            list.append(readVariant(depth + 1));
+        }
+        endArray();
+        return list;
+    }
+    case Type::String:
+        return decodeString();
+    case Type::Number: {
+        const QByteArrayView literal = scanLiteral();
+        if (isIntegerLiteral(literal)) {
+            bool ok = false;
+            const qint64 value = literal.toLongLong(&ok);
+            if (ok) {
+                return value;
+            }
+        }
+        return literal.toDouble();
+    }
+    case Type::Bool:
+        return scanLiteral() == "true";
+    case Type::Null:
+        scanLiteral();
+        return QVariant::fromValue(nullptr);
+    case Type::End:
+        setError("Expected value");
+        return QVariant();
+    case Type::Invalid:
+        setError("Invalid value");
+        return QVariant();
+    }
+
+    return QVariant();
+}
+
+QByteArrayView JsonReader::readRawValue()
+{
+    skipWhitespace();
+    const qsizetype start = mPos;
+    skipValue();
+    if (hasError()) {
+        return {};
+    }
+    return mData.sliced(start, mPos - start);
+}
+
+void JsonReader::skipValue()
+{
+    switch (peek()) {
+    case Type::Object:
+    case Type::Array: {
+        // Nested values don't need to be validated, only the strings
+        // must be skipped as a whole so that brackets inside of them
+        // are not counted
+        int depth = 0;
+        while (mPos < mData.size()) {
+            const char c = mData.at(mPos);
+            if (c == '"') {
+                QByteArrayView value;
+                bool hasEscapes = false;
+                if (!scanString(value, hasEscapes)) {
+                    return;
+                }
+                continue;
+            } else if (c == '{' || c == '[') {
+                if (++depth > MaxDepth) {
+                    setError("Document too deeply nested");
+                    return;
+                }
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    ++mPos;
+                    mAfterValue = true;
+                    return;
+                }
+            }
+            ++mPos;
+        }
+        setError("Unexpected end of data");
+        return;
+    }
+    case Type::String: {
+        QByteArrayView value;
+        bool hasEscapes = false;
+        scanString(value, hasEscapes);
+        return;
+    }
+    case Type::Number:
+    case Type::Bool:
+    case Type::Null:
+        scanLiteral();
+        return;
+    case Type::End:
+        setError("Expected value");
+        return;
+    case Type::Invalid:
+        setError("Invalid value");
+        return;
+    }
+}
+
+bool JsonReader::atEnd()
+{
+    skipWhitespace();
+    return mPos >= mData.size();
+}
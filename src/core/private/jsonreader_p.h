@@ -0,0 +1,227 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapicore_export.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <QVariant>
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace KGAPI2
+{
+
+/**
+ * @internal
+ *
+ * Pull parser for JSON documents.
+ *
+ * Unlike QJsonDocument the reader does not build any intermediate tree:
+ * values are decoded straight from the raw data on demand and values the
+ * caller is not interested in are skipped without allocating anything.
+ *
+ * The reader does not own the data, so the data must outlive it.
+ *
+ * Typical usage:
+ * @code
+ * JsonReader reader(rawData);
+ * if (reader.beginObject()) {
+ *     while (reader.hasNext()) {
+ *         const auto name = reader.nextName();
+ *         if (name == "id") {
+ *             id = reader.readString();
+ *         } else {
+ *             reader.skipValue();
+ *         }
+ *     }
+ *     reader.endObject();
+ * }
+ * @endcode
+ *
+ * Reading a value of a different type than requested does not fail, the
+ * value is converted the same way QVariant would convert it, or skipped.
+ * Malformed data put the reader into an error state, in which all reads
+ * return default values and hasNext() returns false.
+ */
+class KGAPICORE_EXPORT JsonReader
+{
+public:
+    enum class Type {
+        Invalid,
+        Object,
+        Array,
+        String,
+        Number,
+        Bool,
+        Null,
+        End,
+    };
+
+    explicit JsonReader(QByteArrayView data);
+
+    /**
+     * Returns type of the next value, without consuming it.
+     *
+     * Returns Type::End when the end of the current object or array, or of
+     * the data, has been reached.
+     */
+    Type peek();
+
+    /**
+     * Consumes the beginning of an object.
+     *
+     * Returns false when the next value is not an object, in which case
+     * the value is skipped.
+     */
+    bool beginObject();
+
+    /**
+     * Skips all remaining members of the current object and consumes its end.
+     */
+    bool endObject();
+
+    /**
+     * Consumes the beginning of an array.
+     *
+     * Returns false when the next value is not an array, in which case
+     * the value is skipped.
+     */
+    bool beginArray();
+
+    /**
+     * Skips all remaining elements of the current array and consumes its end.
+     */
+    bool endArray();
+
+    /**
+     * Returns whether the current object or array has another member.
+     */
+    bool hasNext();
+
+    /**
+     * Consumes name of the next object member.
+     *
+     * The returned view is only valid until the next call to nextName().
+     */
+    QByteArrayView nextName();
+
+    QString readString();
+    bool readBool();
+    qint64 readInteger();
+    double readDouble();
+
+    /**
+     * Reads the next value, including all nested values, into a QVariant,
+     * the same way QJsonValue::toVariant() would.
+     *
+     * Meant for the parts of documents that are processed by code that
+     * expects a QVariantMap.
+     */
+    QVariant readVariant();
+
+    /**
+     * Skips the next value and returns its raw unparsed data.
+     *
+     * The data can be passed to another JsonReader later.
+     */
+    QByteArrayView readRawValue();
+
+    void skipValue();
+
+    /**
+     * Returns whether there is nothing but whitespace left in the data.
+     */
+    bool atEnd();
+
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    void skipWhitespace();
+    void setError(const char *error);
+    bool scanString(QByteArrayView &value, bool &hasEscapes);
+    QByteArrayView scanLiteral();
+    QByteArray unescape(QByteArrayView value);
+    QString decodeString();
+    QVariant readVariant(int depth);
+
+    QByteArrayView mData;
+    qsizetype mPos = 0;
+    bool mAfterValue = false;
+    QByteArray mNameBuffer;
+    QString mError;
+};
+
+/**
+ * @internal
+ *
+ * Maps member names of a JSON object to handlers that read the member value
+ * into @p Context.
+ *
+ * Tables are meant to be created once per type, as a function-local static,
+ * and replace chains of lookups into a QVariantMap.
+ *
+ * Each handler must consume exactly one value from the reader.
+ */
+template<typename Context>
+class JsonFieldTable
+{
+public:
+    using Handler = void (*)(JsonReader &reader, Context &context);
+
+    struct Field {
+        QByteArrayView name;
+        Handler handler;
+    };
+
+    JsonFieldTable(std::initializer_list<Field> fields)
+        : mFields(fields)
+    {
+        std::sort(mFields.begin(), mFields.end(), [](const Field &lhs, const Field &rhs) {
+            return lhs.name.compare(rhs.name) < 0;
+        });
+    }
+
+    /**
+     * Reads the next object from @p reader, dispatching each member to its
+     * handler and skipping members without a handler.
+     *
+     * Returns false when the next value is not an object or is malformed.
+     */
+    bool read(JsonReader &reader, Context &context) const
+    {
+        if (!reader.beginObject()) {
+            return false;
+        }
+
+        while (reader.hasNext()) {
+            const QByteArrayView name = reader.nextName();
+            const auto field = std::lower_bound(mFields.cbegin(), mFields.cend(), name, [](const Field &field, QByteArrayView name) {
+                return field.name.compare(name) < 0;
+            });
+            if (field != mFields.cend() && field->name == name) {
+                field->handler(reader, context);
+            } else {
+                reader.skipValue();
+            }
+        }
+
+        return reader.endObject();
+    }
+
+private:
+    std::vector<Field> mFields;
+};
+
+} // namespace KGAPI2
@@ -21,39 +21,57 @@ public:
     {
     }
 
+    /**
+     * Whether replies for all items have been processed
+     */
     bool atEnd() const
     {
-        return (m_iter == m_items.constEnd());
+        return m_current >= m_items.count();
     }
 
     void currentProcessed()
     {
-        ++m_iter;
+        ++m_current;
     }
 
+    /**
+     * The oldest item whose reply has not been processed yet
+     */
     T current()
     {
-        return *m_iter;
+        return m_items.at(m_current);
+    }
+
+    /**
+     * Whether there are items for which no request has been enqueued yet
+     */
+    bool hasUnqueued() const
+    {
+        return m_unqueued < m_items.count();
+    }
+
+    /**
+     * Returns the next item for which no request has been enqueued yet
+     *
+     * Jobs can enqueue requests for all items at once and let Job dispatch
+     * them concurrently. Since replies are handled in the order in which the
+     * requests were dispatched, current() still refers to the item the reply
+     * being handled belongs to.
+     */
+    T takeUnqueued()
+    {
+        return m_items.at(m_unqueued++);
     }
 
     QueueHelper &operator<<(const T &item)
     {
         m_items << item;
-        if (m_items.count() == 1) {
-            m_iter = m_items.constBegin();
-        }
         return *this;
     }
 
     QueueHelper &operator<<(const QList<T> &list)
     {
-        if (m_items.count() == 0) {
-            m_items << list;
-            m_iter = m_items.constBegin();
-        } else {
-            m_items << list;
-        }
-
+        m_items << list;
         return *this;
     }
 
@@ -66,12 +84,14 @@ public:
     {
         m_items.clear();
         m_items << list;
-        m_iter = m_items.constBegin();
+        m_current = 0;
+        m_unqueued = 0;
         return *this;
     }
 
 private:
     QQueue<T> m_items;
 
-    typename QList<T>::ConstIterator m_iter;
+    qsizetype m_current = 0;
+    qsizetype m_unqueued = 0;
 };
@@ -0,0 +1,171 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "ratelimiter.h"
+#include "debug.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QRandomGenerator>
+
+#include <cmath>
+
+using namespace KGAPI2;
+
+namespace
+{
+// First backoff, doubled with every consecutive rejection
+static const qint64 InitialBackoff = 1000;
+// Random amount of time added to each backoff, so that jobs don't retry all at once
+static const qint64 MaxJitter = 1000;
+static const int DefaultMaxBackoff = 64 * 1000;
+
+struct Limit {
+    double rate = 0;
+    int burst = 1;
+};
+
+struct Bucket {
+    double tokens = 0;
+    qint64 lastRefill = 0;
+    qint64 blockedUntil = 0;
+    int backoffLevel = 0;
+};
+}
+
+class Q_DECL_HIDDEN RateLimiter::Private
+{
+public:
+    Private()
+    {
+        clock.start();
+    }
+
+    Bucket &bucket(const QString &account, const QString &host, const Limit &limit, qint64 now);
+
+    mutable QMutex lock;
+    QElapsedTimer clock;
+    QHash<QString, Limit> limits;
+    Limit defaultLimit;
+    int maxBackoff = DefaultMaxBackoff;
+    QHash<QString, Bucket> buckets;
+};
+
+Bucket &RateLimiter::Private::bucket(const QString &account, const QString &host, const Limit &limit, qint64 now)
+{
+    const QString key = account + QLatin1Char('\n') + host;
+    auto it = buckets.find(key);
+    if (it == buckets.end()) {
+        // New buckets start full
+        it = buckets.insert(key, Bucket{double(limit.burst), now, 0, 0});
+    }
+    return *it;
+}
+
+RateLimiter::RateLimiter()
+    : d(new Private)
+{
+}
+
+RateLimiter::~RateLimiter() = default;
+
+RateLimiter *RateLimiter::instance()
+{
+    static RateLimiter sInstance;
+    return &sInstance;
+}
+
+void RateLimiter::setRequestsPerSecond(const QString &host, double requestsPerSecond, int burst)
+{
+    QMutexLocker locker(&d->lock);
+    d->limits.insert(host, Limit{qMax(requestsPerSecond, 0.0), qMax(burst, 1)});
+}
+
+double RateLimiter::requestsPerSecond(const QString &host) const
+{
+    QMutexLocker locker(&d->lock);
+    return d->limits.value(host, d->defaultLimit).rate;
+}
+
+void RateLimiter::setDefaultRequestsPerSecond(double requestsPerSecond, int burst)
+{
+    QMutexLocker locker(&d->lock);
+    d->defaultLimit = Limit{qMax(requestsPerSecond, 0.0), qMax(burst, 1)};
+}
+
+void RateLimiter::setMaxBackoff(int msecs)
+{
+    QMutexLocker locker(&d->lock);
+    d->maxBackoff = qMax(msecs, 0);
+}
+
+int RateLimiter::maxBackoff() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->maxBackoff;
+}
+
+qint64 RateLimiter::acquire(const QString &account, const QString &host, int cost)
+{
+    QMutexLocker locker(&d->lock);
+    const qint64 now = d->clock.elapsed();
+    const Limit limit = d->limits.value(host, d->defaultLimit);
+    Bucket &bucket = d->bucket(account, host, limit, now);
+
+    if (bucket.blockedUntil > now) {
+        return bucket.blockedUntil - now;
+    }
+    if (limit.rate <= 0) {
+        return 0;
+    }
+
+    bucket.tokens = qMin<double>(limit.burst, bucket.tokens + (now - bucket.lastRefill) * limit.rate / 1000.0);
+    bucket.lastRefill = now;
+    if (bucket.tokens >= 1.0) {
+        // Batches may take more tokens than available, the following requests wait for them
+        bucket.tokens -= cost;
+        return 0;
+    }
+
+    return qint64(std::ceil((1.0 - bucket.tokens) * 1000.0 / limit.rate));
+}
+
+qint64 RateLimiter::reportRateLimited(const QString &account, const QString &host, qint64 retryAfter)
+{
+    QMutexLocker locker(&d->lock);
+    const qint64 now = d->clock.elapsed();
+    Bucket &bucket = d->bucket(account, host, d->limits.value(host, d->defaultLimit), now);
+
+    // Requests sent before the backoff has started don't make it any longer
+    if (bucket.blockedUntil > now && retryAfter <= 0) {
+        return bucket.blockedUntil - now;
+    }
+
+    qint64 delay = retryAfter;
+    if (delay <= 0) {
+        const qint64 backoff = InitialBackoff << qMin(bucket.backoffLevel, 16);
+        delay = qMin<qint64>(backoff + QRandomGenerator::global()->bounded(MaxJitter), d->maxBackoff);
+    }
+    ++bucket.backoffLevel;
+    bucket.tokens = qMin(bucket.tokens, 0.0);
+    // Other jobs may have already backed off further
+    bucket.blockedUntil = qMax(bucket.blockedUntil, now + delay);
+
+    qCDebug(KGAPIDebug) << "Rate limited" << account << "on" << host << ", backing off for" << bucket.blockedUntil - now << "msecs";
+    return bucket.blockedUntil - now;
+}
+
+void RateLimiter::reportSuccess(const QString &account, const QString &host)
+{
+    QMutexLocker locker(&d->lock);
+    auto it = d->buckets.find(account + QLatin1Char('\n') + host);
+    if (it != d->buckets.end()) {
+        it->backoffLevel = 0;
+    }
+}
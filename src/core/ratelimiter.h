@@ -0,0 +1,111 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QString>
+
+#include "kgapicore_export.h"
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile ratelimiter.h
+ * @brief Schedules requests of all jobs within the quotas of Google APIs
+ *
+ * Google limits how many requests a user can send to an API per second. All
+ * jobs, regardless of the thread they run in, dispatch their requests through
+ * a token bucket of the account and the host the request is sent to. The
+ * rate of the bucket can be configured per host to match the per-user quota of
+ * the API, so that requests are delayed just enough to never exceed it.
+ *
+ * When the server rejects a request due to exceeded quota nevertheless, the
+ * account is backed off exponentially, with random jitter, for all jobs that
+ * send requests to the same host. The Retry-After header of the reply takes
+ * precedence when present. The backoff is reset once a request succeeds again.
+ *
+ * By default the rate is not limited and only the backoff applies.
+ *
+ * The class is thread-safe.
+ *
+ * @since 6.1
+ */
+class KGAPICORE_EXPORT RateLimiter
+{
+public:
+    ~RateLimiter();
+
+    static RateLimiter *instance();
+
+    /**
+     * @brief Limits requests to @p host per account
+     *
+     * @param host Host name of the API, for example "www.googleapis.com"
+     * @param requestsPerSecond Sustained rate of requests, 0 to not limit the rate
+     * @param burst How many requests can be sent at once after a period of inactivity
+     */
+    void setRequestsPerSecond(const QString &host, double requestsPerSecond, int burst = 1);
+
+    /**
+     * @brief Returns sustained rate of requests to @p host, 0 when not limited
+     */
+    [[nodiscard]] double requestsPerSecond(const QString &host) const;
+
+    /**
+     * @brief Limits requests to hosts that have no explicit limit set
+     *
+     * @see setRequestsPerSecond
+     */
+    void setDefaultRequestsPerSecond(double requestsPerSecond, int burst = 1);
+
+    /**
+     * @brief Sets maximum backoff in milliseconds
+     *
+     * Default is 64 seconds.
+     */
+    void setMaxBackoff(int msecs);
+    [[nodiscard]] int maxBackoff() const;
+
+    /**
+     * @brief Takes permission to send @p cost requests of @p account to @p host
+     *
+     * Used by Job before dispatching a request.
+     *
+     * @return 0 when the requests can be sent right away, otherwise how many
+     *         milliseconds to wait before asking again.
+     */
+    [[nodiscard]] qint64 acquire(const QString &account, const QString &host, int cost = 1);
+
+    /**
+     * @brief Backs @p account off from sending requests to @p host
+     *
+     * Used by Job when a request has been rejected due to exceeded quota.
+     *
+     * @param retryAfter Delay in milliseconds requested by the server, or 0
+     * @return How many milliseconds to wait before sending the request again
+     */
+    qint64 reportRateLimited(const QString &account, const QString &host, qint64 retryAfter = 0);
+
+    /**
+     * @brief Resets backoff of @p account for @p host
+     *
+     * Used by Job when a request has succeeded.
+     */
+    void reportSuccess(const QString &account, const QString &host);
+
+private:
+    RateLimiter();
+    Q_DISABLE_COPY(RateLimiter)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace KGAPI2
@@ -0,0 +1,301 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "requestmetrics.h"
+
+#include <QJsonArray>
+#include <QMap>
+#include <QMutex>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+using namespace KGAPI2;
+
+namespace
+{
+// Upper bounds of the buckets in microseconds, roughly logarithmic from 1 ms to 30 s
+static const std::array<qint64, 13> BucketBounds = {
+    1000,
+    5000,
+    10000,
+    25000,
+    50000,
+    100000,
+    250000,
+    500000,
+    1000000,
+    2500000,
+    5000000,
+    10000000,
+    30000000,
+};
+static const int PhaseCount = RequestMetrics::Total + 1;
+
+qint64 phaseDuration(const RequestTiming &timing, RequestMetrics::Phase phase)
+{
+    switch (phase) {
+    case RequestMetrics::QueueWait:
+        return timing.queueWait;
+    case RequestMetrics::Connect:
+        return timing.connect;
+    case RequestMetrics::TimeToFirstByte:
+        return timing.timeToFirstByte;
+    case RequestMetrics::Transfer:
+        return timing.transfer;
+    case RequestMetrics::Parse:
+        return timing.parse;
+    case RequestMetrics::Total:
+        return timing.total;
+    }
+    return -1;
+}
+
+QByteArray phaseName(RequestMetrics::Phase phase)
+{
+    switch (phase) {
+    case RequestMetrics::QueueWait:
+        return "queue_wait";
+    case RequestMetrics::Connect:
+        return "connect";
+    case RequestMetrics::TimeToFirstByte:
+        return "ttfb";
+    case RequestMetrics::Transfer:
+        return "transfer";
+    case RequestMetrics::Parse:
+        return "parse";
+    case RequestMetrics::Total:
+        return "total";
+    }
+    return {};
+}
+
+QByteArray seconds(qint64 usecs)
+{
+    return QByteArray::number(usecs / 1000000.0, 'g', 12);
+}
+
+QByteArray label(const QString &value)
+{
+    QByteArray escaped = value.toUtf8();
+    escaped.replace('\\', "\\\\");
+    escaped.replace('"', "\\\"");
+    return escaped;
+}
+}
+
+class Q_DECL_HIDDEN RequestMetrics::Private
+{
+public:
+    struct ApiMetrics {
+        ApiMetrics()
+        {
+            for (auto &histogram : phases) {
+                histogram.buckets.resize(BucketBounds.size() + 1);
+            }
+        }
+
+        qint64 requests = 0;
+        qint64 retries = 0;
+        qint64 bytesSent = 0;
+        qint64 bytesReceived = 0;
+        QMap<int, qint64> statuses;
+        std::array<Histogram, PhaseCount> phases;
+    };
+
+    static void add(Histogram &histogram, qint64 duration);
+
+    std::atomic<bool> enabled = false;
+    mutable QMutex lock;
+    QMap<QString, ApiMetrics> metrics;
+};
+
+void RequestMetrics::Private::add(Histogram &histogram, qint64 duration)
+{
+    if (duration < 0) {
+        return;
+    }
+
+    const auto bucket = std::lower_bound(BucketBounds.cbegin(), BucketBounds.cend(), duration);
+    ++histogram.buckets[std::distance(BucketBounds.cbegin(), bucket)];
+    ++histogram.count;
+    histogram.sum += duration;
+}
+
+RequestMetrics::RequestMetrics()
+    : d(new Private)
+{
+    qRegisterMetaType<KGAPI2::RequestTiming>();
+}
+
+RequestMetrics::~RequestMetrics() = default;
+
+RequestMetrics *RequestMetrics::instance()
+{
+    static RequestMetrics sInstance;
+    return &sInstance;
+}
+
+void RequestMetrics::setEnabled(bool enabled)
+{
+    d->enabled = enabled;
+}
+
+bool RequestMetrics::isEnabled() const
+{
+    return d->enabled;
+}
+
+QList<qint64> RequestMetrics::bucketBounds()
+{
+    return QList<qint64>(BucketBounds.cbegin(), BucketBounds.cend());
+}
+
+QStringList RequestMetrics::apis() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->metrics.keys();
+}
+
+qint64 RequestMetrics::requestCount(const QString &api) const
+{
+    QMutexLocker locker(&d->lock);
+    return d->metrics.value(api).requests;
+}
+
+RequestMetrics::Histogram RequestMetrics::histogram(const QString &api, Phase phase) const
+{
+    QMutexLocker locker(&d->lock);
+    return d->metrics.value(api).phases[phase];
+}
+
+QByteArray RequestMetrics::toPrometheus() const
+{
+    QMutexLocker locker(&d->lock);
+
+    QByteArray out;
+    out += "# HELP kgapi_request_duration_seconds Duration of phases of requests sent by LibKGAPI\n";
+    out += "# TYPE kgapi_request_duration_seconds histogram\n";
+    for (auto api = d->metrics.cbegin(); api != d->metrics.cend(); ++api) {
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            const Histogram &histogram = api->phases[phase];
+            const QByteArray labels = "api=\"" + label(api.key()) + "\",phase=\"" + phaseName(static_cast<Phase>(phase)) + '"';
+            // Prometheus buckets are cumulative
+            qint64 cumulative = 0;
+            for (std::size_t i = 0; i < BucketBounds.size(); ++i) {
+                cumulative += histogram.buckets[i];
+                out += "kgapi_request_duration_seconds_bucket{" + labels + ",le=\"" + seconds(BucketBounds[i]) + "\"} " + QByteArray::number(cumulative)
+                    + '\n';
+            }
+            out += "kgapi_request_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " + QByteArray::number(histogram.count) + '\n';
+            out += "kgapi_request_duration_seconds_sum{" + labels + "} " + seconds(histogram.sum) + '\n';
+            out += "kgapi_request_duration_seconds_count{" + labels + "} " + QByteArray::number(histogram.count) + '\n';
+        }
+    }
+
+    out += "# HELP kgapi_requests_total Requests sent by LibKGAPI by HTTP status of the reply\n";
+    out += "# TYPE kgapi_requests_total counter\n";
+    for (auto api = d->metrics.cbegin(); api != d->metrics.cend(); ++api) {
+        for (auto status = api->statuses.cbegin(); status != api->statuses.cend(); ++status) {
+            out += "kgapi_requests_total{api=\"" + label(api.key()) + "\",status=\"" + QByteArray::number(status.key()) + "\"} "
+                + QByteArray::number(status.value()) + '\n';
+        }
+    }
+
+    const auto counter = [this, &out](const QByteArray &name, const QByteArray &help, qint64 Private::ApiMetrics::*member) {
+        out += "# HELP " + name + ' ' + help + '\n';
+        out += "# TYPE " + name + " counter\n";
+        for (auto api = d->metrics.cbegin(); api != d->metrics.cend(); ++api) {
+            out += name + "{api=\"" + label(api.key()) + "\"} " + QByteArray::number((*api).*member) + '\n';
+        }
+    };
+    counter("kgapi_request_retries_total", "Requests sent again after a transient error", &Private::ApiMetrics::retries);
+    counter("kgapi_request_sent_bytes_total", "Size of request bodies sent by LibKGAPI", &Private::ApiMetrics::bytesSent);
+    counter("kgapi_response_received_bytes_total", "Size of reply bodies received by LibKGAPI", &Private::ApiMetrics::bytesReceived);
+
+    return out;
+}
+
+QJsonObject RequestMetrics::toJson() const
+{
+    QMutexLocker locker(&d->lock);
+
+    const QList<qint64> bounds = bucketBounds();
+    QJsonArray boundsArray;
+    for (const qint64 bound : bounds) {
+        boundsArray.append(bound);
+    }
+
+    QJsonObject apis;
+    for (auto api = d->metrics.cbegin(); api != d->metrics.cend(); ++api) {
+        QJsonObject statuses;
+        for (auto status = api->statuses.cbegin(); status != api->statuses.cend(); ++status) {
+            statuses.insert(QString::number(status.key()), status.value());
+        }
+
+        QJsonObject phases;
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            const Histogram &histogram = api->phases[phase];
+            QJsonArray buckets;
+            for (const qint64 bucket : histogram.buckets) {
+                buckets.append(bucket);
+            }
+            phases.insert(QString::fromLatin1(phaseName(static_cast<Phase>(phase))),
+                          QJsonObject{{QStringLiteral("count"), histogram.count}, {QStringLiteral("sum"), histogram.sum}, {QStringLiteral("buckets"), buckets}});
+        }
+
+        apis.insert(api.key(),
+                    QJsonObject{
+                        {QStringLiteral("requests"), api->requests},
+                        {QStringLiteral("retries"), api->retries},
+                        {QStringLiteral("bytesSent"), api->bytesSent},
+                        {QStringLiteral("bytesReceived"), api->bytesReceived},
+                        {QStringLiteral("statuses"), statuses},
+                        {QStringLiteral("phases"), phases},
+                    });
+    }
+
+    return QJsonObject{{QStringLiteral("bucketBounds"), boundsArray}, {QStringLiteral("apis"), apis}};
+}
+
+void RequestMetrics::reset()
+{
+    QMutexLocker locker(&d->lock);
+    d->metrics.clear();
+}
+
+void RequestMetrics::record(const RequestTiming &timing)
+{
+    {
+        QMutexLocker locker(&d->lock);
+        auto &metrics = d->metrics[timing.api];
+        ++metrics.requests;
+        // Every attempt is recorded separately, count only those that were retries
+        if (timing.retries > 0) {
+            ++metrics.retries;
+        }
+        metrics.bytesSent += timing.bytesSent;
+        metrics.bytesReceived += timing.bytesReceived;
+        ++metrics.statuses[timing.status];
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            Private::add(metrics.phases[phase], phaseDuration(timing, static_cast<Phase>(phase)));
+        }
+    }
+
+    Q_EMIT requestFinished(timing);
+}
+
+QString RequestMetrics::apiForUrl(const QUrl &url)
+{
+    const QString path = url.path();
+    const qsizetype end = path.indexOf(QLatin1Char('/'), 1);
+    return url.host() + (end > 0 ? path.left(end) : path);
+}
+
+#include "moc_requestmetrics.cpp"
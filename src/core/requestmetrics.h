@@ -0,0 +1,174 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+#include <QUrl>
+
+#include "kgapicore_export.h"
+
+namespace KGAPI2
+{
+
+/**
+ * @brief Timings of a single request sent by a job
+ *
+ * All durations are in microseconds, a duration is -1 when it is not known,
+ * for example there is no connection phase when an already open connection
+ * is reused.
+ *
+ * @since 6.1
+ */
+struct RequestTiming {
+    /** API the request was sent to, the host and the first segment of the path */
+    QString api;
+    QUrl url;
+    QByteArray method;
+    /** HTTP status code of the reply, 0 when the request failed without a reply */
+    int status = 0;
+    /** How many times the request has been sent again after a transient error */
+    int retries = 0;
+    /** Size of the request body as sent, after compression */
+    qint64 bytesSent = 0;
+    /** Size of the reply body as received, before decompression */
+    qint64 bytesReceived = 0;
+
+    /** Time the request has spent in the queue of the job before it was sent */
+    qint64 queueWait = -1;
+    /** Time to look up the host and to open the connection, including the TLS handshake */
+    qint64 connect = -1;
+    /** Time from sending the request to receiving the headers of the reply */
+    qint64 timeToFirstByte = -1;
+    /** Time to receive the body of the reply */
+    qint64 transfer = -1;
+    /** Time the job has spent parsing the reply in FetchJob::handleReplyWithItems(), unknown when parsed in the thread pool */
+    qint64 parse = -1;
+    /** Time from sending the request until the whole reply was received */
+    qint64 total = -1;
+};
+
+/**
+ * @headerfile requestmetrics.h
+ * @brief Collects timings of requests sent by all jobs
+ *
+ * When enabled, every job measures each request it sends and passes the
+ * RequestTiming to record(). The timings are aggregated into histograms
+ * per API and phase, which can be exported with toPrometheus() or toJson(),
+ * and each of them is announced with the requestFinished() signal.
+ *
+ * Requests sent in a batch are measured as a single request to the batch
+ * endpoint.
+ *
+ * Collecting is disabled by default. The class is thread-safe.
+ *
+ * @since 6.1
+ */
+class KGAPICORE_EXPORT RequestMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    enum Phase {
+        QueueWait,
+        Connect,
+        TimeToFirstByte,
+        Transfer,
+        Parse,
+        Total,
+    };
+    Q_ENUM(Phase)
+
+    struct Histogram {
+        /** Number of durations that fell into each bucket, the last bucket has no upper bound */
+        QList<qint64> buckets;
+        qint64 count = 0;
+        /** Sum of all durations in microseconds */
+        qint64 sum = 0;
+    };
+
+    ~RequestMetrics() override;
+
+    static RequestMetrics *instance();
+
+    /**
+     * @brief Sets whether jobs measure their requests
+     */
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief Upper bounds of the histogram buckets in microseconds
+     */
+    [[nodiscard]] static QList<qint64> bucketBounds();
+
+    /**
+     * @brief APIs for which any requests have been recorded
+     */
+    [[nodiscard]] QStringList apis() const;
+
+    /**
+     * @brief Number of requests recorded for @p api
+     */
+    [[nodiscard]] qint64 requestCount(const QString &api) const;
+
+    /**
+     * @brief Durations of @p phase of requests recorded for @p api
+     */
+    [[nodiscard]] Histogram histogram(const QString &api, Phase phase) const;
+
+    /**
+     * @brief Exports the aggregated metrics in the Prometheus text format
+     */
+    [[nodiscard]] QByteArray toPrometheus() const;
+
+    /**
+     * @brief Exports the aggregated metrics as JSON
+     */
+    [[nodiscard]] QJsonObject toJson() const;
+
+    /**
+     * @brief Discards all aggregated metrics
+     */
+    void reset();
+
+    /**
+     * @brief Adds timings of a finished request to the metrics
+     *
+     * Used by Job.
+     */
+    void record(const KGAPI2::RequestTiming &timing);
+
+    /**
+     * @brief Returns the API that a request to @p url belongs to
+     */
+    [[nodiscard]] static QString apiForUrl(const QUrl &url);
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted for every recorded request
+     *
+     * The signal is emitted from the thread of the job that has sent the request.
+     */
+    void requestFinished(const KGAPI2::RequestTiming &timing);
+
+private:
+    RequestMetrics();
+    Q_DISABLE_COPY(RequestMetrics)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace KGAPI2
+
+Q_DECLARE_METATYPE(KGAPI2::RequestTiming)
@@ -0,0 +1,223 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "responsecache.h"
+#include "debug.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QSaveFile>
+
+using namespace KGAPI2;
+
+namespace
+{
+static const qint64 DefaultMaxMemorySize = 8 * 1024 * 1024;
+// Identifies files written by this version of the cache
+static const QByteArray FileMagic = QByteArrayLiteral("KGAPI-CACHE-1");
+}
+
+class Q_DECL_HIDDEN ResponseCache::Private
+{
+public:
+    static QString cacheKey(const QString &account, const QUrl &url);
+    QString filePath(const QString &key) const;
+
+    Entry readFile(const QString &key) const;
+    void writeFile(const QString &key, const Entry &entry) const;
+    void insertToMemory(const QString &key, const Entry &entry);
+
+    mutable QMutex lock;
+    bool enabled = false;
+    QString directory;
+    // Cost of an entry is the size of its data
+    QCache<QString, Entry> memory;
+};
+
+QString ResponseCache::Private::cacheKey(const QString &account, const QUrl &url)
+{
+    return account + QLatin1Char('\n') + url.toString(QUrl::FullyEncoded);
+}
+
+QString ResponseCache::Private::filePath(const QString &key) const
+{
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return directory + QLatin1Char('/') + QString::fromLatin1(hash);
+}
+
+ResponseCache::Entry ResponseCache::Private::readFile(const QString &key) const
+{
+    if (directory.isEmpty()) {
+        return {};
+    }
+
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+
+    const auto readLine = [&file]() {
+        QByteArray line = file.readLine();
+        if (line.endsWith('\n')) {
+            line.chop(1);
+        }
+        return line;
+    };
+
+    // The key, which spans two lines, is stored as well to rule out collisions of the hashes
+    if (readLine() != FileMagic) {
+        return {};
+    }
+    const QByteArray account = readLine();
+    if (QString::fromUtf8(account + '\n' + readLine()) != key) {
+        return {};
+    }
+
+    Entry entry;
+    entry.etag = readLine();
+    entry.data = file.readAll();
+    return entry;
+}
+
+void ResponseCache::Private::writeFile(const QString &key, const Entry &entry) const
+{
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to write cache file" << file.fileName() << ":" << file.errorString();
+        return;
+    }
+
+    file.write(FileMagic + '\n' + key.toUtf8() + '\n' + entry.etag + '\n');
+    file.write(entry.data);
+    if (!file.commit()) {
+        qCWarning(KGAPIDebug) << "Failed to write cache file" << file.fileName() << ":" << file.errorString();
+    }
+}
+
+void ResponseCache::Private::insertToMemory(const QString &key, const Entry &entry)
+{
+    // QCache refuses objects larger than its capacity, they are only stored on disk
+    memory.insert(key, new Entry(entry), qMax<qsizetype>(entry.data.size(), 1));
+}
+
+ResponseCache::ResponseCache()
+    : d(new Private)
+{
+    d->memory.setMaxCost(DefaultMaxMemorySize);
+}
+
+ResponseCache::~ResponseCache() = default;
+
+ResponseCache *ResponseCache::instance()
+{
+    static ResponseCache sInstance;
+    return &sInstance;
+}
+
+void ResponseCache::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&d->lock);
+    d->enabled = enabled;
+}
+
+bool ResponseCache::isEnabled() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->enabled;
+}
+
+void ResponseCache::setMaxMemorySize(qint64 bytes)
+{
+    QMutexLocker locker(&d->lock);
+    d->memory.setMaxCost(qMax<qint64>(bytes, 0));
+}
+
+qint64 ResponseCache::maxMemorySize() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->memory.maxCost();
+}
+
+void ResponseCache::setCacheDirectory(const QString &path)
+{
+    QMutexLocker locker(&d->lock);
+    if (!path.isEmpty() && !QDir().mkpath(path)) {
+        qCWarning(KGAPIDebug) << "Failed to create cache directory" << path;
+        d->directory.clear();
+        return;
+    }
+    d->directory = path;
+}
+
+QString ResponseCache::cacheDirectory() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->directory;
+}
+
+ResponseCache::Entry ResponseCache::find(const QString &account, const QUrl &url) const
+{
+    QMutexLocker locker(&d->lock);
+    if (!d->enabled) {
+        return {};
+    }
+
+    const QString key = Private::cacheKey(account, url);
+    if (const Entry *entry = d->memory.object(key)) {
+        return *entry;
+    }
+
+    const Entry entry = d->readFile(key);
+    if (entry.isValid()) {
+        d->insertToMemory(key, entry);
+    }
+    return entry;
+}
+
+void ResponseCache::insert(const QString &account, const QUrl &url, const QByteArray &etag, const QByteArray &data)
+{
+    QMutexLocker locker(&d->lock);
+    if (!d->enabled || etag.isEmpty()) {
+        return;
+    }
+
+    const QString key = Private::cacheKey(account, url);
+    const Entry entry{etag, data};
+    d->insertToMemory(key, entry);
+    d->writeFile(key, entry);
+}
+
+void ResponseCache::remove(const QString &account, const QUrl &url)
+{
+    QMutexLocker locker(&d->lock);
+    const QString key = Private::cacheKey(account, url);
+    d->memory.remove(key);
+    if (!d->directory.isEmpty()) {
+        QFile::remove(d->filePath(key));
+    }
+}
+
+void ResponseCache::clear()
+{
+    QMutexLocker locker(&d->lock);
+    d->memory.clear();
+    if (!d->directory.isEmpty()) {
+        QDir dir(d->directory);
+        const auto files = dir.entryList(QDir::Files);
+        for (const auto &file : files) {
+            dir.remove(file);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QScopedPointer>
+#include <QString>
+#include <QUrl>
+
+#include "kgapicore_export.h"
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile responsecache.h
+ * @brief Caches replies of fetch jobs to avoid transferring unchanged data
+ *
+ * FetchJob stores bodies of replies that carry an ETag header in the cache.
+ * When the same URL is fetched again for the same account, the request is
+ * sent with an If-None-Match header and when the server replies with
+ * 304 Not Modified, the cached body is passed to the job instead, as if the
+ * server has sent it again.
+ *
+ * The cache keeps the most recently used replies in memory, up to
+ * maxMemorySize(). When a cache directory is set, all replies are also stored
+ * on disk, so that they survive restarts of the application. The directory
+ * is expected to be private to the application, because the cached replies
+ * contain user data.
+ *
+ * The cache keeps copies of the fetched data, so it is disabled by default and
+ * applications have to enable it with setEnabled(). The class is thread-safe.
+ *
+ * @since 6.1
+ */
+class KGAPICORE_EXPORT ResponseCache
+{
+public:
+    struct Entry {
+        QByteArray etag;
+        QByteArray data;
+
+        [[nodiscard]] bool isValid() const
+        {
+            return !etag.isEmpty();
+        }
+    };
+
+    ~ResponseCache();
+
+    static ResponseCache *instance();
+
+    /**
+     * @brief Sets whether fetch jobs use the cache, false by default
+     */
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief Sets maximum total size in bytes of replies kept in memory
+     *
+     * Least recently used replies are evicted first. Default is 8 MiB.
+     */
+    void setMaxMemorySize(qint64 bytes);
+    [[nodiscard]] qint64 maxMemorySize() const;
+
+    /**
+     * @brief Sets directory to store the cached replies in
+     *
+     * The directory is created when it does not exist. An empty path, which
+     * is the default, keeps the replies only in memory.
+     */
+    void setCacheDirectory(const QString &path);
+    [[nodiscard]] QString cacheDirectory() const;
+
+    /**
+     * @brief Looks up cached reply to @p url fetched by @p account
+     *
+     * @return The cached reply, or an invalid entry when there is none.
+     */
+    [[nodiscard]] Entry find(const QString &account, const QUrl &url) const;
+
+    /**
+     * @brief Stores reply to @p url fetched by @p account
+     */
+    void insert(const QString &account, const QUrl &url, const QByteArray &etag, const QByteArray &data);
+
+    /**
+     * @brief Removes reply to @p url fetched by @p account from the cache
+     */
+    void remove(const QString &account, const QUrl &url);
+
+    /**
+     * @brief Removes all replies from the cache, including those stored on disk
+     */
+    void clear();
+
+private:
+    ResponseCache();
+    Q_DISABLE_COPY(ResponseCache)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace KGAPI2
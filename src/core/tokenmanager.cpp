@@ -0,0 +1,191 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "tokenmanager.h"
+#include "account.h"
+#include "debug.h"
+#include "private/refreshtokensjob_p.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
+
+using namespace KGAPI2;
+
+namespace
+{
+static const int DefaultRefreshMargin = 300;
+}
+
+class Q_DECL_HIDDEN TokenManager::Private
+{
+public:
+    Private(TokenManager *qq)
+        : q(qq)
+    {
+    }
+
+    void refreshFinished(const QString &refreshToken, RefreshTokensJob *job);
+
+    // Guards the settings and the tokens of accounts, which are read by jobs in any thread
+    mutable QMutex lock;
+    QString apiKey;
+    QString apiSecret;
+    int refreshMargin = DefaultRefreshMargin;
+
+    // Accounts waiting for a refresh, by their refresh token. Only used in the thread of the manager.
+    QHash<QString, QList<AccountPtr>> pendingRefreshes;
+
+private:
+    TokenManager *const q;
+};
+
+void TokenManager::Private::refreshFinished(const QString &refreshToken, RefreshTokensJob *job)
+{
+    const QList<AccountPtr> accounts = pendingRefreshes.take(refreshToken);
+    const AccountPtr refreshed = job->account();
+    if (job->error() == KGAPI2::NoError) {
+        qCDebug(KGAPIDebug) << "Refreshed tokens of" << refreshed->accountName() << "for" << accounts.size() << "accounts";
+        QMutexLocker locker(&lock);
+        for (const auto &account : accounts) {
+            account->setAccessToken(refreshed->accessToken());
+            account->setExpireDateTime(refreshed->expireDateTime());
+        }
+    } else {
+        qCWarning(KGAPIDebug) << "Failed to refresh tokens of" << refreshed->accountName() << ":" << job->errorString();
+    }
+
+    for (const auto &account : accounts) {
+        Q_EMIT q->tokensRefreshed(account, job->error(), job->errorString());
+    }
+
+    job->deleteLater();
+}
+
+TokenManager::TokenManager(QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+}
+
+TokenManager::~TokenManager() = default;
+
+namespace KGAPI2
+{
+class TokenManagerHolder
+{
+public:
+    TokenManagerHolder()
+    {
+        // Jobs in any thread may use the manager, which must not die with the thread that used it first
+        if (auto app = QCoreApplication::instance()) {
+            manager.moveToThread(app->thread());
+        }
+    }
+
+    TokenManager manager;
+};
+}
+
+Q_GLOBAL_STATIC(TokenManagerHolder, sTokenManager)
+
+TokenManager *TokenManager::instance()
+{
+    return &sTokenManager->manager;
+}
+
+void TokenManager::setClientCredentials(const QString &apiKey, const QString &apiSecret)
+{
+    QMutexLocker locker(&d->lock);
+    d->apiKey = apiKey;
+    d->apiSecret = apiSecret;
+}
+
+bool TokenManager::isEnabled() const
+{
+    QMutexLocker locker(&d->lock);
+    return !d->apiKey.isEmpty() && !d->apiSecret.isEmpty();
+}
+
+void TokenManager::setRefreshMargin(int seconds)
+{
+    QMutexLocker locker(&d->lock);
+    d->refreshMargin = qMax(seconds, 0);
+}
+
+int TokenManager::refreshMargin() const
+{
+    QMutexLocker locker(&d->lock);
+    return d->refreshMargin;
+}
+
+bool TokenManager::needsRefresh(const AccountPtr &account) const
+{
+    if (!isEnabled() || !account || account->refreshToken().isEmpty()) {
+        return false;
+    }
+
+    QMutexLocker locker(&d->lock);
+    const QDateTime expiration = account->expireDateTime();
+    return expiration.isValid() && expiration <= QDateTime::currentDateTime().addSecs(d->refreshMargin);
+}
+
+QString TokenManager::accessToken(const AccountPtr &account) const
+{
+    QMutexLocker locker(&d->lock);
+    return account->accessToken();
+}
+
+QDateTime TokenManager::expireDateTime(const AccountPtr &account) const
+{
+    QMutexLocker locker(&d->lock);
+    return account->expireDateTime();
+}
+
+void TokenManager::refreshTokens(const AccountPtr &account)
+{
+    // Refreshes are coordinated in the thread of the manager
+    if (thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(this, [this, account]() {
+            refreshTokens(account);
+        });
+        return;
+    }
+
+    if (!isEnabled() || account->refreshToken().isEmpty()) {
+        // Let the caller handle the signal the same way as if the refresh failed on the server
+        QTimer::singleShot(0, this, [this, account]() {
+            Q_EMIT tokensRefreshed(account, KGAPI2::AuthError, tr("Can't refresh tokens without client credentials and refresh token"));
+        });
+        return;
+    }
+
+    const QString refreshToken = account->refreshToken();
+    auto pending = d->pendingRefreshes.find(refreshToken);
+    if (pending != d->pendingRefreshes.end()) {
+        if (!pending->contains(account)) {
+            pending->append(account);
+        }
+        qCDebug(KGAPIDebug) << "Tokens of" << account->accountName() << "are already being refreshed";
+        return;
+    }
+
+    d->pendingRefreshes.insert(refreshToken, {account});
+    QMutexLocker locker(&d->lock);
+    // The job refreshes a copy, the accounts are updated under the lock once it's done
+    auto job = new RefreshTokensJob(AccountPtr::create(*account), d->apiKey, d->apiSecret, this);
+    locker.unlock();
+    connect(job, &Job::finished, this, [this, refreshToken](Job *job) {
+        d->refreshFinished(refreshToken, static_cast<RefreshTokensJob *>(job));
+    });
+}
+
+#include "moc_tokenmanager.cpp"
@@ -0,0 +1,126 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QObject>
+#include <QScopedPointer>
+
+#include "kgapicore_export.h"
+#include "types.h"
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile tokenmanager.h
+ * @brief Refreshes access tokens of accounts used by running jobs
+ *
+ * Once client credentials are set, jobs no longer fail when the access token
+ * of their account expires. A job refreshes the token before sending a request
+ * when the token is about to expire, and when a request is rejected as
+ * unauthorized, the job refreshes the token and sends the request again.
+ *
+ * Concurrent refreshes of the same account, for example by many jobs that
+ * share the account, are coalesced into a single request to the server.
+ * Accounts are considered the same when they have the same refresh token.
+ *
+ * The manager lives in the thread of QCoreApplication and can be used from
+ * jobs in any thread. Tokens of accounts shared by jobs in several threads
+ * should be read through accessToken() and expireDateTime(), which are
+ * synchronized with the refreshes.
+ *
+ * @since 6.1
+ */
+class KGAPICORE_EXPORT TokenManager : public QObject
+{
+    Q_OBJECT
+public:
+    ~TokenManager() override;
+
+    static TokenManager *instance();
+
+    /**
+     * @brief Sets client credentials used to refresh tokens
+     *
+     * Tokens are refreshed automatically only after the credentials have been
+     * set. Passing empty credentials disables the automatic refreshing again.
+     *
+     * @param apiKey Client ID of the application
+     * @param apiSecret Client secret of the application
+     */
+    void setClientCredentials(const QString &apiKey, const QString &apiSecret);
+
+    /**
+     * @brief Returns whether tokens are refreshed automatically
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief Sets how many seconds before expiration tokens are refreshed
+     *
+     * Default is 300 seconds.
+     */
+    void setRefreshMargin(int seconds);
+    [[nodiscard]] int refreshMargin() const;
+
+    /**
+     * @brief Returns whether access token of @p account is about to expire
+     *
+     * Always returns false when automatic refreshing is disabled, or when
+     * the @p account has no refresh token or no known expiration time.
+     */
+    [[nodiscard]] bool needsRefresh(const AccountPtr &account) const;
+
+    /**
+     * @brief Refreshes access token of @p account
+     *
+     * When the token of the same account is already being refreshed, no new
+     * request is sent and @p account is updated once the pending refresh
+     * finishes. The tokensRefreshed() signal is emitted when done.
+     */
+    void refreshTokens(const AccountPtr &account);
+
+    /**
+     * @brief Returns access token of @p account
+     *
+     * Unlike Account::accessToken(), this is safe to call while the token
+     * is being refreshed in another thread.
+     */
+    [[nodiscard]] QString accessToken(const AccountPtr &account) const;
+
+    /**
+     * @brief Returns expiration time of access token of @p account
+     *
+     * Unlike Account::expireDateTime(), this is safe to call while the token
+     * is being refreshed in another thread.
+     */
+    [[nodiscard]] QDateTime expireDateTime(const AccountPtr &account) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when refreshing of tokens of @p account has finished
+     *
+     * @param account The account whose tokens have been refreshed
+     * @param error KGAPI2::NoError on success, the error of the refresh otherwise
+     * @param errorString Description of the error
+     */
+    void tokensRefreshed(const KGAPI2::AccountPtr &account, KGAPI2::Error error, const QString &errorString);
+
+private:
+    explicit TokenManager(QObject *parent = nullptr);
+    Q_DISABLE_COPY(TokenManager)
+
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+    friend class TokenManagerHolder;
+};
+
+} // namespace KGAPI2
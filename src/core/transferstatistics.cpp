@@ -0,0 +1,80 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "transferstatistics.h"
+
+#include <atomic>
+
+using namespace KGAPI2;
+
+class Q_DECL_HIDDEN TransferStatistics::Private
+{
+public:
+    std::atomic<qint64> compressedResponseBytes = 0;
+    std::atomic<qint64> decompressedResponseBytes = 0;
+    std::atomic<qint64> compressedRequestBytes = 0;
+    std::atomic<qint64> uncompressedRequestBytes = 0;
+};
+
+TransferStatistics::TransferStatistics()
+    : d(new Private)
+{
+}
+
+TransferStatistics::~TransferStatistics() = default;
+
+TransferStatistics *TransferStatistics::instance()
+{
+    static TransferStatistics sInstance;
+    return &sInstance;
+}
+
+qint64 TransferStatistics::compressedResponseBytes() const
+{
+    return d->compressedResponseBytes;
+}
+
+qint64 TransferStatistics::decompressedResponseBytes() const
+{
+    return d->decompressedResponseBytes;
+}
+
+qint64 TransferStatistics::compressedRequestBytes() const
+{
+    return d->compressedRequestBytes;
+}
+
+qint64 TransferStatistics::uncompressedRequestBytes() const
+{
+    return d->uncompressedRequestBytes;
+}
+
+qint64 TransferStatistics::bytesSaved() const
+{
+    return (d->decompressedResponseBytes - d->compressedResponseBytes) + (d->uncompressedRequestBytes - d->compressedRequestBytes);
+}
+
+void TransferStatistics::reset()
+{
+    d->compressedResponseBytes = 0;
+    d->decompressedResponseBytes = 0;
+    d->compressedRequestBytes = 0;
+    d->uncompressedRequestBytes = 0;
+}
+
+void TransferStatistics::addResponse(qint64 compressed, qint64 decompressed)
+{
+    d->compressedResponseBytes += compressed;
+    d->decompressedResponseBytes += decompressed;
+}
+
+void TransferStatistics::addRequest(qint64 uncompressed, qint64 compressed)
+{
+    d->uncompressedRequestBytes += uncompressed;
+    d->compressedRequestBytes += compressed;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QtGlobal>
+
+#include "kgapicore_export.h"
+
+namespace KGAPI2
+{
+
+/**
+ * @headerfile transferstatistics.h
+ * @brief Counts how much data compression saves on transfers of all jobs
+ *
+ * Jobs ask the server to compress replies and, when enabled with
+ * Job::setRequestCompressionThreshold(), compress large request bodies.
+ * The counters only include bodies that have actually been compressed.
+ *
+ * The class is thread-safe.
+ *
+ * @since 6.1
+ */
+class KGAPICORE_EXPORT TransferStatistics
+{
+public:
+    ~TransferStatistics();
+
+    static TransferStatistics *instance();
+
+    /**
+     * @brief Size of compressed reply bodies as received from the server
+     */
+    [[nodiscard]] qint64 compressedResponseBytes() const;
+
+    /**
+     * @brief Size of the compressed reply bodies once decompressed
+     */
+    [[nodiscard]] qint64 decompressedResponseBytes() const;
+
+    /**
+     * @brief Size of compressed request bodies as sent to the server
+     */
+    [[nodiscard]] qint64 compressedRequestBytes() const;
+
+    /**
+     * @brief Size of the compressed request bodies before compression
+     */
+    [[nodiscard]] qint64 uncompressedRequestBytes() const;
+
+    /**
+     * @brief Amount of bytes that did not have to be transferred thanks to compression
+     */
+    [[nodiscard]] qint64 bytesSaved() const;
+
+    /**
+     * @brief Resets all counters to zero
+     */
+    void reset();
+
+    /**
+     * @brief Counts a reply body of @p compressed bytes that decompressed to @p decompressed bytes
+     *
+     * Used by Job.
+     */
+    void addResponse(qint64 compressed, qint64 decompressed);
+
+    /**
+     * @brief Counts a request body of @p uncompressed bytes that was sent as @p compressed bytes
+     *
+     * Used by Job.
+     */
+    void addRequest(qint64 uncompressed, qint64 compressed);
+
+private:
+    TransferStatistics();
+    Q_DISABLE_COPY(TransferStatistics)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace KGAPI2
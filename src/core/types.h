@@ -190,6 +190,7 @@ enum Error {
     OK = 200, ///< Request successfully executed.
     Created = 201, ///< Create request successfully executed.
     NoContent = 204, ///< Tasks API returns 204 when task is successfully removed.
+    PartialContent = 206, ///< Only the requested range of the content has been returned. @since 6.1
     ResumeIncomplete = 308, ///< Drive Api returns 308 when accepting a partial file upload
     TemporarilyMoved = 302, ///< The object is located on a different URL provided in reply.
     NotModified = 304, ///< Request was successful, but no data were updated.
@@ -200,8 +201,12 @@ enum Error {
     NotFound = 404, ///< Requested object was not found on the remote side.
     Conflict = 409, ///< Object on the remote site differs from the submitted one. @see KGAPI2::Object::setEtag.
     Gone = 410, ///< The requested data does not exist anymore on the remote site.
+    RangeNotSatisfiable = 416, ///< The requested range lies outside of the content. @since 6.1
+    TooManyRequests = 429, ///< Rate limit of the API has been exceeded, the request should be sent again later. @since 6.1
     InternalError = 500, ///< An unexpected error occurred on the Google service.
-    QuotaExceeded = 503 ///< User quota has been exceeded, the request should be sent again later.
+    BadGateway = 502, ///< The Google service is temporarily unavailable. @since 6.1
+    QuotaExceeded = 503, ///< User quota has been exceeded, the request should be sent again later.
+    GatewayTimeout = 504 ///< The Google service did not respond in time. @since 6.1
 };
 
 /**
@@ -5,14 +5,29 @@
 */
 
 #include "app.h"
+#include "private/jsonreader_p.h"
 #include "utils_p.h"
 
-#include <QJsonDocument>
-#include <QVariantMap>
-
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+
+QStringList readStringList(JsonReader &reader)
+{
+    QStringList list;
+    if (reader.beginArray()) {
+        while (reader.hasNext()) {
+            list << reader.readString();
+        }
+        reader.endArray();
+    }
+    return list;
+}
+
+}
+
 class Q_DECL_HIDDEN App::Icon::Private
 {
 public:
@@ -24,6 +39,7 @@ public:
     QUrl iconUrl;
 
     static Category categoryFromName(const QString &categoryName);
+    static IconPtr fromJSON(JsonReader &reader);
 };
 
 App::Icon::Private::Private()
@@ -50,6 +66,34 @@ App::Icon::Category App::Icon::Private::categoryFromName(const QString &category
     }
 }
 
+App::IconPtr App::Icon::Private::fromJSON(JsonReader &reader)
+{
+    static const JsonFieldTable<Icon::Private> fields{
+        {"category",
+         [](JsonReader &reader, Icon::Private &icon) {
+             icon.category = categoryFromName(reader.readString());
+         }},
+        {"size",
+         [](JsonReader &reader, Icon::Private &icon) {
+             icon.size = int(reader.readInteger());
+         }},
+        {"iconUrl",
+         [](JsonReader &reader, Icon::Private &icon) {
+             icon.iconUrl = QUrl(reader.readString());
+         }},
+    };
+
+    IconPtr icon(new Icon());
+    // Values of missing members, as they were when converted from a QVariantMap
+    icon->d->category = UndefinedCategory;
+    icon->d->size = 0;
+    if (!fields.read(reader, *icon->d)) {
+        return IconPtr();
+    }
+
+    return icon;
+}
+
 App::Icon::Icon()
     : d(new Private)
 {
@@ -111,7 +155,7 @@ public:
     QStringList secondaryFileExtensions;
     IconsList icons;
 
-    static AppPtr fromJSON(const QVariantMap &map);
+    static AppPtr fromJSON(JsonReader &reader);
 };
 
 App::Private::Private()
@@ -141,41 +185,97 @@ App::Private::Private(const App::Private &other)
 {
 }
 
-AppPtr App::Private::fromJSON(const QVariantMap &map)
-{
-    if (!map.contains(QLatin1StringView("kind")) || map[QStringLiteral("kind")].toString() != QLatin1StringView("drive#app")) {
+AppPtr App::Private::fromJSON(JsonReader &reader)
+{
+    struct AppData {
+        AppPtr app;
+        QString kind;
+    };
+
+    static const JsonFieldTable<AppData> fields{
+        {"kind",
+         [](JsonReader &reader, AppData &data) {
+             data.kind = reader.readString();
+         }},
+        {"etag",
+         [](JsonReader &reader, AppData &data) {
+             data.app->setEtag(reader.readString());
+         }},
+        {"id",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->id = reader.readString();
+         }},
+        {"name",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->name = reader.readString();
+         }},
+        {"objectType",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->objectType = reader.readString();
+         }},
+        {"supportsCreate",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->supportsCreate = reader.readBool();
+         }},
+        {"supportsImport",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->supportsImport = reader.readBool();
+         }},
+        {"installed",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->installed = reader.readBool();
+         }},
+        {"authorized",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->authorized = reader.readBool();
+         }},
+        {"useByDefault",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->useByDefault = reader.readBool();
+         }},
+        {"productUrl",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->productUrl = QUrl(reader.readString());
+         }},
+        {"primaryMimeTypes",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->primaryMimeTypes = readStringList(reader);
+         }},
+        {"secondaryMimeTypes",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->secondaryMimeTypes = readStringList(reader);
+         }},
+        {"primaryFileExtensions",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->primaryFileExtensions = readStringList(reader);
+         }},
+        {"secondaryFileExtensions",
+         [](JsonReader &reader, AppData &data) {
+             data.app->d->secondaryFileExtensions = readStringList(reader);
+         }},
+        {"icons",
+         [](JsonReader &reader, AppData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     const IconPtr icon = Icon::Private::fromJSON(reader);
+
+                     if (!icon.isNull()) {
+                         data.app->d->icons << icon;
+                     }
+                 }
+                 reader.endArray();
+             }
+         }},
+    };
+
+    AppData data;
+    data.app.reset(new App);
+
+    if (!fields.read(reader, data) || data.kind != QLatin1StringView("drive#app")) {
         return AppPtr();
     }
 
-    AppPtr app(new App);
-    app->setEtag(map[QStringLiteral("etag")].toString());
-    app->d->id = map[QStringLiteral("id")].toString();
-    app->d->name = map[QStringLiteral("map")].toString();
-    app->d->objectType = map[QStringLiteral("objectType")].toString();
-    app->d->supportsCreate = map[QStringLiteral("supportsCreate")].toBool();
-    app->d->supportsImport = map[QStringLiteral("supportsImport")].toBool();
-    app->d->installed = map[QStringLiteral("installed")].toBool();
-    app->d->authorized = map[QStringLiteral("authorized")].toBool();
-    app->d->useByDefault = map[QStringLiteral("useByDefault")].toBool();
-    app->d->productUrl = map[QStringLiteral("productUrl")].toUrl();
-    app->d->primaryMimeTypes = map[QStringLiteral("primaryMimeTypes")].toStringList();
-    app->d->secondaryMimeTypes = map[QStringLiteral("secondaryMimeTypes")].toStringList();
-    app->d->primaryFileExtensions = map[QStringLiteral("primaryFileExtensions")].toStringList();
-    app->d->secondaryFileExtensions = map[QStringLiteral("secondaryFileExtensions")].toStringList();
-
-    const QVariantList icons = map[QStringLiteral("icons")].toList();
-    for (const QVariant &i : icons) {
-        const QVariantMap &iconData = i.toMap();
-
-        IconPtr icon(new Icon());
-        icon->d->category = Icon::Private::categoryFromName(iconData[QStringLiteral("category")].toString());
-        icon->d->size = iconData[QStringLiteral("size")].toInt();
-        icon->d->iconUrl = iconData[QStringLiteral("iconUrl")].toUrl();
-
-        app->d->icons << icon;
-    }
-
-    return app;
+    return data.app;
 }
 
 App::App()
@@ -290,35 +390,42 @@ App::IconsList App::icons() const
 
 AppPtr App::fromJSON(const QByteArray &jsonData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
-        return AppPtr();
-    }
-    const QVariant data = document.toVariant();
-    return Private::fromJSON(data.toMap());
+    JsonReader reader(jsonData);
+    return Private::fromJSON(reader);
 }
 
 AppsList App::fromJSONFeed(const QByteArray &jsonData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
+    struct AppFeedData {
+        QString kind;
+        AppsList items;
+    };
+
+    static const JsonFieldTable<AppFeedData> fields{
+        {"kind",
+         [](JsonReader &reader, AppFeedData &feed) {
+             feed.kind = reader.readString();
+         }},
+        {"items",
+         [](JsonReader &reader, AppFeedData &feed) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     const AppPtr app = Private::fromJSON(reader);
+
+                     if (!app.isNull()) {
+                         feed.items << app;
+                     }
+                 }
+                 reader.endArray();
+             }
+         }},
+    };
+
+    JsonReader reader(jsonData);
+    AppFeedData feed;
+    if (!fields.read(reader, feed) || feed.kind != QLatin1StringView("drive#appList")) {
         return AppsList();
     }
-    const QVariant data = document.toVariant();
-    const QVariantMap map = data.toMap();
-    if (!map.contains(QLatin1StringView("kind")) || map[QStringLiteral("kind")].toString() != QLatin1StringView("drive#appList")) {
-        return AppsList();
-    }
-
-    AppsList list;
-    const QVariantList items = map[QStringLiteral("items")].toList();
-    for (const QVariant &item : items) {
-        const AppPtr app = Private::fromJSON(item.toMap());
-
-        if (!app.isNull()) {
-            list << app;
-        }
-    }
 
-    return list;
+    return feed.items;
 }
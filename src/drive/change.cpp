@@ -6,11 +6,13 @@
 
 #include "change.h"
 #include "file_p.h"
+#include "private/jsonreader_p.h"
 #include "utils_p.h"
 
-#include <QJsonDocument>
 #include <QVariantMap>
 
+#include <optional>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
@@ -27,6 +29,7 @@ public:
     FilePtr file;
 
     static ChangePtr fromJSON(const QVariantMap &map);
+    static ChangePtr fromJSON(JsonReader &reader);
 };
 
 Change::Private::Private()
@@ -58,6 +61,52 @@ ChangePtr Change::Private::fromJSON(const QVariantMap &map)
     return change;
 }
 
+ChangePtr Change::Private::fromJSON(JsonReader &reader)
+{
+    struct ChangeData {
+        ChangePtr change;
+        QString kind;
+    };
+
+    static const JsonFieldTable<ChangeData> fields{
+        {"kind",
+         [](JsonReader &reader, ChangeData &data) {
+             data.kind = reader.readString();
+         }},
+        {"id",
+         [](JsonReader &reader, ChangeData &data) {
+             data.change->d->id = reader.readInteger();
+         }},
+        {"fileId",
+         [](JsonReader &reader, ChangeData &data) {
+             data.change->d->fileId = reader.readString();
+         }},
+        {"selfLink",
+         [](JsonReader &reader, ChangeData &data) {
+             data.change->d->selfLink = QUrl(reader.readString());
+         }},
+        {"deleted",
+         [](JsonReader &reader, ChangeData &data) {
+             data.change->d->deleted = reader.readBool();
+         }},
+        {"file",
+         [](JsonReader &reader, ChangeData &data) {
+             data.change->d->file = File::Private::fromJSON(reader);
+         }},
+    };
+
+    ChangeData data;
+    data.change.reset(new Change);
+    // Value of a missing id, as it was when converted from a QVariantMap
+    data.change->d->id = 0;
+
+    if (!fields.read(reader, data) || data.kind != QLatin1StringView("drive#change")) {
+        return ChangePtr();
+    }
+
+    return data.change;
+}
+
 Change::Change()
     : KGAPI2::Object()
     , d(new Private)
@@ -116,41 +165,51 @@ FilePtr Change::file() const
 
 ChangePtr Change::fromJSON(const QByteArray &jsonData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
-        return ChangePtr();
-    }
-
-    const QVariant data = document.toVariant();
-    return Private::fromJSON(data.toMap());
+    JsonReader reader(jsonData);
+    return Private::fromJSON(reader);
 }
 
 ChangesList Change::fromJSONFeed(const QByteArray &jsonData, FeedData &feedData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
-        return ChangesList();
-    }
-
-    const QVariant data = document.toVariant();
-    const QVariantMap map = data.toMap();
-    if (!map.contains(QLatin1StringView("kind")) || map[QStringLiteral("kind")].toString() != QLatin1StringView("drive#changeList")) {
+    struct ChangeFeedData {
+        QString kind;
+        std::optional<QUrl> nextLink;
+        ChangesList items;
+    };
+
+    static const JsonFieldTable<ChangeFeedData> fields{
+        {"kind",
+         [](JsonReader &reader, ChangeFeedData &feed) {
+             feed.kind = reader.readString();
+         }},
+        {"nextLink",
+         [](JsonReader &reader, ChangeFeedData &feed) {
+             feed.nextLink = QUrl(reader.readString());
+         }},
+        {"items",
+         [](JsonReader &reader, ChangeFeedData &feed) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     const ChangePtr change = Private::fromJSON(reader);
+
+                     if (!change.isNull()) {
+                         feed.items << change;
+                     }
+                 }
+                 reader.endArray();
+             }
+         }},
+    };
+
+    JsonReader reader(jsonData);
+    ChangeFeedData feed;
+    if (!fields.read(reader, feed) || feed.kind != QLatin1StringView("drive#changeList")) {
         return ChangesList();
     }
 
-    if (map.contains(QLatin1StringView("nextLink"))) {
-        feedData.nextPageUrl = map[QStringLiteral("nextLink")].toUrl();
-    }
-
-    ChangesList list;
-    const QVariantList items = map[QStringLiteral("items")].toList();
-    for (const QVariant &item : items) {
-        const ChangePtr change = Private::fromJSON(item.toMap());
-
-        if (!change.isNull()) {
-            list << change;
-        }
+    if (feed.nextLink.has_value()) {
+        feedData.nextPageUrl = *feed.nextLink;
     }
 
-    return list;
+    return feed.items;
 }
@@ -155,6 +155,7 @@ void ChangeFetchJob::start()
         }
         query.addQueryItem(QStringLiteral("includeItemsFromAllDrives"), Utils::bool2Str(d->includeItemsFromAllDrives));
         url.setQuery(query);
+        enablePipelinedPagination(QStringLiteral("nextLink"), QString());
     } else {
         url = DriveService::fetchChangeUrl(d->changeId);
     }
@@ -189,11 +190,6 @@ ObjectsList ChangeFetchJob::handleReplyWithItems(const QNetworkReply *reply, con
         return items;
     }
 
-    if (feedData.nextPageUrl.isValid()) {
-        QNetworkRequest request(feedData.nextPageUrl);
-        enqueueRequest(request);
-    }
-
     return items;
 }
 
@@ -309,6 +309,13 @@ QUrl fetchTeamdrivesUrl()
     return url;
 }
 
+QUrl batchUrl()
+{
+    QUrl url(Private::GoogleApisUrl);
+    url.setPath(QStringLiteral("/batch/drive/v2"));
+    return url;
+}
+
 } // namespace DriveService
 
 } // namespace KGAPI2
@@ -99,6 +99,13 @@ KGAPIDRIVE_EXPORT QUrl fetchTeamdriveUrl(const QString &teamdriveId);
 
 KGAPIDRIVE_EXPORT QUrl fetchTeamdrivesUrl();
 
+/**
+ * @brief Returns URL of the Drive API batch endpoint.
+ *
+ * @since 6.1
+ */
+KGAPIDRIVE_EXPORT QUrl batchUrl();
+
 } // namespace DriveService
 
 } // namespace KGAPI2
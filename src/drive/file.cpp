@@ -9,11 +9,14 @@
 #include "file_p.h"
 #include "parentreference_p.h"
 #include "permission_p.h"
+#include "private/jsonreader_p.h"
 #include "user.h"
 #include "utils_p.h"
 
 #include <QJsonDocument>
 
+#include <optional>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
@@ -726,6 +729,260 @@ FilePtr File::Private::fromJSON(const QVariantMap &map)
     return file;
 }
 
+FilePtr File::Private::fromJSON(JsonReader &reader)
+{
+    struct FileData {
+        FilePtr file;
+        QString kind;
+    };
+
+    static const JsonFieldTable<FileData> fields{
+        {"kind",
+         [](JsonReader &reader, FileData &data) {
+             data.kind = reader.readString();
+         }},
+        {"etag",
+         [](JsonReader &reader, FileData &data) {
+             data.file->setEtag(reader.readString());
+         }},
+        {"id",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->id = reader.readString();
+         }},
+        {"selfLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->selfLink = QUrl(reader.readString());
+         }},
+        {"title",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->title = reader.readString();
+         }},
+        {"mimeType",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->mimeType = reader.readString();
+         }},
+        {"description",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->description = reader.readString();
+         }},
+        {"labels",
+         [](JsonReader &reader, FileData &data) {
+             static const JsonFieldTable<File::Labels::Private> labelFields{
+                 {"starred",
+                  [](JsonReader &reader, File::Labels::Private &labels) {
+                      labels.starred = reader.readBool();
+                  }},
+                 {"hidden",
+                  [](JsonReader &reader, File::Labels::Private &labels) {
+                      labels.hidden = reader.readBool();
+                  }},
+                 {"trashed",
+                  [](JsonReader &reader, File::Labels::Private &labels) {
+                      labels.trashed = reader.readBool();
+                  }},
+                 {"restricted",
+                  [](JsonReader &reader, File::Labels::Private &labels) {
+                      labels.restricted = reader.readBool();
+                  }},
+                 {"viewed",
+                  [](JsonReader &reader, File::Labels::Private &labels) {
+                      labels.viewed = reader.readBool();
+                  }},
+             };
+
+             File::LabelsPtr labels(new File::Labels());
+             labelFields.read(reader, *labels->d);
+             data.file->d->labels = labels;
+         }},
+        {"createdDate",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->createdDate = QDateTime::fromString(reader.readString(), Qt::ISODate);
+         }},
+        {"modifiedDate",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->modifiedDate = QDateTime::fromString(reader.readString(), Qt::ISODate);
+         }},
+        {"modifiedByMeDate",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->modifiedByMeDate = QDateTime::fromString(reader.readString(), Qt::ISODate);
+         }},
+        {"downloadUrl",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->downloadUrl = QUrl(reader.readString());
+         }},
+        {"indexableText",
+         [](JsonReader &reader, FileData &data) {
+             File::IndexableTextPtr indexableText(new File::IndexableText());
+             if (reader.beginObject()) {
+                 while (reader.hasNext()) {
+                     if (reader.nextName() == "text") {
+                         indexableText->d->text = reader.readString();
+                     } else {
+                         reader.skipValue();
+                     }
+                 }
+                 reader.endObject();
+             }
+             data.file->d->indexableText = indexableText;
+         }},
+        {"userPermission",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->userPermission = Permission::Private::fromJSON(reader.readVariant().toMap());
+         }},
+        {"fileExtension",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->fileExtension = reader.readString();
+         }},
+        {"md5Checksum",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->md5Checksum = reader.readString();
+         }},
+        {"fileSize",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->fileSize = reader.readInteger();
+         }},
+        {"alternateLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->alternateLink = QUrl(reader.readString());
+         }},
+        {"embedLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->embedLink = QUrl(reader.readString());
+         }},
+        {"version",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->version = reader.readInteger();
+         }},
+        {"sharedWithMeDate",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->sharedWithMeDate = QDateTime::fromString(reader.readString(), Qt::ISODate);
+         }},
+        {"parents",
+         [](JsonReader &reader, FileData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     data.file->d->parents << ParentReference::Private::fromJSON(reader.readVariant().toMap());
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"exportLinks",
+         [](JsonReader &reader, FileData &data) {
+             if (reader.beginObject()) {
+                 while (reader.hasNext()) {
+                     const QString format = QString::fromUtf8(reader.nextName());
+                     data.file->d->exportLinks.insert(format, QUrl(reader.readString()));
+                 }
+                 reader.endObject();
+             }
+         }},
+        {"originalFileName",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->originalFileName = reader.readString();
+         }},
+        {"quotaBytesUsed",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->quotaBytesUsed = reader.readInteger();
+         }},
+        {"ownerNames",
+         [](JsonReader &reader, FileData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     data.file->d->ownerNames << reader.readString();
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"lastModifyingUserName",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->lastModifyingUserName = reader.readString();
+         }},
+        {"editable",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->editable = reader.readBool();
+         }},
+        {"writersCanShare",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->writersCanShare = reader.readBool();
+         }},
+        {"thumbnailLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->thumbnailLink = QUrl(reader.readString());
+         }},
+        {"lastViewedByMeDate",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->lastViewedByMeDate = QDateTime::fromString(reader.readString(), Qt::ISODate);
+         }},
+        {"webContentLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->webContentLink = QUrl(reader.readString());
+         }},
+        {"explicitlyTrashed",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->explicitlyTrashed = reader.readBool();
+         }},
+        {"imageMediaMetadata",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->imageMediaMetadata = File::ImageMediaMetadataPtr(new File::ImageMediaMetadata(reader.readVariant().toMap()));
+         }},
+        {"thumbnail",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->thumbnail = File::ThumbnailPtr(new File::Thumbnail(reader.readVariant().toMap()));
+         }},
+        {"webViewLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->webViewLink = QUrl(reader.readString());
+         }},
+        {"iconLink",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->iconLink = QUrl(reader.readString());
+         }},
+        {"shared",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->shared = reader.readBool();
+         }},
+        {"owners",
+         [](JsonReader &reader, FileData &data) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     data.file->d->owners << User::fromJSON(reader.readVariant().toMap());
+                 }
+                 reader.endArray();
+             }
+         }},
+        {"lastModifyingUser",
+         [](JsonReader &reader, FileData &data) {
+             data.file->d->lastModifyingUser = User::fromJSON(reader.readVariant().toMap());
+         }},
+    };
+
+    FileData data;
+    data.file.reset(new File());
+    // Values of missing fields, as they were when converted from a QVariantMap
+    data.file->d->fileSize = 0;
+    data.file->d->version = 0;
+    data.file->d->quotaBytesUsed = 0;
+
+    if (!fields.read(reader, data) || data.kind != QLatin1StringView("drive#file")) {
+        return FilePtr();
+    }
+
+    if (!data.file->d->labels) {
+        data.file->d->labels = File::LabelsPtr(new File::Labels());
+    }
+    if (!data.file->d->indexableText) {
+        data.file->d->indexableText = File::IndexableTextPtr(new File::IndexableText());
+    }
+    if (!data.file->d->imageMediaMetadata) {
+        data.file->d->imageMediaMetadata = File::ImageMediaMetadataPtr(new File::ImageMediaMetadata(QVariantMap()));
+    }
+    if (!data.file->d->thumbnail) {
+        data.file->d->thumbnail = File::ThumbnailPtr(new File::Thumbnail(QVariantMap()));
+    }
+
+    return data.file;
+}
+
 File::File()
     : KGAPI2::Object()
     , d(new Private)
@@ -1032,12 +1289,8 @@ const QString File::Fields::Permissions = QStringLiteral("permissions");
 
 FilePtr File::fromJSON(const QByteArray &jsonData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
-        return FilePtr();
-    }
-    const QVariant data = document.toVariant();
-    return Private::fromJSON(data.toMap());
+    JsonReader reader(jsonData);
+    return Private::fromJSON(reader);
 }
 
 FilePtr File::fromJSON(const QVariantMap &jsonData)
@@ -1050,31 +1303,47 @@ FilePtr File::fromJSON(const QVariantMap &jsonData)
 
 FilesList File::fromJSONFeed(const QByteArray &jsonData, FeedData &feedData)
 {
-    QJsonDocument document = QJsonDocument::fromJson(jsonData);
-    if (document.isNull()) {
+    struct FileFeedData {
+        QString kind;
+        std::optional<QUrl> nextLink;
+        FilesList items;
+    };
+
+    static const JsonFieldTable<FileFeedData> fields{
+        {"kind",
+         [](JsonReader &reader, FileFeedData &feed) {
+             feed.kind = reader.readString();
+         }},
+        {"nextLink",
+         [](JsonReader &reader, FileFeedData &feed) {
+             feed.nextLink = QUrl(reader.readString());
+         }},
+        {"items",
+         [](JsonReader &reader, FileFeedData &feed) {
+             if (reader.beginArray()) {
+                 while (reader.hasNext()) {
+                     const FilePtr file = Private::fromJSON(reader);
+
+                     if (!file.isNull()) {
+                         feed.items << file;
+                     }
+                 }
+                 reader.endArray();
+             }
+         }},
+    };
+
+    JsonReader reader(jsonData);
+    FileFeedData feed;
+    if (!fields.read(reader, feed) || feed.kind != QLatin1StringView("drive#fileList")) {
         return FilesList();
     }
-    const QVariant data = document.toVariant();
-    const QVariantMap map = data.toMap();
-    if (!map.contains(File::Fields::Kind) || map[Fields::Kind].toString() != QLatin1StringView("drive#fileList")) {
-        return FilesList();
-    }
-
-    FilesList list;
-    const QVariantList items = map[File::Fields::Items].toList();
-    for (const QVariant &item : items) {
-        const FilePtr file = Private::fromJSON(item.toMap());
-
-        if (!file.isNull()) {
-            list << file;
-        }
-    }
 
-    if (map.contains(File::Fields::NextLink)) {
-        feedData.nextPageUrl = map[File::Fields::NextLink].toUrl();
+    if (feed.nextLink.has_value()) {
+        feedData.nextPageUrl = *feed.nextLink;
     }
 
-    return list;
+    return feed.items;
 }
 
 QByteArray File::toJSON(const FilePtr &file, SerializationOptions options)
@@ -13,6 +13,8 @@
 namespace KGAPI2
 {
 
+class JsonReader;
+
 namespace Drive
 {
 
@@ -62,6 +64,7 @@ public:
     UserPtr lastModifyingUser;
 
     static FilePtr fromJSON(const QVariantMap &map);
+    static FilePtr fromJSON(JsonReader &reader);
 };
 
 } // namespace Drive
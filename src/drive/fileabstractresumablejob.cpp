@@ -10,17 +10,32 @@
 #include "debug.h"
 #include "utils.h"
 
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMimeDatabase>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QUrlQuery>
 
+#include <limits>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
 namespace
 {
-static const int ChunkSize = 262144;
+// Size of all chunks but the last one must be a multiple of this
+static const qint64 ChunkGranularity = 256 * 1024;
+static const qint64 MinChunkSize = ChunkGranularity;
+static const qint64 MaxChunkSize = 128 * ChunkGranularity;
+// Chunk size is adjusted so that uploading a chunk takes about this long
+static const qint64 TargetChunkDuration = 2000;
+// How many times in a row to try to recover from an interrupted chunk upload
+static const int MaxRetries = 5;
+
+static const auto SessionTokenSession = QStringLiteral("session");
+static const auto SessionTokenSize = QStringLiteral("size");
 }
 
 class Q_DECL_HIDDEN FileAbstractResumableJob::Private
@@ -28,22 +43,39 @@ class Q_DECL_HIDDEN FileAbstractResumableJob::Private
 public:
     Private(FileAbstractResumableJob *parent);
     void startUploadSession();
-    void uploadChunk(bool lastChunk);
+    void queryUploadStatus();
+    void uploadChunk();
     void processNext();
-    void readFromDevice();
+    bool readFromDevice();
+    bool acknowledge(qint64 committed);
+    void adaptChunkSize(qint64 uploaded, qint64 elapsed);
+    void emitUploadProgress(qint64 uploaded);
     bool isTotalSizeKnown() const;
 
+    static qint64 parseRange(const QByteArray &range);
+
     void _k_uploadProgress(qint64 bytesSent, qint64 totalBytes);
 
     FilePtr metaData;
     QIODevice *device = nullptr;
+    qint64 deviceStartPos = 0;
 
     QString sessionPath;
-    QList<QByteArray> chunks;
-    int uploadedSize = 0;
-    int totalUploadSize = 0;
-
-    enum SessionState { ReadyStart, Started, ClientEnough, Completed };
+    // Data not yet confirmed by the server, starting at receivedSize - buffer.size()
+    QByteArray buffer;
+    // Amount of bytes received from the device or via write(), including those skipped when resuming
+    qint64 receivedSize = 0;
+    qint64 committedSize = 0;
+    qint64 totalUploadSize = 0;
+    bool clientDone = false;
+
+    qint64 chunkSize = MinChunkSize;
+    // Size of the chunk being uploaded, -1 when querying status of the upload
+    qint64 pendingChunkSize = -1;
+    QElapsedTimer chunkTimer;
+    int retries = 0;
+
+    enum SessionState { ReadyStart, Started, Completed };
 
     SessionState sessionState = ReadyStart;
 
@@ -72,10 +104,10 @@ void FileAbstractResumableJob::Private::startUploadSession()
     QNetworkRequest request(url);
     QByteArray rawData;
     if (!metaData.isNull()) {
-        if (metaData->mimeType().isEmpty() && !chunks.isEmpty()) {
+        if (metaData->mimeType().isEmpty() && !buffer.isEmpty()) {
             // No mimeType set, determine from title and first chunk
             const QMimeDatabase db;
-            const QMimeType mime = db.mimeTypeForFileNameAndData(metaData->title(), chunks.first());
+            const QMimeType mime = db.mimeTypeForFileNameAndData(metaData->title(), buffer);
             const QString contentType = mime.name();
             metaData->setMimeType(contentType);
             qCDebug(KGAPIDebug) << "Metadata mimeType was missing, determined" << contentType;
@@ -93,21 +125,36 @@ void FileAbstractResumableJob::Private::startUploadSession()
     q->enqueueRequest(request, rawData, contentType);
 }
 
-void FileAbstractResumableJob::Private::uploadChunk(bool lastChunk)
+void FileAbstractResumableJob::Private::queryUploadStatus()
 {
+    const QString totalSymbol = isTotalSizeKnown() ? QString::number(totalUploadSize) : QStringLiteral("*");
+    const QString rangeHeader = QStringLiteral("bytes */%1").arg(totalSymbol);
+    qCDebug(KGAPIDebug) << "Querying upload status with Content-Range header" << rangeHeader;
+
+    QNetworkRequest request(QUrl(sessionPath));
+    request.setRawHeader(QByteArray("Content-Range"), rangeHeader.toUtf8());
+    request.setHeader(QNetworkRequest::ContentLengthHeader, 0);
+    pendingChunkSize = -1;
+    q->enqueueRequest(request);
+}
+
+void FileAbstractResumableJob::Private::uploadChunk()
+{
+    const qint64 offset = receivedSize - buffer.size();
+    const bool lastChunk = clientDone && buffer.size() <= chunkSize;
+    const QByteArray partData = buffer.left(chunkSize);
+
     QString rangeHeader;
-    QByteArray partData;
-    if (chunks.isEmpty()) {
+    if (partData.isEmpty()) {
         // We have consumed everything but must send one last request with total file size
-        qCDebug(KGAPIDebug) << "Chunks is empty, sending only final size" << uploadedSize;
-        rangeHeader = QStringLiteral("bytes */%1").arg(uploadedSize);
+        qCDebug(KGAPIDebug) << "No data left, sending only final size" << offset;
+        rangeHeader = QStringLiteral("bytes */%1").arg(offset);
     } else {
-        partData = chunks.takeFirst();
-        // Build range header from saved upload size and new
-        QString tempRangeHeader = QStringLiteral("bytes %1-%2/%3").arg(uploadedSize).arg(uploadedSize + partData.size() - 1);
+        // Build range header from the offset of the chunk and its size
+        QString tempRangeHeader = QStringLiteral("bytes %1-%2/%3").arg(offset).arg(offset + partData.size() - 1);
         if (lastChunk) {
             // Need to send last chunk, therefore final file size is known now
-            tempRangeHeader = tempRangeHeader.arg(uploadedSize + partData.size());
+            tempRangeHeader = tempRangeHeader.arg(offset + partData.size());
         } else {
             // Use star in the case that total upload size in unknown
             QString totalSymbol = isTotalSizeKnown() ? QString::number(totalUploadSize) : QStringLiteral("*");
@@ -122,8 +169,9 @@ void FileAbstractResumableJob::Private::uploadChunk(bool lastChunk)
     QNetworkRequest request(url);
     request.setRawHeader(QByteArray("Content-Range"), rangeHeader.toUtf8());
     request.setHeader(QNetworkRequest::ContentLengthHeader, partData.length());
+    pendingChunkSize = partData.size();
+    chunkTimer.start();
     q->enqueueRequest(request, partData);
-    uploadedSize += partData.size();
 }
 
 void FileAbstractResumableJob::Private::processNext()
@@ -132,30 +180,32 @@ void FileAbstractResumableJob::Private::processNext()
 
     switch (sessionState) {
     case ReadyStart:
-        startUploadSession();
+        if (sessionPath.isEmpty()) {
+            startUploadSession();
+        } else {
+            // Resuming a previous session, find out where to continue from
+            queryUploadStatus();
+        }
         return;
-    case Started: {
-        if (chunks.isEmpty() || chunks.first().size() < ChunkSize) {
-            qCDebug(KGAPIDebug) << "Chunks empty or not big enough to process, asking for more";
+    case Started:
+        while (!clientDone && buffer.size() < chunkSize) {
+            qCDebug(KGAPIDebug) << "Not enough data for a chunk, asking for more";
 
             if (device) {
-                readFromDevice();
+                if (!readFromDevice()) {
+                    q->setError(KGAPI2::UnknownError);
+                    q->setErrorString(tr("Failed reading data to upload"));
+                    q->emitFinished();
+                    return;
+                }
             } else {
                 // Warning: an endless loop could be started here if the signal receiver isn't using
                 // a direct connection.
                 q->emitReadyWrite();
             }
-            processNext();
-            return;
         }
-        uploadChunk(false);
-        return;
-    }
-    case ClientEnough: {
-        uploadChunk(true);
-        sessionState = Completed;
+        uploadChunk();
         return;
-    }
     case Completed:
         qCDebug(KGAPIDebug) << "Nothing left to process, done";
         q->emitFinished();
@@ -163,16 +213,64 @@ void FileAbstractResumableJob::Private::processNext()
     }
 }
 
-void KGAPI2::Drive::FileAbstractResumableJob::Private::readFromDevice()
+bool KGAPI2::Drive::FileAbstractResumableJob::Private::readFromDevice()
 {
-    char buf[ChunkSize];
-    int read = device->read(buf, ChunkSize);
+    QByteArray data(qMax(chunkSize - buffer.size(), ChunkGranularity), Qt::Uninitialized);
+    const qint64 read = device->read(data.data(), data.size());
     if (read == -1) {
         qCWarning(KGAPIDebug) << "Failed reading from device" << device->errorString();
-        return;
+        return false;
     }
     qCDebug(KGAPIDebug) << "Read from device bytes" << read;
-    q->write(QByteArray(buf, read));
+    data.truncate(read);
+    q->write(data);
+    return true;
+}
+
+bool FileAbstractResumableJob::Private::acknowledge(qint64 committed)
+{
+    const qint64 bufferOffset = receivedSize - buffer.size();
+    if (committed < bufferOffset) {
+        // Already released data would have to be sent again
+        qCWarning(KGAPIDebug) << "Server has only" << committed << "bytes, but data from" << bufferOffset << "have been released already";
+        return false;
+    }
+
+    buffer.remove(0, qMin<qint64>(committed - bufferOffset, buffer.size()));
+    committedSize = committed;
+
+    // When resuming, there's no need to read the uploaded part of a random-access device again
+    if (device && !device->isSequential() && receivedSize < committedSize) {
+        qCDebug(KGAPIDebug) << "Seeking device to" << committedSize;
+        if (device->seek(deviceStartPos + committedSize)) {
+            receivedSize = committedSize;
+        }
+    }
+
+    return true;
+}
+
+void FileAbstractResumableJob::Private::adaptChunkSize(qint64 uploaded, qint64 elapsed)
+{
+    // Aim for chunks that take TargetChunkDuration to upload, so that the overhead of
+    // each request is small on fast connections, while a failed chunk doesn't cost too
+    // much on slow ones. Change the size gradually to ride out fluctuations.
+    const qint64 idealSize = uploaded * TargetChunkDuration / qMax<qint64>(elapsed, 1);
+    qint64 size = qBound(chunkSize / 2, idealSize, chunkSize * 2);
+    size -= size % ChunkGranularity;
+    chunkSize = qBound(MinChunkSize, size, MaxChunkSize);
+    qCDebug(KGAPIDebug) << "Uploaded" << uploaded << "bytes in" << elapsed << "ms, chunk size is now" << chunkSize;
+}
+
+void FileAbstractResumableJob::Private::emitUploadProgress(qint64 uploaded)
+{
+    // Job::progress() can only report int values
+    qint64 total = totalUploadSize;
+    while (total > std::numeric_limits<int>::max()) {
+        total >>= 10;
+        uploaded >>= 10;
+    }
+    q->emitProgress(static_cast<int>(uploaded), static_cast<int>(total));
 }
 
 bool FileAbstractResumableJob::Private::isTotalSizeKnown() const
@@ -180,11 +278,27 @@ bool FileAbstractResumableJob::Private::isTotalSizeKnown() const
     return totalUploadSize != 0;
 }
 
+qint64 FileAbstractResumableJob::Private::parseRange(const QByteArray &range)
+{
+    // Range header has form "bytes=0-1234", its absence means that nothing has been received
+    const int dash = range.lastIndexOf('-');
+    if (dash < 0) {
+        return 0;
+    }
+
+    bool ok = false;
+    const qint64 lastByte = range.mid(dash + 1).trimmed().toLongLong(&ok);
+    return ok ? lastByte + 1 : 0;
+}
+
 void FileAbstractResumableJob::Private::_k_uploadProgress(qint64 bytesSent, qint64 totalBytes)
 {
-    // uploadedSize corresponds to total bytes enqueued (including current chunk upload)
-    qint64 totalUploaded = uploadedSize - totalBytes + bytesSent;
-    q->emitProgress(totalUploaded, totalUploadSize);
+    Q_UNUSED(totalBytes)
+
+    // Only report progress of chunks, not of status queries
+    if (pendingChunkSize > 0) {
+        emitUploadProgress(committedSize + bytesSent);
+    }
 }
 
 FileAbstractResumableJob::FileAbstractResumableJob(const AccountPtr &account, QObject *parent)
@@ -222,7 +336,7 @@ FilePtr FileAbstractResumableJob::metadata() const
     return d->metaData;
 }
 
-void FileAbstractResumableJob::setUploadSize(int size)
+void FileAbstractResumableJob::setUploadSize(qint64 size)
 {
     if (isRunning()) {
         qCWarning(KGAPIDebug) << "Can't set upload size when the job is already running";
@@ -232,48 +346,83 @@ void FileAbstractResumableJob::setUploadSize(int size)
     d->totalUploadSize = size;
 }
 
-void FileAbstractResumableJob::write(const QByteArray &data)
+qint64 FileAbstractResumableJob::uploadedSize() const
 {
-    qCDebug(KGAPIDebug) << "Received" << data.size() << "bytes to upload";
+    return d->committedSize;
+}
 
-    if (data.isEmpty()) {
-        qCDebug(KGAPIDebug) << "Data empty, won't receive any more data from client";
-        d->sessionState = Private::ClientEnough;
+QByteArray FileAbstractResumableJob::sessionToken() const
+{
+    if (d->sessionPath.isEmpty()) {
+        return QByteArray();
+    }
+
+    QJsonObject token{{SessionTokenSession, d->sessionPath}};
+    if (d->isTotalSizeKnown()) {
+        token.insert(SessionTokenSize, d->totalUploadSize);
+    }
+    return QJsonDocument(token).toJson(QJsonDocument::Compact);
+}
+
+void FileAbstractResumableJob::setSessionToken(const QByteArray &token)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't set session token when the job is already running";
         return;
     }
 
-    int pos = 0;
-    // Might need to add to last chunk
-    if (!d->chunks.isEmpty() && d->chunks.last().size() < ChunkSize) {
-        QByteArray lastChunk = d->chunks.takeLast();
-        int missing = ChunkSize - lastChunk.size();
-        qCDebug(KGAPIDebug) << "Previous last chunk was" << lastChunk.size() << "bytes and could use" << missing << "bytes more, adding to it";
-        lastChunk.append(data.mid(0, missing));
-        pos = missing;
-        d->chunks << lastChunk;
+    const QJsonObject object = QJsonDocument::fromJson(token).object();
+    const QString sessionPath = object.value(SessionTokenSession).toString();
+    if (sessionPath.isEmpty()) {
+        qCWarning(KGAPIDebug) << "Invalid upload session token" << token;
+        return;
     }
 
-    int dataSize = data.size();
-    QList<QByteArray> chunks;
-    while (pos < dataSize) {
-        QByteArray chunk = data.mid(pos, ChunkSize);
-        chunks << chunk;
-        pos += chunk.size();
+    d->sessionPath = sessionPath;
+    if (object.contains(SessionTokenSize)) {
+        d->totalUploadSize = object.value(SessionTokenSize).toInteger();
+    }
+}
+
+void FileAbstractResumableJob::write(const QByteArray &data)
+{
+    qCDebug(KGAPIDebug) << "Received" << data.size() << "bytes to upload";
+
+    if (data.isEmpty()) {
+        qCDebug(KGAPIDebug) << "Data empty, won't receive any more data from client";
+        d->clientDone = true;
+        return;
     }
 
-    qCDebug(KGAPIDebug) << "Added" << chunks.size() << "new chunks";
-    d->chunks << chunks;
+    // When resuming, skip the data the server has already received
+    const qint64 skip = qBound<qint64>(0, d->committedSize - d->receivedSize, data.size());
+    d->receivedSize += data.size();
+    d->buffer.append(data.constData() + skip, data.size() - skip);
 }
 
 void FileAbstractResumableJob::start()
 {
+    d->buffer.clear();
+    d->receivedSize = 0;
+    d->committedSize = 0;
+    d->clientDone = false;
+    d->chunkSize = MinChunkSize;
+    d->retries = 0;
+    d->sessionState = Private::ReadyStart;
     if (d->device) {
-        d->readFromDevice();
+        d->deviceStartPos = d->device->pos();
     }
-    // Ask for more chunks right away in case
-    // write() wasn't called before starting
-    if (d->chunks.isEmpty()) {
-        emitReadyWrite();
+
+    // When resuming a session, data are only needed once it is known where to continue from
+    if (d->sessionPath.isEmpty()) {
+        if (d->device) {
+            d->readFromDevice();
+        }
+        // Ask for more data right away in case
+        // write() wasn't called before starting
+        if (d->buffer.isEmpty()) {
+            emitReadyWrite();
+        }
     }
     d->processNext();
 }
@@ -286,7 +435,7 @@ void FileAbstractResumableJob::dispatchRequest(QNetworkAccessManager *accessMana
     Q_UNUSED(contentType)
 
     QNetworkReply *reply;
-    if (d->sessionState == Private::ReadyStart) {
+    if (d->sessionPath.isEmpty()) {
         reply = accessManager->post(request, data);
     } else {
         reply = accessManager->put(request, data);
@@ -301,12 +450,9 @@ void FileAbstractResumableJob::dispatchRequest(QNetworkAccessManager *accessMana
 
 void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
-    Q_UNUSED(rawData)
-
     int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 
-    switch (d->sessionState) {
-    case Private::ReadyStart: {
+    if (d->sessionState == Private::ReadyStart && d->sessionPath.isEmpty()) {
         if (replyCode != KGAPI2::OK) {
             qCWarning(KGAPIDebug) << "Failed opening upload session" << replyCode;
             setError(KGAPI2::UnknownError);
@@ -319,62 +465,82 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
         qCDebug(KGAPIDebug) << "Got upload session location" << uploadLocation;
         d->sessionPath = uploadLocation;
         d->sessionState = Private::Started;
-        break;
+        Q_EMIT sessionStarted(this);
+        d->processNext();
+        return;
     }
-    case Private::Started: {
-        // If during upload total size is declared via Content-Range header, Google will
-        // respond with 200 on the last chunk upload. The job is complete in that case.
-        if (d->isTotalSizeKnown() && replyCode == KGAPI2::OK) {
-            d->sessionState = Private::Completed;
-            const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
-            ContentType ct = Utils::stringToContentType(contentType);
-            if (ct == KGAPI2::JSON) {
-                d->metaData = File::fromJSON(rawData);
-            }
-            return;
-        }
-
-        // Google will continue answering ResumeIncomplete until the total upload size is declared
-        // in the Content-Range header or until last upload range not total upload size.
-        if (replyCode != KGAPI2::ResumeIncomplete) {
-            qCWarning(KGAPIDebug) << "Failed uploading chunk" << replyCode;
-            setError(KGAPI2::UnknownError);
-            setErrorString(tr("Failed uploading chunk"));
-            emitFinished();
-            return;
-        }
 
-        // Server could send us a new upload session location any time, use it if present
-        const QString newUploadLocation = reply->header(QNetworkRequest::LocationHeader).toString();
-        if (!newUploadLocation.isEmpty()) {
-            qCDebug(KGAPIDebug) << "Got new location" << newUploadLocation;
-            d->sessionPath = newUploadLocation;
-        }
-
-        const QString readRange = QString::fromUtf8(reply->rawHeader(QStringLiteral("Range").toUtf8()));
-        qCDebug(KGAPIDebug) << "Server confirms range" << readRange;
-        break;
-    }
-    case Private::ClientEnough:
-    case Private::Completed:
-        if (replyCode != KGAPI2::OK) {
-            qCWarning(KGAPIDebug) << "Failed completing upload session" << replyCode;
-            setError(KGAPI2::UnknownError);
-            setErrorString(tr("Failed completing upload session"));
-            emitFinished();
-            return;
+    // Replies to chunk uploads and upload status queries. Once the whole file has
+    // been received, Google responds with the file metadata.
+    if (replyCode == KGAPI2::OK || replyCode == KGAPI2::Created) {
+        d->sessionState = Private::Completed;
+        d->committedSize = qMax(d->committedSize, d->receivedSize);
+        if (d->isTotalSizeKnown()) {
+            d->emitUploadProgress(d->totalUploadSize);
         }
         const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
         ContentType ct = Utils::stringToContentType(contentType);
         if (ct == KGAPI2::JSON) {
             d->metaData = File::fromJSON(rawData);
         }
-        break;
+        d->processNext();
+        return;
+    }
+
+    // Google will continue answering ResumeIncomplete until the total upload size is declared
+    // in the Content-Range header or until last upload range not total upload size.
+    if (replyCode != KGAPI2::ResumeIncomplete) {
+        qCWarning(KGAPIDebug) << "Failed uploading chunk" << replyCode;
+        setError(KGAPI2::UnknownError);
+        setErrorString(tr("Failed uploading chunk"));
+        emitFinished();
+        return;
     }
 
+    // Server could send us a new upload session location any time, use it if present
+    const QString newUploadLocation = reply->header(QNetworkRequest::LocationHeader).toString();
+    if (!newUploadLocation.isEmpty()) {
+        qCDebug(KGAPIDebug) << "Got new location" << newUploadLocation;
+        d->sessionPath = newUploadLocation;
+    }
+
+    // The server may have received less than what has been sent, the rest is sent again
+    const QByteArray readRange = reply->rawHeader("Range");
+    qCDebug(KGAPIDebug) << "Server confirms range" << readRange;
+    const qint64 previousCommittedSize = d->committedSize;
+    if (!d->acknowledge(Private::parseRange(readRange))) {
+        setError(KGAPI2::UnknownError);
+        setErrorString(tr("Upload session has lost already uploaded data"));
+        emitFinished();
+        return;
+    }
+
+    if (d->pendingChunkSize > 0) {
+        d->adaptChunkSize(d->committedSize - previousCommittedSize, d->chunkTimer.elapsed());
+    }
+    d->retries = 0;
+    d->sessionState = Private::Started;
+    if (d->isTotalSizeKnown()) {
+        d->emitUploadProgress(d->committedSize);
+    }
     d->processNext();
 }
 
+bool FileAbstractResumableJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    // A server error or an interrupted connection doesn't mean that the data sent so far
+    // are lost. Ask the server how much of it it has received and continue from there.
+    const bool recoverable = statusCode == 0 || (statusCode >= KGAPI2::InternalError && statusCode < 600);
+    if (!d->sessionPath.isEmpty() && recoverable && d->retries < MaxRetries) {
+        ++d->retries;
+        qCWarning(KGAPIDebug) << "Uploading interrupted with status" << statusCode << ", querying upload status, attempt" << d->retries;
+        d->queryUploadStatus();
+        return true;
+    }
+
+    return FileAbstractDataJob::handleError(statusCode, rawData);
+}
+
 void FileAbstractResumableJob::emitReadyWrite()
 {
     Q_EMIT readyWrite(this);
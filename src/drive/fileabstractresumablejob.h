@@ -32,6 +32,15 @@ namespace Drive
  * Writing 0 bytes will indicate that the File has been completely transferred
  * and the Job will close the upload session.
  *
+ * The size of the chunks adapts to the measured throughput, so that each
+ * chunk takes a few seconds to upload. When uploading of a chunk fails due
+ * to a server or network error, the Job asks the server how much data it has
+ * received and continues from there.
+ *
+ * An interrupted upload can be resumed, even after the application has been
+ * restarted, by storing the sessionToken() and passing it to
+ * setSessionToken() of a new Job that uploads the same data.
+ *
  * @see <a href="https://developers.google.com/drive/api/v2/manage-uploads#resumable">Perform a resumable upload</a>
  * @see readyWrite, write
  *
@@ -96,8 +105,48 @@ public:
     /**
      * @brief Sets the total upload size and is required for progress reporting
      * via the Job::progress() signal.
+     *
+     * Uploads larger than what fits into an int are reported by Job::progress()
+     * in units of KiB, MiB, etc., whatever is necessary for the values to fit.
+     */
+    void setUploadSize(qint64 size);
+
+    /**
+     * @brief Returns amount of bytes the server has confirmed to have received
+     *
+     * @since 6.1
      */
-    void setUploadSize(int size);
+    [[nodiscard]] qint64 uploadedSize() const;
+
+    /**
+     * @brief Returns token that identifies the upload session
+     *
+     * The token can be stored and passed to setSessionToken() of another Job
+     * to resume the upload, for example after the application has been
+     * restarted. Upload sessions expire after a week.
+     *
+     * Returns an empty token when the upload session has not been opened yet.
+     *
+     * @see sessionStarted
+     * @since 6.1
+     */
+    [[nodiscard]] QByteArray sessionToken() const;
+
+    /**
+     * @brief Resumes upload session identified by @p token
+     *
+     * Instead of opening a new upload session the Job asks the server how much
+     * data it has already received and continues uploading from there. When
+     * uploading from a device, the device is seeked to the first missing byte
+     * if it is a random-access device. Otherwise, as well as when uploading
+     * data passed to write(), the same data as for the interrupted upload must
+     * be provided from the beginning and the already uploaded part is skipped.
+     *
+     * @param token Token obtained from sessionToken()
+     *
+     * @since 6.1
+     */
+    void setSessionToken(const QByteArray &token);
 
     /**
      * @brief This function writes all the bytes in \p data to the upload session.
@@ -130,6 +179,14 @@ protected:
      */
     void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
 
+    /**
+     * @brief KGAPI2::Job::handleError implementation
+     *
+     * @param statusCode
+     * @param rawData
+     */
+    bool handleError(int statusCode, const QByteArray &rawData) override;
+
     /**
      * @brief KGAPI2::Job::dispatchRequest implementation
      *
@@ -169,6 +226,17 @@ Q_SIGNALS:
      */
     void readyWrite(KGAPI2::Drive::FileAbstractResumableJob *job);
 
+    /**
+     * @brief Emitted when @p job has opened a new upload session
+     *
+     * From now on sessionToken() returns token that can be used to resume the
+     * upload should it get interrupted.
+     *
+     * @param job The job that has opened the session
+     * @since 6.1
+     */
+    void sessionStarted(KGAPI2::Drive::FileAbstractResumableJob *job);
+
 private:
     class Private;
     QScopedPointer<Private> d;
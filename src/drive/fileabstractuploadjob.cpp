@@ -8,6 +8,7 @@
 
 #include "fileabstractuploadjob.h"
 #include "debug.h"
+#include "uploadbodydevice_p.h"
 #include "utils.h"
 
 #include <QNetworkReply>
@@ -26,10 +27,17 @@ using namespace KGAPI2::Drive;
 class Q_DECL_HIDDEN FileAbstractUploadJob::Private
 {
 public:
+    // Body of the upload currently in progress, the file is streamed from the disk
+    struct UploadBody {
+        QByteArray header;
+        QString filePath;
+        QByteArray footer;
+    };
+
     Private(FileAbstractUploadJob *parent);
     void processNext();
-    QByteArray buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary);
-    QByteArray readFile(const QString &filePath, QString &contentType);
+    UploadBody buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary);
+    static QString detectContentType(const QString &filePath);
 
     void _k_uploadProgress(qint64 bytesSent, qint64 totalBytes);
 
@@ -40,6 +48,10 @@ public:
 
     File::SerializationOptions serializationOptions = File::NoOptions;
 
+    QNetworkAccessManager::Operation uploadOperation = QNetworkAccessManager::UnknownOperation;
+    // Content of the file currently being uploaded, opened before the request is enqueued
+    UploadBodyDevice *currentBody = nullptr;
+
 private:
     FileAbstractUploadJob *const q;
 };
@@ -49,65 +61,61 @@ FileAbstractUploadJob::Private::Private(FileAbstractUploadJob *parent)
 {
 }
 
-QByteArray FileAbstractUploadJob::Private::readFile(const QString &filePath, QString &contentType)
+QString FileAbstractUploadJob::Private::detectContentType(const QString &filePath)
 {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qCWarning(KGAPIDebug) << "Failed to access" << filePath;
-        return QByteArray();
+        return QString();
     }
 
-    if (contentType.isEmpty()) {
-        const QMimeDatabase db;
-        const QMimeType mime = db.mimeTypeForFileNameAndData(filePath, &file);
-        contentType = mime.name();
-        qCDebug(KGAPIDebug) << "Determined content type" << contentType << "for" << filePath;
-    }
-
-    file.reset();
-    QByteArray output = file.readAll();
-
-    file.close();
-
-    return output;
+    // Looks only at the beginning of the file
+    const QMimeDatabase db;
+    const QMimeType mime = db.mimeTypeForFileNameAndData(filePath, &file);
+    qCDebug(KGAPIDebug) << "Determined content type" << mime.name() << "for" << filePath;
+    return mime.name();
 }
 
-QByteArray FileAbstractUploadJob::Private::buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary)
+FileAbstractUploadJob::Private::UploadBody
+FileAbstractUploadJob::Private::buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary)
 {
     QString fileContentType = metaData->mimeType();
-    QByteArray fileContent;
-
-    fileContent = readFile(filePath, fileContentType);
-    if (fileContent.isEmpty()) {
-        return QByteArray();
+    if (fileContentType.isEmpty()) {
+        fileContentType = detectContentType(filePath);
     }
 
     qCDebug(KGAPIDebug) << "Setting content type" << fileContentType << "for" << filePath;
 
     // Wannabe implementation of RFC2387, i.e. multipart/related
-    QByteArray body;
+    UploadBody body;
     QFileInfo finfo(filePath);
     const QByteArray md5 = QCryptographicHash::hash(finfo.fileName().toLatin1(), QCryptographicHash::Md5);
     boundary = QString::fromLatin1(md5.toHex());
 
-    body += "--" + boundary.toLatin1() + '\n';
-    body += "Content-Type: application/json; charset=UTF-8\n";
-    body += '\n';
-    body += File::toJSON(metaData, q->serializationOptions());
-    body += '\n';
-    body += '\n';
-    body += "--" + boundary.toLatin1() + '\n';
-    body += "Content-Type: " + fileContentType.toLatin1() + '\n';
-    body += '\n';
-    body += fileContent;
-    body += '\n';
-    body += "--" + boundary.toLatin1() + "--";
+    body.header += "--" + boundary.toLatin1() + '\n';
+    body.header += "Content-Type: application/json; charset=UTF-8\n";
+    body.header += '\n';
+    body.header += File::toJSON(metaData, q->serializationOptions());
+    body.header += '\n';
+    body.header += '\n';
+    body.header += "--" + boundary.toLatin1() + '\n';
+    body.header += "Content-Type: " + fileContentType.toLatin1() + '\n';
+    body.header += '\n';
+    body.filePath = filePath;
+    body.footer += '\n';
+    body.footer += "--" + boundary.toLatin1() + "--";
 
     return body;
 }
 
 void FileAbstractUploadJob::Private::processNext()
 {
+    // The previous file has been uploaded
+    if (currentBody) {
+        currentBody->deleteLater();
+        currentBody = nullptr;
+    }
+
     if (files.isEmpty()) {
         q->emitFinished();
         return;
@@ -134,38 +142,50 @@ void FileAbstractUploadJob::Private::processNext()
 
     QByteArray rawData;
     QString contentType;
+    qint64 contentLength = 0;
+    UploadBody body;
 
     // just to be sure
     query.removeQueryItem(QStringLiteral("uploadType"));
-    if (metaData.isNull()) {
-        query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("media"));
+    if (!filePath.startsWith(QLatin1StringView("?="))) {
+        if (metaData.isNull()) {
+            query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("media"));
+            contentType = detectContentType(filePath);
+            body.filePath = filePath;
+        } else {
+            query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("multipart"));
+            QString boundary;
+            body = buildMultipart(filePath, metaData, boundary);
+            contentType = QStringLiteral("multipart/related; boundary=%1").arg(boundary);
+        }
 
-        rawData = readFile(filePath, contentType);
-        if (rawData.isEmpty()) {
+        // The file is not read until the request is sent, see dispatchRequest()
+        contentLength = UploadBodyDevice::bodySize(body.header, body.filePath, body.footer);
+        if (contentLength <= body.header.size() + body.footer.size()) {
+            qCWarning(KGAPIDebug) << "Skipping empty or inaccessible file" << filePath;
             processNext();
             return;
         }
 
-    } else if (!filePath.startsWith(QLatin1StringView("?="))) {
-        query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("multipart"));
-
-        QString boundary;
-        rawData = buildMultipart(filePath, metaData, boundary);
-
-        contentType = QStringLiteral("multipart/related; boundary=%1").arg(boundary);
-        if (rawData.isEmpty()) {
-            processNext();
+        currentBody = new UploadBodyDevice(body.header, body.filePath, body.footer, q);
+        if (!currentBody->open(QIODevice::ReadOnly)) {
+            delete currentBody;
+            currentBody = nullptr;
+            q->setError(KGAPI2::UnknownError);
+            q->setErrorString(FileAbstractUploadJob::tr("Failed to read file %1").arg(filePath));
+            q->emitFinished();
             return;
         }
     } else {
         rawData = File::toJSON(metaData, q->serializationOptions());
         contentType = QStringLiteral("application/json");
+        contentLength = rawData.length();
     }
 
     url.setQuery(query);
 
     QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentLengthHeader, rawData.length());
+    request.setHeader(QNetworkRequest::ContentLengthHeader, contentLength);
     request.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
     request.setAttribute(QNetworkRequest::User, filePath);
 
@@ -259,7 +279,21 @@ void FileAbstractUploadJob::dispatchRequest(QNetworkAccessManager *accessManager
 {
     Q_UNUSED(contentType)
 
-    QNetworkReply *reply = dispatch(accessManager, request, data);
+    QNetworkReply *reply = nullptr;
+    if (d->currentBody) {
+        // Rewound for every attempt, the request may be sent again after an error
+        d->currentBody->seek(0);
+        if (d->uploadOperation == QNetworkAccessManager::PostOperation) {
+            reply = accessManager->post(request, d->currentBody);
+        } else if (d->uploadOperation == QNetworkAccessManager::PutOperation) {
+            reply = accessManager->put(request, d->currentBody);
+        } else {
+            // Subclasses that don't set the upload operation get the body in memory
+            reply = dispatch(accessManager, request, d->currentBody->readAll());
+        }
+    } else {
+        reply = dispatch(accessManager, request, data);
+    }
 
     connect(reply, &QNetworkReply::uploadProgress, this, [this](qint64 bytesSent, qint64 totalBytes) {
         d->_k_uploadProgress(bytesSent, totalBytes);
@@ -297,4 +331,9 @@ File::SerializationOptions FileAbstractUploadJob::serializationOptions() const
     return d->serializationOptions;
 }
 
+void FileAbstractUploadJob::setUploadOperation(QNetworkAccessManager::Operation operation)
+{
+    d->uploadOperation = operation;
+}
+
 #include "moc_fileabstractuploadjob.cpp"
@@ -13,6 +13,7 @@
 #include "kgapidrive_export.h"
 
 #include <QMap>
+#include <QNetworkAccessManager>
 #include <QStringList>
 
 namespace KGAPI2
@@ -43,9 +44,23 @@ protected:
 
     virtual QUrl createUrl(const QString &filePath, const FilePtr &metaData) = 0;
     virtual QNetworkReply *dispatch(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data) = 0;
+
     void setSerializationOptions(File::SerializationOptions options);
     [[nodiscard]] File::SerializationOptions serializationOptions() const;
 
+    /**
+     * @brief Sets the operation used to upload file content from the disk
+     *
+     * When set to QNetworkAccessManager::PostOperation or
+     * QNetworkAccessManager::PutOperation, the content of the uploaded files
+     * is streamed from the disk as it is being sent instead of being loaded
+     * into memory and passed to dispatch() first. Subclasses set it in their
+     * constructor to the operation their dispatch() implementation uses.
+     *
+     * @since 6.1
+     */
+    void setUploadOperation(QNetworkAccessManager::Operation operation);
+
 private:
     class Private;
     Private *const d;
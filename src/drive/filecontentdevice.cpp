@@ -0,0 +1,476 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filecontentdevice.h"
+#include "debug.h"
+#include "file.h"
+#include "filefetchcontentjob.h"
+
+#include <QDir>
+#include <QEventLoop>
+#include <QHash>
+#include <QSet>
+#include <QTemporaryFile>
+#include <QTimer>
+
+#include <cstring>
+#include <memory>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr qint64 DefaultBlockSize = 256 * 1024;
+static constexpr qint64 DefaultMaxMemorySize = 16 * 1024 * 1024;
+static constexpr qint64 DefaultMaxDiskSize = 256 * 1024 * 1024;
+static constexpr int DefaultReadAheadBlocks = 4;
+
+struct DiskBlock {
+    qint64 slot = 0;
+    qint64 size = 0;
+};
+}
+
+class Q_DECL_HIDDEN FileContentDevice::Private
+{
+public:
+    Private(FileContentDevice *parent);
+
+    qint64 blockStart(qint64 index) const;
+    qint64 blockLength(qint64 index) const;
+    bool isCached(qint64 index) const;
+    QByteArray cachedBlock(qint64 index);
+    void insertBlock(qint64 index, const QByteArray &data);
+    void spillBlock(qint64 index, const QByteArray &data);
+    void fetchBlock(qint64 index);
+    void blockFetched(qint64 index, FileFetchContentJob *job);
+    void clear();
+
+    FilePtr file;
+    AccountPtr account;
+
+    qint64 blockSize = DefaultBlockSize;
+    qint64 maxMemorySize = DefaultMaxMemorySize;
+    QString cacheDirectory;
+    qint64 maxDiskSize = DefaultMaxDiskSize;
+    int readAheadBlocks = DefaultReadAheadBlocks;
+
+    // Blocks in memory, memoryOrder starts with the least recently used one
+    QHash<qint64, QByteArray> memory;
+    QList<qint64> memoryOrder;
+    qint64 memorySize = 0;
+
+    std::unique_ptr<QTemporaryFile> diskFile;
+    QHash<qint64, DiskBlock> disk;
+    QList<qint64> diskOrder;
+    QList<qint64> freeSlots;
+    qint64 slotCount = 0;
+
+    QHash<qint64, FileFetchContentJob *> pending;
+    QSet<qint64> failed;
+
+    // Where the previous read ended, to detect sequential access
+    qint64 lastReadEnd = -1;
+    qint64 downloadedSize = 0;
+
+private:
+    FileContentDevice *const q;
+};
+
+FileContentDevice::Private::Private(FileContentDevice *parent)
+    : q(parent)
+{
+}
+
+qint64 FileContentDevice::Private::blockStart(qint64 index) const
+{
+    return index * blockSize;
+}
+
+qint64 FileContentDevice::Private::blockLength(qint64 index) const
+{
+    return qBound<qint64>(0, file->fileSize() - blockStart(index), blockSize);
+}
+
+bool FileContentDevice::Private::isCached(qint64 index) const
+{
+    return memory.contains(index) || disk.contains(index);
+}
+
+QByteArray FileContentDevice::Private::cachedBlock(qint64 index)
+{
+    auto it = memory.constFind(index);
+    if (it != memory.cend()) {
+        memoryOrder.removeOne(index);
+        memoryOrder.append(index);
+        return *it;
+    }
+
+    const auto diskIt = disk.constFind(index);
+    if (diskIt == disk.cend()) {
+        return QByteArray();
+    }
+
+    // Move the block back into memory, it's likely to be read again soon
+    const DiskBlock block = *diskIt;
+    disk.erase(diskIt);
+    diskOrder.removeOne(index);
+    freeSlots.append(block.slot);
+
+    QByteArray data;
+    if (diskFile->seek(block.slot * blockSize)) {
+        data = diskFile->read(block.size);
+    }
+    if (data.size() != block.size) {
+        qCWarning(KGAPIDebug) << "Failed reading cached block" << index << ":" << diskFile->errorString();
+        return QByteArray();
+    }
+
+    insertBlock(index, data);
+    return data;
+}
+
+void FileContentDevice::Private::insertBlock(qint64 index, const QByteArray &data)
+{
+    memory.insert(index, data);
+    memoryOrder.append(index);
+    memorySize += data.size();
+
+    // The block that has just been inserted is never evicted
+    while (memorySize > maxMemorySize && memoryOrder.size() > 1) {
+        const qint64 evicted = memoryOrder.takeFirst();
+        const QByteArray evictedData = memory.take(evicted);
+        memorySize -= evictedData.size();
+        spillBlock(evicted, evictedData);
+    }
+}
+
+void FileContentDevice::Private::spillBlock(qint64 index, const QByteArray &data)
+{
+    if (cacheDirectory.isEmpty() || maxDiskSize < blockSize) {
+        return;
+    }
+
+    if (!diskFile) {
+        QDir().mkpath(cacheDirectory);
+        diskFile = std::make_unique<QTemporaryFile>(cacheDirectory + QLatin1StringView("/kgapi-blocks-XXXXXX"));
+        if (!diskFile->open()) {
+            qCWarning(KGAPIDebug) << "Failed creating block cache file in" << cacheDirectory << ":" << diskFile->errorString();
+            cacheDirectory.clear();
+            diskFile.reset();
+            return;
+        }
+    }
+
+    qint64 slot = 0;
+    if (!freeSlots.isEmpty()) {
+        slot = freeSlots.takeLast();
+    } else if ((slotCount + 1) * blockSize <= maxDiskSize) {
+        slot = slotCount++;
+    } else {
+        slot = disk.take(diskOrder.takeFirst()).slot;
+    }
+
+    if (!diskFile->seek(slot * blockSize) || diskFile->write(data) != data.size()) {
+        qCWarning(KGAPIDebug) << "Failed writing block" << index << "into cache file:" << diskFile->errorString();
+        freeSlots.append(slot);
+        return;
+    }
+
+    disk.insert(index, DiskBlock{slot, data.size()});
+    diskOrder.append(index);
+}
+
+void FileContentDevice::Private::fetchBlock(qint64 index)
+{
+    if (blockLength(index) <= 0 || isCached(index) || pending.contains(index) || failed.contains(index)) {
+        return;
+    }
+
+    auto job = new FileFetchContentJob(file, account, q);
+    job->setResumeOffset(blockStart(index));
+    job->setLength(blockLength(index));
+    QObject::connect(job, &FileFetchContentJob::finished, q, [this, index, job]() {
+        blockFetched(index, job);
+    });
+    pending.insert(index, job);
+}
+
+void FileContentDevice::Private::blockFetched(qint64 index, FileFetchContentJob *job)
+{
+    pending.remove(index);
+    job->deleteLater();
+
+    const QByteArray data = job->data();
+    if (job->error() != KGAPI2::NoError || data.size() != blockLength(index)) {
+        qCWarning(KGAPIDebug) << "Failed downloading block" << index << "of" << file->id() << ":" << job->errorString();
+        failed.insert(index);
+        q->setErrorString(job->errorString());
+        return;
+    }
+
+    downloadedSize += data.size();
+    insertBlock(index, data);
+
+    const qint64 pos = q->pos();
+    if (pos >= blockStart(index) && pos < blockStart(index) + data.size()) {
+        Q_EMIT q->readyRead();
+    }
+}
+
+void FileContentDevice::Private::clear()
+{
+    // Deleting the jobs aborts their requests, including the blocks read ahead
+    qDeleteAll(pending);
+    pending.clear();
+    failed.clear();
+
+    memory.clear();
+    memoryOrder.clear();
+    memorySize = 0;
+
+    diskFile.reset();
+    disk.clear();
+    diskOrder.clear();
+    freeSlots.clear();
+    slotCount = 0;
+
+    lastReadEnd = -1;
+}
+
+FileContentDevice::FileContentDevice(const FilePtr &file, const AccountPtr &account, QObject *parent)
+    : QIODevice(parent)
+    , d(new Private(this))
+{
+    d->file = file;
+    d->account = account;
+}
+
+FileContentDevice::~FileContentDevice()
+{
+    d->clear();
+}
+
+FilePtr FileContentDevice::file() const
+{
+    return d->file;
+}
+
+void FileContentDevice::setBlockSize(qint64 size)
+{
+    if (isOpen()) {
+        qCWarning(KGAPIDebug) << "Called setBlockSize() on open device. Ignoring.";
+        return;
+    }
+
+    d->blockSize = qMax<qint64>(size, 1);
+}
+
+qint64 FileContentDevice::blockSize() const
+{
+    return d->blockSize;
+}
+
+void FileContentDevice::setMaxMemorySize(qint64 size)
+{
+    d->maxMemorySize = qMax<qint64>(size, 0);
+}
+
+qint64 FileContentDevice::maxMemorySize() const
+{
+    return d->maxMemorySize;
+}
+
+void FileContentDevice::setCacheDirectory(const QString &path)
+{
+    if (isOpen()) {
+        qCWarning(KGAPIDebug) << "Called setCacheDirectory() on open device. Ignoring.";
+        return;
+    }
+
+    d->cacheDirectory = path;
+}
+
+QString FileContentDevice::cacheDirectory() const
+{
+    return d->cacheDirectory;
+}
+
+void FileContentDevice::setMaxDiskSize(qint64 size)
+{
+    if (isOpen()) {
+        qCWarning(KGAPIDebug) << "Called setMaxDiskSize() on open device. Ignoring.";
+        return;
+    }
+
+    d->maxDiskSize = qMax<qint64>(size, 0);
+}
+
+qint64 FileContentDevice::maxDiskSize() const
+{
+    return d->maxDiskSize;
+}
+
+void FileContentDevice::setReadAheadBlocks(int blocks)
+{
+    d->readAheadBlocks = qMax(blocks, 0);
+}
+
+int FileContentDevice::readAheadBlocks() const
+{
+    return d->readAheadBlocks;
+}
+
+qint64 FileContentDevice::downloadedSize() const
+{
+    return d->downloadedSize;
+}
+
+bool FileContentDevice::open(QIODevice::OpenMode mode)
+{
+    if (mode & QIODevice::WriteOnly) {
+        qCWarning(KGAPIDebug) << "FileContentDevice can only be opened for reading";
+        setErrorString(tr("Device can only be opened for reading"));
+        return false;
+    }
+    if (!d->file || d->file->downloadUrl().isEmpty() || d->file->fileSize() < 0) {
+        qCWarning(KGAPIDebug) << "Download URL or size of the file is not known";
+        setErrorString(tr("Download URL or size of the file is not known"));
+        return false;
+    }
+
+    d->clear();
+    d->downloadedSize = 0;
+
+    // Blocks are cached by the device itself, QIODevice's buffer would only duplicate them
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+void FileContentDevice::close()
+{
+    d->clear();
+    QIODevice::close();
+}
+
+bool FileContentDevice::isSequential() const
+{
+    return false;
+}
+
+qint64 FileContentDevice::size() const
+{
+    return d->file ? qMax<qint64>(d->file->fileSize(), 0) : 0;
+}
+
+bool FileContentDevice::seek(qint64 pos)
+{
+    if (pos > size()) {
+        return false;
+    }
+    return QIODevice::seek(pos);
+}
+
+qint64 FileContentDevice::bytesAvailable() const
+{
+    // Only the data that can be read without waiting for the network
+    qint64 available = 0;
+    qint64 pos = this->pos();
+    while (pos < size()) {
+        const qint64 index = pos / d->blockSize;
+        if (!d->isCached(index)) {
+            break;
+        }
+        const qint64 end = d->blockStart(index) + d->blockLength(index);
+        available += end - pos;
+        pos = end;
+    }
+    return available;
+}
+
+bool FileContentDevice::waitForReadyRead(int msecs)
+{
+    if (!isOpen() || atEnd()) {
+        return false;
+    }
+
+    const qint64 index = pos() / d->blockSize;
+    if (d->isCached(index)) {
+        return true;
+    }
+
+    d->fetchBlock(index);
+    FileFetchContentJob *job = d->pending.value(index);
+    if (!job) {
+        return false;
+    }
+
+    QEventLoop loop;
+    connect(job, &FileFetchContentJob::finished, &loop, &QEventLoop::quit);
+    if (msecs >= 0) {
+        QTimer::singleShot(msecs, &loop, &QEventLoop::quit);
+    }
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    return d->isCached(index);
+}
+
+qint64 FileContentDevice::readData(char *data, qint64 maxSize)
+{
+    const qint64 pos = this->pos();
+    const qint64 fileSize = size();
+    if (pos >= fileSize) {
+        return 0;
+    }
+
+    const bool sequential = pos == d->lastReadEnd;
+    const qint64 firstIndex = pos / d->blockSize;
+
+    qint64 copied = 0;
+    while (copied < maxSize && pos + copied < fileSize) {
+        const qint64 index = (pos + copied) / d->blockSize;
+        const QByteArray block = d->cachedBlock(index);
+        if (block.isNull()) {
+            break;
+        }
+        const qint64 offset = pos + copied - d->blockStart(index);
+        const qint64 length = qMin<qint64>(maxSize - copied, block.size() - offset);
+        std::memcpy(data + copied, block.constData() + offset, length);
+        copied += length;
+    }
+
+    if (copied == 0) {
+        // Report the failure once, the next read tries to download the block again
+        if (d->failed.remove(firstIndex)) {
+            return -1;
+        }
+        d->fetchBlock(firstIndex);
+    } else {
+        d->lastReadEnd = pos + copied;
+    }
+
+    if (sequential) {
+        // The next read will most likely continue where this one ended
+        const qint64 nextIndex = (pos + copied) / d->blockSize;
+        for (qint64 i = 0; i <= d->readAheadBlocks; ++i) {
+            d->fetchBlock(nextIndex + i);
+        }
+    }
+
+    return copied;
+}
+
+qint64 FileContentDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+
+    return -1;
+}
+
+#include "moc_filecontentdevice.cpp"
@@ -0,0 +1,124 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QIODevice>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @headerfile filecontentdevice.h
+ * @brief A random-access device to read content of a file
+ *
+ * Unlike FileFetchContentJob, which downloads the whole content, the device
+ * only downloads the blocks of the file that are actually read, using HTTP
+ * Range requests. This makes reading small parts of large files, like the
+ * index of an archive or the header of a media file, cheap.
+ *
+ * Downloaded blocks are kept in memory, up to maxMemorySize(). When a cache
+ * directory is set, blocks evicted from memory are moved into a temporary
+ * file in that directory, up to maxDiskSize(). Least recently used blocks are
+ * evicted first. When the device detects that it is being read sequentially,
+ * it downloads readAheadBlocks() following blocks before they are needed.
+ *
+ * Like a socket, the device does not block: read() only returns data that
+ * have already been downloaded and readyRead() is emitted when more become
+ * available. Use waitForReadyRead() to block until the data at the current
+ * position have been downloaded.
+ *
+ * The device can only be opened for reading. The size of the file must be
+ * known, so the file must have been fetched with its fileSize.
+ *
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT FileContentDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit FileContentDevice(const FilePtr &file, const AccountPtr &account, QObject *parent = nullptr);
+    ~FileContentDevice() override;
+
+    [[nodiscard]] FilePtr file() const;
+
+    /**
+     * @brief Sets size of the blocks the file is downloaded in
+     *
+     * Can only be changed while the device is closed. Default is 256 KiB.
+     */
+    void setBlockSize(qint64 size);
+    [[nodiscard]] qint64 blockSize() const;
+
+    /**
+     * @brief Sets maximum size of blocks kept in memory
+     *
+     * Default is 16 MiB.
+     */
+    void setMaxMemorySize(qint64 size);
+    [[nodiscard]] qint64 maxMemorySize() const;
+
+    /**
+     * @brief Sets directory to store blocks evicted from memory in
+     *
+     * An empty path, which is the default, discards the evicted blocks.
+     * Can only be changed while the device is closed.
+     */
+    void setCacheDirectory(const QString &path);
+    [[nodiscard]] QString cacheDirectory() const;
+
+    /**
+     * @brief Sets maximum size of blocks stored in the cache directory
+     *
+     * Default is 256 MiB.
+     */
+    void setMaxDiskSize(qint64 size);
+    [[nodiscard]] qint64 maxDiskSize() const;
+
+    /**
+     * @brief Sets how many blocks to download ahead when reading sequentially
+     *
+     * 0 disables reading ahead. Default is 4.
+     */
+    void setReadAheadBlocks(int blocks);
+    [[nodiscard]] int readAheadBlocks() const;
+
+    /**
+     * @brief Returns amount of bytes downloaded since the device was opened
+     */
+    [[nodiscard]] qint64 downloadedSize() const;
+
+    bool open(QIODevice::OpenMode mode) override;
+    void close() override;
+    [[nodiscard]] bool isSequential() const override;
+    [[nodiscard]] qint64 size() const override;
+    bool seek(qint64 pos) override;
+    [[nodiscard]] qint64 bytesAvailable() const override;
+    bool waitForReadyRead(int msecs) override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -23,36 +23,42 @@ FileCreateJob::FileCreateJob(const FilePtr &metadata, const AccountPtr &account,
     : FileAbstractUploadJob(metadata, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::FileCreateJob(const FilesList &metadata, const AccountPtr &account, QObject *parent)
     : FileAbstractUploadJob(metadata, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::FileCreateJob(const QString &filePath, const AccountPtr &account, QObject *parent)
     : FileAbstractUploadJob(filePath, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::FileCreateJob(const QString &filePath, const FilePtr &metaData, const AccountPtr &account, QObject *parent)
     : FileAbstractUploadJob(filePath, metaData, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::FileCreateJob(const QStringList &filePaths, const AccountPtr &account, QObject *parent)
     : FileAbstractUploadJob(filePaths, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::FileCreateJob(const QMap<QString, FilePtr> &files, const AccountPtr &account, QObject *parent)
     : FileAbstractUploadJob(files, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PostOperation);
 }
 
 FileCreateJob::~FileCreateJob()
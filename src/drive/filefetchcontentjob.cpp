@@ -7,24 +7,87 @@
  */
 
 #include "filefetchcontentjob.h"
+#include "debug.h"
 #include "file.h"
 
+#include <QCryptographicHash>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 
+#include <algorithm>
+#include <limits>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+// Segments smaller than this are not worth the overhead of another request
+static const qint64 MinSegmentSize = 1024 * 1024;
+// How many times to retry downloading of a single segment or of the rest of the content
+static const int MaxSegmentRetries = 3;
+
+struct Segment {
+    // First and last byte of the segment, as in the Range header
+    qint64 first = 0;
+    qint64 last = 0;
+    qint64 received = 0;
+    int retries = 0;
+
+    qint64 size() const
+    {
+        return last - first + 1;
+    }
+};
+}
+
 class Q_DECL_HIDDEN FileFetchContentJob::Private
 {
 public:
     Private(FileFetchContentJob *parent);
 
     void _k_downloadProgress(qint64 downloaded, qint64 total);
+    void _k_readyRead(QNetworkReply *reply);
+
+    bool isContentReply(const QNetworkReply *reply) const;
+    void setStreamRange(QNetworkRequest &request);
+    bool retryStream();
+    bool isStreamComplete() const;
+    bool processData(const QNetworkReply *reply, const QByteArray &data);
+    bool seedChecksum();
+    bool hashDeviceData(qint64 from, qint64 size);
+    void finish();
+
+    void createSegments();
+    void requestSegment(const Segment &segment);
+    Segment *segmentForRequest(const QNetworkRequest &request);
+    bool processSegmentData(const QNetworkReply *reply, const QByteArray &data);
+    void emitSegmentsProgress();
 
     QUrl url;
     QByteArray fileData;
 
+    QIODevice *device = nullptr;
+    qint64 resumeOffset = 0;
+    // Amount of bytes to download, or -1 for the rest of the file
+    qint64 length = -1;
+    qint64 downloadedSize = 0;
+    // First byte of the file requested by the request currently being sent
+    qint64 requestOffset = 0;
+    int streamRetries = 0;
+    // Amount of bytes to throw away when the server ignores the Range header
+    qint64 skip = -1;
+
+    bool verifyChecksum = false;
+    QByteArray expectedChecksum;
+    qint64 expectedSize = -1;
+    QCryptographicHash checksum{QCryptographicHash::Md5};
+
+    int segmentCount = 1;
+    QList<Segment> segments;
+    // Position in the device where the content starts
+    qint64 deviceBase = 0;
+
 private:
     FileFetchContentJob *const q;
 };
@@ -36,14 +99,287 @@ FileFetchContentJob::Private::Private(FileFetchContentJob *parent)
 
 void FileFetchContentJob::Private::_k_downloadProgress(qint64 downloaded, qint64 total)
 {
+    if (skip == 0) {
+        // Server is only sending the rest of the content
+        downloaded += requestOffset;
+        total += requestOffset;
+    }
     q->emitProgress(downloaded, total);
 }
 
+void FileFetchContentJob::Private::_k_readyRead(QNetworkReply *reply)
+{
+    // Redirects and errors are handled once the reply is finished
+    if (!q->isRunning() || !isContentReply(reply)) {
+        return;
+    }
+
+    const bool ok = segments.isEmpty() ? processData(reply, reply->readAll()) : processSegmentData(reply, reply->readAll());
+    if (!ok) {
+        q->emitFinished();
+    }
+}
+
+bool FileFetchContentJob::Private::isContentReply(const QNetworkReply *reply) const
+{
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    return replyCode == KGAPI2::OK || replyCode == KGAPI2::PartialContent;
+}
+
+void FileFetchContentJob::Private::setStreamRange(QNetworkRequest &request)
+{
+    // The request may be sent again after part of the content has been written,
+    // it must only ask for the bytes that have not been received yet
+    requestOffset = resumeOffset + downloadedSize;
+    if (length > 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(requestOffset) + '-' + QByteArray::number(resumeOffset + length - 1));
+    } else if (requestOffset > 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(requestOffset) + '-');
+    }
+}
+
+bool FileFetchContentJob::Private::retryStream()
+{
+    if (streamRetries >= MaxSegmentRetries) {
+        return false;
+    }
+
+    ++streamRetries;
+    QNetworkRequest request(url);
+    setStreamRange(request);
+    qCWarning(KGAPIDebug) << "Download interrupted after" << downloadedSize << "bytes, requesting the rest";
+    q->enqueueRequest(request);
+    return true;
+}
+
+bool FileFetchContentJob::Private::isStreamComplete() const
+{
+    if (length >= 0) {
+        return downloadedSize >= length;
+    }
+    return expectedSize > 0 && resumeOffset + downloadedSize >= expectedSize;
+}
+
+bool FileFetchContentJob::Private::processData(const QNetworkReply *reply, const QByteArray &data)
+{
+    if (skip < 0) {
+        // First data of the reply, find out whether the server has honored the Range header
+        const bool partial = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == KGAPI2::PartialContent;
+        skip = partial ? 0 : requestOffset;
+        if (skip > 0) {
+            qCDebug(KGAPIDebug) << "Server ignored Range header, skipping first" << skip << "bytes";
+        }
+    }
+
+    QByteArrayView view(data);
+    if (skip > 0) {
+        const qint64 skipped = qMin<qint64>(skip, view.size());
+        view = view.sliced(skipped);
+        skip -= skipped;
+    }
+    if (length >= 0) {
+        // Servers ignoring the Range header send the content up to the end of the file
+        view = view.first(qMin<qint64>(view.size(), length - downloadedSize));
+    }
+    if (view.isEmpty()) {
+        return true;
+    }
+
+    downloadedSize += view.size();
+    if (verifyChecksum) {
+        checksum.addData(view);
+    }
+
+    if (!device) {
+        fileData.append(view);
+        return true;
+    }
+
+    if (device->write(view.data(), view.size()) != view.size()) {
+        qCWarning(KGAPIDebug) << "Failed writing downloaded data:" << device->errorString();
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(tr("Failed writing downloaded data: %1").arg(device->errorString()));
+        return false;
+    }
+
+    return true;
+}
+
+bool FileFetchContentJob::Private::seedChecksum()
+{
+    if (resumeOffset == 0) {
+        return true;
+    }
+
+    // The checksum covers the whole file, including the part downloaded before
+    if (!device || !device->isReadable() || device->isSequential() || device->pos() < resumeOffset) {
+        return false;
+    }
+
+    return hashDeviceData(device->pos() - resumeOffset, resumeOffset);
+}
+
+bool FileFetchContentJob::Private::hashDeviceData(qint64 from, qint64 size)
+{
+    const qint64 pos = device->pos();
+    if (!device->seek(from)) {
+        return false;
+    }
+
+    qint64 remaining = size;
+    QByteArray block(qMin<qint64>(remaining, 1024 * 1024), Qt::Uninitialized);
+    while (remaining > 0) {
+        const qint64 read = device->read(block.data(), qMin<qint64>(remaining, block.size()));
+        if (read <= 0) {
+            device->seek(pos);
+            return false;
+        }
+        checksum.addData(QByteArrayView(block.constData(), read));
+        remaining -= read;
+    }
+
+    return device->seek(pos);
+}
+
+void FileFetchContentJob::Private::finish()
+{
+    if (!verifyChecksum) {
+        return;
+    }
+
+    // Segments are received out of order, so the checksum can only be computed once all are written
+    if (!segments.isEmpty() && !hashDeviceData(deviceBase, expectedSize)) {
+        qCWarning(KGAPIDebug) << "Failed reading downloaded data back from the device";
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(tr("Failed reading downloaded data"));
+        return;
+    }
+
+    const QByteArray result = checksum.result().toHex();
+    if (result != expectedChecksum) {
+        qCWarning(KGAPIDebug) << "Checksum mismatch, expected" << expectedChecksum << "got" << result;
+        q->setError(KGAPI2::InvalidResponse);
+        q->setErrorString(tr("Checksum of the downloaded file does not match"));
+    }
+}
+
+void FileFetchContentJob::Private::createSegments()
+{
+    segments.clear();
+    if (segmentCount <= 1) {
+        return;
+    }
+
+    if (length >= 0) {
+        qCWarning(KGAPIDebug) << "Slice of a file is downloaded in a single request";
+        return;
+    }
+
+    if (!device || device->isSequential()) {
+        qCWarning(KGAPIDebug) << "Segmented download requires a random-access output device, downloading in a single request";
+        return;
+    }
+    if (expectedSize <= resumeOffset) {
+        qCWarning(KGAPIDebug) << "Size of the file is not known, downloading in a single request";
+        return;
+    }
+
+    const qint64 remaining = expectedSize - resumeOffset;
+    const qint64 count = qBound<qint64>(1, remaining / MinSegmentSize, segmentCount);
+    if (count == 1) {
+        return;
+    }
+
+    const qint64 segmentSize = (remaining + count - 1) / count;
+    for (qint64 first = resumeOffset; first < expectedSize; first += segmentSize) {
+        Segment segment;
+        segment.first = first;
+        segment.last = qMin(first + segmentSize, expectedSize) - 1;
+        segments << segment;
+    }
+    deviceBase = device->pos() - resumeOffset;
+    qCDebug(KGAPIDebug) << "Downloading" << remaining << "bytes in" << segments.size() << "segments";
+}
+
+void FileFetchContentJob::Private::requestSegment(const Segment &segment)
+{
+    QNetworkRequest request(url);
+    request.setRawHeader("Range", "bytes=" + QByteArray::number(segment.first + segment.received) + '-' + QByteArray::number(segment.last));
+    q->enqueueRequest(request);
+}
+
+Segment *FileFetchContentJob::Private::segmentForRequest(const QNetworkRequest &request)
+{
+    // The segment is identified by its last byte, its first byte moves when a segment is retried
+    const QByteArray range = request.rawHeader("Range");
+    bool ok = false;
+    const qint64 last = range.mid(range.lastIndexOf('-') + 1).toLongLong(&ok);
+    if (!ok) {
+        return nullptr;
+    }
+
+    for (auto &segment : segments) {
+        if (segment.last == last) {
+            return &segment;
+        }
+    }
+    return nullptr;
+}
+
+bool FileFetchContentJob::Private::processSegmentData(const QNetworkReply *reply, const QByteArray &data)
+{
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != KGAPI2::PartialContent) {
+        qCWarning(KGAPIDebug) << "Server ignored Range header of a segment";
+        q->setError(KGAPI2::InvalidResponse);
+        q->setErrorString(tr("Server does not support downloading the file in segments"));
+        return false;
+    }
+
+    Segment *segment = segmentForRequest(reply->request());
+    if (!segment) {
+        qCWarning(KGAPIDebug) << "Received data for unknown segment" << reply->request().rawHeader("Range");
+        q->setError(KGAPI2::InvalidResponse);
+        q->setErrorString(tr("Invalid response"));
+        return false;
+    }
+
+    const qint64 size = qMin<qint64>(data.size(), segment->size() - segment->received);
+    if (size <= 0) {
+        return true;
+    }
+
+    if (!device->seek(deviceBase + segment->first + segment->received) || device->write(data.constData(), size) != size) {
+        qCWarning(KGAPIDebug) << "Failed writing downloaded data:" << device->errorString();
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(tr("Failed writing downloaded data: %1").arg(device->errorString()));
+        return false;
+    }
+
+    segment->received += size;
+    downloadedSize += size;
+    emitSegmentsProgress();
+    return true;
+}
+
+void FileFetchContentJob::Private::emitSegmentsProgress()
+{
+    // Job::progress() can only report int values
+    qint64 processed = resumeOffset + downloadedSize;
+    qint64 total = expectedSize;
+    while (total > std::numeric_limits<int>::max()) {
+        processed >>= 10;
+        total >>= 10;
+    }
+    q->emitProgress(static_cast<int>(processed), static_cast<int>(total));
+}
+
 FileFetchContentJob::FileFetchContentJob(const FilePtr &file, const AccountPtr &account, QObject *parent)
     : FetchJob(account, parent)
     , d(new Private(this))
 {
     d->url = file->downloadUrl();
+    d->expectedChecksum = file->md5Checksum().toLatin1().toLower();
+    d->expectedSize = file->fileSize();
 }
 
 FileFetchContentJob::FileFetchContentJob(const QUrl &url, const AccountPtr &account, QObject *parent)
@@ -63,9 +399,127 @@ QByteArray FileFetchContentJob::data() const
     return d->fileData;
 }
 
+void FileFetchContentJob::setOutputDevice(QIODevice *device)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setOutputDevice() on running job. Ignoring.";
+        return;
+    }
+
+    d->device = device;
+}
+
+QIODevice *FileFetchContentJob::outputDevice() const
+{
+    return d->device;
+}
+
+void FileFetchContentJob::setResumeOffset(qint64 offset)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setResumeOffset() on running job. Ignoring.";
+        return;
+    }
+
+    d->resumeOffset = qMax<qint64>(offset, 0);
+}
+
+qint64 FileFetchContentJob::resumeOffset() const
+{
+    return d->resumeOffset;
+}
+
+void FileFetchContentJob::setLength(qint64 length)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setLength() on running job. Ignoring.";
+        return;
+    }
+
+    d->length = qMax<qint64>(length, -1);
+}
+
+qint64 FileFetchContentJob::length() const
+{
+    return d->length;
+}
+
+void FileFetchContentJob::setVerifyChecksum(bool verify)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setVerifyChecksum() on running job. Ignoring.";
+        return;
+    }
+
+    d->verifyChecksum = verify;
+}
+
+bool FileFetchContentJob::verifyChecksum() const
+{
+    return d->verifyChecksum;
+}
+
+void FileFetchContentJob::setSegmentCount(int count)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setSegmentCount() on running job. Ignoring.";
+        return;
+    }
+
+    d->segmentCount = qMax(count, 1);
+}
+
+int FileFetchContentJob::segmentCount() const
+{
+    return d->segmentCount;
+}
+
+qint64 FileFetchContentJob::downloadedSize() const
+{
+    return d->downloadedSize;
+}
+
 void FileFetchContentJob::start()
 {
+    d->fileData.clear();
+    d->downloadedSize = 0;
+    d->streamRetries = 0;
+    d->checksum.reset();
+
+    if (d->length == 0) {
+        emitFinished();
+        return;
+    }
+
+    if (d->verifyChecksum && d->length >= 0) {
+        qCWarning(KGAPIDebug) << "Checksum of a slice of the file can't be verified";
+        d->verifyChecksum = false;
+    }
+    if (d->verifyChecksum && d->expectedChecksum.isEmpty()) {
+        qCWarning(KGAPIDebug) << "Checksum of the file is not known, it won't be verified";
+        d->verifyChecksum = false;
+    }
+    d->createSegments();
+    if (d->verifyChecksum && !d->segments.isEmpty() && !d->device->isReadable()) {
+        qCWarning(KGAPIDebug) << "Can't read downloaded data back from the device, checksum won't be verified";
+        d->verifyChecksum = false;
+    }
+    if (d->verifyChecksum && d->segments.isEmpty() && !d->seedChecksum()) {
+        qCWarning(KGAPIDebug) << "Can't read previously downloaded data from the device, checksum won't be verified";
+        d->verifyChecksum = false;
+    }
+
+    if (!d->segments.isEmpty()) {
+        // All segments are requested right away, Job sends as many of them
+        // concurrently as maxConcurrentRequests() allows
+        for (const auto &segment : std::as_const(d->segments)) {
+            d->requestSegment(segment);
+        }
+        return;
+    }
+
     QNetworkRequest request(d->url);
+    d->setStreamRange(request);
     enqueueRequest(request);
 }
 
@@ -77,17 +531,104 @@ void FileFetchContentJob::dispatchRequest(QNetworkAccessManager *accessManager,
     Q_UNUSED(data)
     Q_UNUSED(contentType)
 
-    QNetworkReply *reply = accessManager->get(request);
-    connect(reply, &QNetworkReply::downloadProgress, this, [this](qint64 downloaded, qint64 total) {
-        d->_k_downloadProgress(downloaded, total);
-    });
+    // The content is written to the device as it arrives, so it must not be compressed
+    QNetworkRequest r = request;
+    r.setRawHeader("Accept-Encoding", "identity");
+    if (d->segments.isEmpty()) {
+        // Job re-sends the request as it was enqueued, continue from the first byte not written yet
+        d->setStreamRange(r);
+    }
+
+    d->skip = -1;
+    QNetworkReply *reply = accessManager->get(r);
+    if (d->segments.isEmpty()) {
+        connect(reply, &QNetworkReply::downloadProgress, this, [this](qint64 downloaded, qint64 total) {
+            d->_k_downloadProgress(downloaded, total);
+        });
+    }
+    if (d->device) {
+        connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+            d->_k_readyRead(reply);
+        });
+    }
 }
 
 void FileFetchContentJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
-    Q_UNUSED(reply)
+    if (d->segments.isEmpty()) {
+        // When streaming, rawData only contains what has not been written yet
+        if (!d->processData(reply, rawData)) {
+            emitFinished();
+            return;
+        }
+
+        // The connection was closed before the whole content has been received
+        if (reply->error() != QNetworkReply::NoError && !d->isStreamComplete()) {
+            if (!d->retryStream()) {
+                qCWarning(KGAPIDebug) << "Network error" << reply->error() << reply->errorString();
+                setError(KGAPI2::NetworkError);
+                setErrorString(tr("Network error: %1").arg(reply->errorString()));
+                emitFinished();
+            }
+            return;
+        }
+
+        d->finish();
+        return;
+    }
+
+    if (!d->processSegmentData(reply, rawData)) {
+        emitFinished();
+        return;
+    }
+
+    // The server may have closed the connection early, ask for the rest of the segment
+    Segment *segment = d->segmentForRequest(currentRequest());
+    if (segment && segment->received < segment->size()) {
+        if (++segment->retries > MaxSegmentRetries) {
+            setError(KGAPI2::InvalidResponse);
+            setErrorString(tr("Failed downloading segment of the file"));
+            emitFinished();
+            return;
+        }
+        qCDebug(KGAPIDebug) << "Segment ending at" << segment->last << "is incomplete, requesting the rest";
+        d->requestSegment(*segment);
+        return;
+    }
+
+    const bool complete = std::all_of(d->segments.cbegin(), d->segments.cend(), [](const Segment &segment) {
+        return segment.received == segment.size();
+    });
+    if (complete) {
+        d->finish();
+    }
+}
+
+bool FileFetchContentJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    // Google refuses ranges starting at the end of the file, there's nothing left to download
+    if (statusCode == KGAPI2::RangeNotSatisfiable && d->resumeOffset > 0 && d->resumeOffset == d->expectedSize) {
+        qCDebug(KGAPIDebug) << "Download has already been completed";
+        d->finish();
+        return true;
+    }
+
+    // Network and server errors are usually transient, download the rest of the content or segment again
+    // (exceeded quota is left to Job, which sends the request again once it's allowed to)
+    const bool transient = statusCode == 0 || (statusCode >= KGAPI2::InternalError && statusCode != KGAPI2::QuotaExceeded);
+    if (d->segments.isEmpty() && transient && d->retryStream()) {
+        return true;
+    }
+
+    Segment *segment = d->segments.isEmpty() ? nullptr : d->segmentForRequest(currentRequest());
+    if (segment && transient && segment->retries < MaxSegmentRetries) {
+        ++segment->retries;
+        qCWarning(KGAPIDebug) << "Downloading segment ending at" << segment->last << "failed with" << statusCode << ", retrying";
+        d->requestSegment(*segment);
+        return true;
+    }
 
-    d->fileData = rawData;
+    return FetchJob::handleError(statusCode, rawData);
 }
 
 ObjectsList FileFetchContentJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
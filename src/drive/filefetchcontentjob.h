@@ -16,6 +16,13 @@ namespace KGAPI2
 namespace Drive
 {
 
+/**
+ * @brief A job to download content of a file
+ *
+ * By default the whole content is kept in memory and returned by data().
+ * Large files should rather be streamed into a device set by setOutputDevice(),
+ * which also allows resuming an interrupted download with setResumeOffset().
+ */
 class KGAPIDRIVE_EXPORT FileFetchContentJob : public KGAPI2::FetchJob
 {
     Q_OBJECT
@@ -25,11 +32,110 @@ public:
     explicit FileFetchContentJob(const QUrl &url, const AccountPtr &account, QObject *parent = nullptr);
     ~FileFetchContentJob() override;
 
+    /**
+     * @brief Returns the downloaded content
+     *
+     * Empty when the content has been written into outputDevice().
+     */
     [[nodiscard]] QByteArray data() const;
 
+    /**
+     * @brief Sets device to write the downloaded content into
+     *
+     * The content is written into the device as it is being received, instead
+     * of being kept in memory. The device must be open for writing and is not
+     * closed when the job finishes. The job does not take ownership of the
+     * device.
+     *
+     * @since 6.1
+     */
+    void setOutputDevice(QIODevice *device);
+    [[nodiscard]] QIODevice *outputDevice() const;
+
+    /**
+     * @brief Sets amount of bytes that have already been downloaded
+     *
+     * Only the content following the first @p offset bytes is requested.
+     * When streaming into outputDevice(), the content is appended at the
+     * current position of the device, which should be right after the data
+     * downloaded previously.
+     *
+     * @since 6.1
+     */
+    void setResumeOffset(qint64 offset);
+    [[nodiscard]] qint64 resumeOffset() const;
+
+    /**
+     * @brief Sets amount of bytes to download
+     *
+     * Only @p length bytes following the resumeOffset() are requested, which
+     * allows reading a slice of a large file. A negative value, which is the
+     * default, downloads the content up to the end of the file.
+     *
+     * A slice is always downloaded in a single request and its checksum is
+     * not verified.
+     *
+     * @since 6.1
+     */
+    void setLength(qint64 length);
+    [[nodiscard]] qint64 length() const;
+
+    /**
+     * @brief Sets whether to verify MD5 checksum of the downloaded content
+     *
+     * The checksum is computed while the content is being received and
+     * compared against File::md5Checksum() of the file passed to the
+     * constructor. The job fails with KGAPI2::InvalidResponse when they
+     * differ.
+     *
+     * When resuming a download, the previously downloaded data are read
+     * back from outputDevice(), so the device must be readable and
+     * random-access. Otherwise the checksum cannot be verified.
+     *
+     * Disabled by default.
+     *
+     * @since 6.1
+     */
+    void setVerifyChecksum(bool verify);
+    [[nodiscard]] bool verifyChecksum() const;
+
+    /**
+     * @brief Sets into how many segments to split the download
+     *
+     * When larger than 1, the content is split into up to @p count byte
+     * ranges of at least 1 MiB which are downloaded concurrently and written
+     * at their respective offsets into outputDevice(). A segment that fails
+     * with a network or server error is downloaded again from where it has
+     * been interrupted.
+     *
+     * Requires a random-access outputDevice(), for example a QFile, and the
+     * size of the file to be known, so the job must be constructed with a
+     * File. Otherwise the content is downloaded in a single request. How many
+     * segments are downloaded at the same time is limited by
+     * Job::maxConcurrentRequests().
+     *
+     * When verifying the checksum of a segmented download, the content is read
+     * back from outputDevice() once all segments have been downloaded.
+     *
+     * @since 6.1
+     */
+    void setSegmentCount(int count);
+    [[nodiscard]] int segmentCount() const;
+
+    /**
+     * @brief Returns amount of bytes received by this job
+     *
+     * Does not include the resumeOffset(), so the total size of the content
+     * is resumeOffset() + downloadedSize().
+     *
+     * @since 6.1
+     */
+    [[nodiscard]] qint64 downloadedSize() const;
+
 protected:
     void start() override;
     void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
     void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
 
     KGAPI2::ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
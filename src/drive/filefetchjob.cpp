@@ -25,6 +25,7 @@ class Q_DECL_HIDDEN FileFetchJob::Private
 public:
     Private(FileFetchJob *parent);
     void processNext();
+    void enqueueRequest(QUrl url);
 
     FileSearchQuery searchQuery;
     QStringList filesIDs;
@@ -47,10 +48,8 @@ FileFetchJob::Private::Private(FileFetchJob *parent)
 
 void FileFetchJob::Private::processNext()
 {
-    QUrl url;
-
     if (isFeed) {
-        url = DriveService::fetchFilesUrl();
+        QUrl url = DriveService::fetchFilesUrl();
 
         QUrlQuery query(url);
         if (!searchQuery.isEmpty()) {
@@ -74,25 +73,36 @@ void FileFetchJob::Private::processNext()
                                 File::Fields::SelfLink,
                                 Job::buildSubfields(File::Fields::Items, fields)});
         }
-    } else {
-        if (filesIDs.isEmpty()) {
-            q->emitFinished();
-            return;
-        }
 
-        const QString fileId = filesIDs.takeFirst();
-        url = DriveService::fetchFileUrl(fileId);
+        q->enablePipelinedPagination(File::Fields::NextLink, QString());
+        enqueueRequest(url);
+        return;
+    }
 
-        if (!fields.isEmpty()) {
-            // Deserializing requires kind attribute, always force add it
-            if (!fields.contains(File::Fields::Kind)) {
-                fields << File::Fields::Kind;
-            }
-            Job *baseJob = dynamic_cast<Job *>(q);
-            baseJob->setFields(fields);
+    if (filesIDs.isEmpty()) {
+        q->emitFinished();
+        return;
+    }
+
+    if (!fields.isEmpty()) {
+        // Deserializing requires kind attribute, always force add it
+        if (!fields.contains(File::Fields::Kind)) {
+            fields << File::Fields::Kind;
         }
+        Job *baseJob = dynamic_cast<Job *>(q);
+        baseJob->setFields(fields);
     }
 
+    // All files are requested at once, so that the requests can be sent
+    // concurrently or grouped into a batch request
+    q->setBatchUrl(DriveService::batchUrl());
+    for (const QString &fileId : std::as_const(filesIDs)) {
+        enqueueRequest(DriveService::fetchFileUrl(fileId));
+    }
+}
+
+void FileFetchJob::Private::enqueueRequest(QUrl url)
+{
     QUrlQuery withDriveSupportQuery(url);
     withDriveSupportQuery.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
     url.setQuery(withDriveSupportQuery);
@@ -220,20 +230,18 @@ ObjectsList FileFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
     ContentType ct = Utils::stringToContentType(contentType);
     if (ct == KGAPI2::JSON) {
-        if (d->isFeed) {
+        if (d->isFeed && parseInThreadPool()) {
+            parseItemsInThreadPool(reply, rawData, [](const QByteArray &rawData, FeedData &feedData) {
+                ObjectsList items;
+                items << File::fromJSONFeed(rawData, feedData);
+                return items;
+            });
+        } else if (d->isFeed) {
             FeedData feedData;
 
             items << File::fromJSONFeed(rawData, feedData);
-
-            if (feedData.nextPageUrl.isValid()) {
-                QNetworkRequest request(feedData.nextPageUrl);
-                enqueueRequest(request);
-            }
-
         } else {
             items << File::fromJSON(rawData);
-
-            d->processNext();
         }
     } else {
         setError(KGAPI2::InvalidResponse);
@@ -0,0 +1,256 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filemirror.h"
+#include "change.h"
+#include "debug.h"
+#include "file.h"
+#include "pathindex.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QMultiMap>
+#include <QSaveFile>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static const QString StoreMagic = QStringLiteral("kgapi-drive-mirror");
+static const int StoreVersion = 1;
+}
+
+class Q_DECL_HIDDEN FileMirror::Private
+{
+public:
+    void addFile(const FilePtr &file);
+    FilePtr takeFile(const QString &fileId);
+
+    QString storePath;
+    qlonglong startChangeId = 0;
+
+    QHash<QString, FilePtr> files;
+    PathIndex paths;
+    QMultiMap<QDateTime, QString> modified;
+};
+
+void FileMirror::Private::addFile(const FilePtr &file)
+{
+    const QString id = file->id();
+    files.insert(id, file);
+    paths.insert(file);
+    if (file->modifiedDate().isValid()) {
+        modified.insert(file->modifiedDate(), id);
+    }
+}
+
+FilePtr FileMirror::Private::takeFile(const QString &fileId)
+{
+    const FilePtr file = files.take(fileId);
+    if (!file) {
+        return file;
+    }
+
+    paths.remove(fileId);
+    if (file->modifiedDate().isValid()) {
+        modified.remove(file->modifiedDate(), fileId);
+    }
+
+    return file;
+}
+
+FileMirror::FileMirror(const QString &storePath)
+    : d(new Private)
+{
+    d->storePath = storePath;
+}
+
+FileMirror::~FileMirror() = default;
+
+QString FileMirror::storePath() const
+{
+    return d->storePath;
+}
+
+bool FileMirror::load()
+{
+    clear();
+
+    QFile file(d->storePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(KGAPIDebug) << "Failed to open Drive mirror" << d->storePath << ":" << file.errorString();
+        return false;
+    }
+
+    const QCborMap store = QCborValue::fromCbor(file.readAll()).toMap();
+    if (store.value(QStringLiteral("magic")).toString() != StoreMagic || store.value(QStringLiteral("version")).toInteger() != StoreVersion) {
+        qCWarning(KGAPIDebug) << d->storePath << "is not a valid Drive mirror";
+        return false;
+    }
+
+    const QCborArray files = store.value(QStringLiteral("files")).toArray();
+    for (const auto &value : files) {
+        const FilePtr mirrored = File::fromJSON(QJsonDocument(value.toMap().toJsonObject()).toJson(QJsonDocument::Compact));
+        if (!mirrored || mirrored->id().isEmpty()) {
+            qCWarning(KGAPIDebug) << d->storePath << "contains an invalid file";
+            clear();
+            return false;
+        }
+        d->addFile(mirrored);
+    }
+    d->paths.setRootFolderId(store.value(QStringLiteral("rootFolderId")).toString());
+    d->startChangeId = store.value(QStringLiteral("startChangeId")).toInteger();
+
+    return true;
+}
+
+bool FileMirror::save() const
+{
+    QCborArray files;
+    for (const auto &file : std::as_const(d->files)) {
+        files.append(QCborMap::fromJsonObject(QJsonDocument::fromJson(File::toJSON(file)).object()));
+    }
+
+    QCborMap store;
+    store.insert(QStringLiteral("magic"), StoreMagic);
+    store.insert(QStringLiteral("version"), StoreVersion);
+    store.insert(QStringLiteral("startChangeId"), d->startChangeId);
+    store.insert(QStringLiteral("rootFolderId"), d->paths.rootFolderId());
+    store.insert(QStringLiteral("files"), files);
+
+    QSaveFile file(d->storePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to write Drive mirror" << d->storePath << ":" << file.errorString();
+        return false;
+    }
+    file.write(store.toCborValue().toCbor());
+    if (!file.commit()) {
+        qCWarning(KGAPIDebug) << "Failed to write Drive mirror" << d->storePath << ":" << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool FileMirror::isPopulated() const
+{
+    return d->startChangeId > 0;
+}
+
+qlonglong FileMirror::startChangeId() const
+{
+    return d->startChangeId;
+}
+
+void FileMirror::setStartChangeId(qlonglong changeId)
+{
+    d->startChangeId = changeId;
+}
+
+QString FileMirror::rootFolderId() const
+{
+    return d->paths.rootFolderId();
+}
+
+void FileMirror::setRootFolderId(const QString &folderId)
+{
+    d->paths.setRootFolderId(folderId);
+}
+
+const PathIndex &FileMirror::pathIndex() const
+{
+    return d->paths;
+}
+
+void FileMirror::insert(const FilePtr &file)
+{
+    if (!file || file->id().isEmpty()) {
+        return;
+    }
+
+    d->takeFile(file->id());
+    if (file->labels() && file->labels()->trashed()) {
+        return;
+    }
+    d->addFile(file);
+}
+
+void FileMirror::remove(const QString &fileId)
+{
+    d->takeFile(fileId);
+}
+
+void FileMirror::applyChanges(const ChangesList &changes)
+{
+    for (const auto &change : changes) {
+        if (change->deleted() || !change->file()) {
+            remove(change->fileId());
+        } else {
+            insert(change->file());
+        }
+        d->startChangeId = qMax(d->startChangeId, change->id() + 1);
+    }
+}
+
+void FileMirror::clear()
+{
+    d->files.clear();
+    d->paths.clear();
+    d->modified.clear();
+    d->startChangeId = 0;
+}
+
+int FileMirror::count() const
+{
+    return d->files.size();
+}
+
+FilePtr FileMirror::file(const QString &fileId) const
+{
+    return d->files.value(fileId);
+}
+
+FilesList FileMirror::children(const QString &folderId) const
+{
+    FilesList files;
+    const auto ids = d->paths.children(folderId);
+    files.reserve(ids.size());
+    for (const auto &id : ids) {
+        files << d->files.value(id);
+    }
+    return files;
+}
+
+QString FileMirror::path(const QString &fileId) const
+{
+    return d->paths.path(fileId);
+}
+
+FilePtr FileMirror::fileAtPath(const QString &path) const
+{
+    QString fileId;
+    if (d->paths.resolve(path, &fileId) != PathIndex::Found) {
+        return FilePtr();
+    }
+    return d->files.value(fileId);
+}
+
+FilesList FileMirror::modifiedSince(const QDateTime &time) const
+{
+    FilesList files;
+    const auto &modified = d->modified;
+    for (auto it = modified.upperBound(time), end = modified.cend(); it != end; ++it) {
+        files << d->files.value(it.value());
+    }
+    return files;
+}
@@ -0,0 +1,166 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QString>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+class PathIndex;
+
+/**
+ * @headerfile filemirror.h
+ * @brief A local copy of metadata of all files in Drive
+ *
+ * The mirror keeps metadata of files indexed by their ID, parent folders and
+ * modification date, so that listing a folder, computing the path of a file
+ * or finding recently modified files does not need any request to the server.
+ *
+ * The mirror is filled and kept up to date by FileMirrorSyncJob. The first
+ * sync lists all files, later syncs only apply the changes since the previous
+ * one, starting from startChangeId(). When a store path is set, the mirror
+ * can be saved into and loaded from a compact binary file, so that it only
+ * needs to be synced with the changes made while the application was not
+ * running.
+ *
+ * Trashed files are not part of the mirror.
+ *
+ * Titles and parents of the files are kept in a PathIndex, see pathIndex().
+ *
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT FileMirror
+{
+public:
+    explicit FileMirror(const QString &storePath = QString());
+    ~FileMirror();
+
+    /**
+     * @brief Returns path of the file the mirror is saved into
+     */
+    [[nodiscard]] QString storePath() const;
+
+    /**
+     * @brief Loads the mirror from storePath()
+     *
+     * Returns false when the file does not exist or is not a valid mirror,
+     * in which case the mirror is empty.
+     */
+    bool load();
+
+    /**
+     * @brief Saves the mirror into storePath()
+     *
+     * The file is replaced atomically, so a failure never leaves a partially
+     * written mirror behind.
+     */
+    bool save() const;
+
+    /**
+     * @brief Returns whether the mirror contains a full listing of the files
+     */
+    [[nodiscard]] bool isPopulated() const;
+
+    /**
+     * @brief Returns ID of the first change that has not been applied yet
+     *
+     * 0 when the mirror has not been populated.
+     */
+    [[nodiscard]] qlonglong startChangeId() const;
+    void setStartChangeId(qlonglong changeId);
+
+    /**
+     * @brief Returns ID of the root folder of My Drive, or "root" if not known yet
+     */
+    [[nodiscard]] QString rootFolderId() const;
+    void setRootFolderId(const QString &folderId);
+
+    /**
+     * @brief Adds or replaces metadata of @p file
+     *
+     * Trashed files are removed from the mirror instead.
+     */
+    void insert(const FilePtr &file);
+
+    /**
+     * @brief Removes metadata of the file @p fileId
+     */
+    void remove(const QString &fileId);
+
+    /**
+     * @brief Applies @p changes and advances startChangeId() past them
+     */
+    void applyChanges(const ChangesList &changes);
+
+    /**
+     * @brief Removes all files and resets startChangeId()
+     */
+    void clear();
+
+    [[nodiscard]] int count() const;
+
+    /**
+     * @brief Returns metadata of the file @p fileId, or null when it's not mirrored
+     */
+    [[nodiscard]] FilePtr file(const QString &fileId) const;
+
+    /**
+     * @brief Returns files in the folder @p folderId
+     *
+     * The root folder can also be referred to as "root".
+     */
+    [[nodiscard]] FilesList children(const QString &folderId) const;
+
+    /**
+     * @brief Returns path of the file @p fileId from the root folder
+     *
+     * The path consists of titles of the file and its parent folders separated
+     * by slashes, for example "/Projects/report.pdf". When a file has more
+     * parents, the first one is used. Returns an empty string when the file
+     * is not in My Drive, for example because it has only been shared with
+     * the user.
+     */
+    [[nodiscard]] QString path(const QString &fileId) const;
+
+    /**
+     * @brief Returns metadata of the file at @p path, or null when there is none
+     *
+     * @see PathIndex::resolve()
+     */
+    [[nodiscard]] FilePtr fileAtPath(const QString &path) const;
+
+    /**
+     * @brief Returns files modified after @p time, oldest first
+     */
+    [[nodiscard]] FilesList modifiedSince(const QDateTime &time) const;
+
+    /**
+     * @brief Returns index of titles and parents of the mirrored files
+     */
+    [[nodiscard]] const PathIndex &pathIndex() const;
+
+private:
+    Q_DISABLE_COPY(FileMirror)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
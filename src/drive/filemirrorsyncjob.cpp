@@ -0,0 +1,188 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filemirrorsyncjob.h"
+#include "about.h"
+#include "aboutfetchjob.h"
+#include "change.h"
+#include "changefetchjob.h"
+#include "debug.h"
+#include "file.h"
+#include "filefetchjob.h"
+#include "filemirror.h"
+#include "filesearchquery.h"
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+class Q_DECL_HIDDEN FileMirrorSyncJob::Private
+{
+public:
+    Private(FileMirrorSyncJob *parent);
+
+    void fetchAbout();
+    void fetchFiles(const AboutPtr &about);
+    void fetchChanges();
+    bool checkChildJob(Job *job);
+    void finish();
+
+    FileMirror *mirror = nullptr;
+    ChangesList changes;
+
+private:
+    FileMirrorSyncJob *const q;
+};
+
+FileMirrorSyncJob::Private::Private(FileMirrorSyncJob *parent)
+    : q(parent)
+{
+}
+
+void FileMirrorSyncJob::Private::fetchAbout()
+{
+    auto job = new AboutFetchJob(q->account(), q);
+    QObject::connect(job, &Job::finished, q, [this, job]() {
+        if (!checkChildJob(job)) {
+            return;
+        }
+
+        const AboutPtr about = job->aboutData();
+        if (!about) {
+            q->setError(KGAPI2::InvalidResponse);
+            q->setErrorString(FileMirrorSyncJob::tr("Invalid response"));
+            q->emitFinished();
+            return;
+        }
+        fetchFiles(about);
+    });
+}
+
+void FileMirrorSyncJob::Private::fetchFiles(const AboutPtr &about)
+{
+    // Changes made while listing are applied again by the next sync, which is harmless
+    const qlonglong largestChangeId = about->largestChangeId();
+    const QString rootFolderId = about->rootFolderId();
+
+    FileSearchQuery query;
+    query.addQuery(FileSearchQuery::Trashed, FileSearchQuery::Equals, false);
+    auto job = new FileFetchJob(query, q->account(), q);
+    QObject::connect(job, &Job::finished, q, [this, job, largestChangeId, rootFolderId]() {
+        if (!checkChildJob(job)) {
+            return;
+        }
+
+        mirror->clear();
+        const auto items = job->items();
+        for (const auto &item : items) {
+            mirror->insert(item.dynamicCast<File>());
+        }
+        mirror->setRootFolderId(rootFolderId);
+        mirror->setStartChangeId(largestChangeId + 1);
+        qCDebug(KGAPIDebug) << "Drive mirror populated with" << mirror->count() << "files";
+        finish();
+    });
+}
+
+void FileMirrorSyncJob::Private::fetchChanges()
+{
+    auto job = new ChangeFetchJob(q->account(), q);
+    job->setStartChangeId(mirror->startChangeId());
+    job->setIncludeDeleted(true);
+    QObject::connect(job, &Job::finished, q, [this, job]() {
+        if (!checkChildJob(job)) {
+            return;
+        }
+
+        const auto items = job->items();
+        changes.reserve(items.size());
+        for (const auto &item : items) {
+            changes << item.dynamicCast<Change>();
+        }
+        mirror->applyChanges(changes);
+        qCDebug(KGAPIDebug) << "Applied" << changes.size() << "changes to Drive mirror";
+        finish();
+    });
+}
+
+bool FileMirrorSyncJob::Private::checkChildJob(Job *job)
+{
+    job->deleteLater();
+    if (job->error() == KGAPI2::NoError) {
+        return true;
+    }
+
+    q->setError(job->error());
+    q->setErrorString(job->errorString());
+    q->emitFinished();
+    return false;
+}
+
+void FileMirrorSyncJob::Private::finish()
+{
+    if (!mirror->storePath().isEmpty() && !mirror->save()) {
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(FileMirrorSyncJob::tr("Failed to save Drive mirror"));
+    }
+    q->emitFinished();
+}
+
+FileMirrorSyncJob::FileMirrorSyncJob(FileMirror *mirror, const AccountPtr &account, QObject *parent)
+    : Job(account, parent)
+    , d(new Private(this))
+{
+    d->mirror = mirror;
+}
+
+FileMirrorSyncJob::~FileMirrorSyncJob() = default;
+
+FileMirror *FileMirrorSyncJob::mirror() const
+{
+    return d->mirror;
+}
+
+ChangesList FileMirrorSyncJob::changes() const
+{
+    return d->changes;
+}
+
+void FileMirrorSyncJob::start()
+{
+    d->changes.clear();
+
+    if (!d->mirror) {
+        qCWarning(KGAPIDebug) << "No mirror to sync";
+        emitFinished();
+        return;
+    }
+
+    // Child jobs send the requests, they also take care of pagination
+    if (d->mirror->isPopulated()) {
+        d->fetchChanges();
+    } else {
+        d->fetchAbout();
+    }
+}
+
+void FileMirrorSyncJob::dispatchRequest(QNetworkAccessManager *accessManager,
+                                        const QNetworkRequest &request,
+                                        const QByteArray &data,
+                                        const QString &contentType)
+{
+    Q_UNUSED(accessManager)
+    Q_UNUSED(request)
+    Q_UNUSED(data)
+    Q_UNUSED(contentType)
+}
+
+void FileMirrorSyncJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    Q_UNUSED(reply)
+    Q_UNUSED(rawData)
+}
+
+#include "moc_filemirrorsyncjob.cpp"
@@ -0,0 +1,69 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "job.h"
+#include "kgapidrive_export.h"
+
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+class FileMirror;
+
+/**
+ * @headerfile filemirrorsyncjob.h
+ * @brief A job to bring a FileMirror up to date
+ *
+ * When the mirror has not been populated yet, the job lists all files that
+ * are not trashed and remembers the ID of the latest change made before the
+ * listing. Otherwise it only fetches the changes made since the previous
+ * sync and applies them to the mirror.
+ *
+ * When the mirror has a store path, it is saved once it has been updated.
+ * The job does not take ownership of the mirror, which must exist until the
+ * job finishes.
+ *
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT FileMirrorSyncJob : public KGAPI2::Job
+{
+    Q_OBJECT
+
+public:
+    explicit FileMirrorSyncJob(FileMirror *mirror, const AccountPtr &account, QObject *parent = nullptr);
+    ~FileMirrorSyncJob() override;
+
+    [[nodiscard]] FileMirror *mirror() const;
+
+    /**
+     * @brief Returns changes applied to the mirror
+     *
+     * Empty when the mirror has been populated by listing all files.
+     */
+    [[nodiscard]] ChangesList changes() const;
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
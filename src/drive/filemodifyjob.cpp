@@ -39,6 +39,7 @@ FileModifyJob::FileModifyJob(const FilePtr &metadata, const AccountPtr &account,
     : FileAbstractUploadJob(metadata, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PutOperation);
     d->files.insert(QStringLiteral("?=0"), metadata->id());
     setSerializationOptions(File::ExcludeCreationDate);
 }
@@ -47,6 +48,7 @@ FileModifyJob::FileModifyJob(const QString &filePath, const QString &fileId, con
     : FileAbstractUploadJob(filePath, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PutOperation);
     d->files.insert(filePath, fileId);
 }
 
@@ -54,6 +56,7 @@ FileModifyJob::FileModifyJob(const QString &filePath, const FilePtr &metaData, c
     : FileAbstractUploadJob(filePath, metaData, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PutOperation);
     d->files.insert(filePath, metaData->id());
     setSerializationOptions(File::ExcludeCreationDate);
 }
@@ -62,6 +65,7 @@ FileModifyJob::FileModifyJob(const QMap<QString, QString> &files, const AccountP
     : FileAbstractUploadJob(files.keys(), account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PutOperation);
     d->files = files;
 }
 
@@ -69,6 +73,7 @@ FileModifyJob::FileModifyJob(const QMap<QString, FilePtr> &files, const AccountP
     : FileAbstractUploadJob(files, account, parent)
     , d(new Private)
 {
+    setUploadOperation(QNetworkAccessManager::PutOperation);
     QMap<QString, FilePtr>::ConstIterator iter = files.constBegin();
     QMap<QString, FilePtr>::ConstIterator iterEnd = files.constEnd();
     for (; iter != iterEnd; ++iter) {
@@ -0,0 +1,341 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filetransferjob.h"
+#include "debug.h"
+#include "filecopyjob.h"
+#include "filecreatejob.h"
+#include "fileresumablecreatejob.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultMaxConcurrentTransfers = 4;
+static constexpr qint64 DefaultMaxBytesInFlight = 64 * 1024 * 1024;
+static constexpr qint64 DefaultResumableThreshold = 5 * 1024 * 1024;
+}
+
+class Q_DECL_HIDDEN FileTransferJob::Private
+{
+public:
+    struct Transfer {
+        enum Type {
+            Upload,
+            Copy,
+        };
+
+        Type type = Upload;
+        QString source;
+        FilePtr metadata;
+        qint64 size = 0;
+        qint64 sent = 0;
+    };
+
+    Private(FileTransferJob *parent);
+
+    void startTransfers();
+    void startTransfer(const Transfer &transfer);
+    void transferProgress(Job *job, int processed, int total);
+    void transferFinished(Job *job);
+    void emitTransferProgress();
+
+    QList<Transfer> transfers;
+    QList<Transfer> pending;
+    QHash<Job *, Transfer> running;
+
+    int maxConcurrentTransfers = DefaultMaxConcurrentTransfers;
+    qint64 maxBytesInFlight = DefaultMaxBytesInFlight;
+    qint64 resumableThreshold = DefaultResumableThreshold;
+
+    qint64 bytesInFlight = 0;
+    qint64 bytesTotal = 0;
+    qint64 bytesFinished = 0;
+    int finishedTransfers = 0;
+    QElapsedTimer elapsed;
+
+    QMap<QString, FilePtr> files;
+    QMap<QString, QString> failedTransfers;
+
+private:
+    FileTransferJob *const q;
+};
+
+FileTransferJob::Private::Private(FileTransferJob *parent)
+    : q(parent)
+{
+}
+
+void FileTransferJob::Private::startTransfers()
+{
+    // pending is sorted by size, so when the next transfer does not fit into
+    // the limits, none of the following ones would either
+    while (!pending.isEmpty() && running.size() < maxConcurrentTransfers) {
+        const Transfer &next = pending.constFirst();
+        if (!running.isEmpty() && bytesInFlight + next.size > maxBytesInFlight) {
+            break;
+        }
+        startTransfer(pending.takeFirst());
+    }
+
+    if (running.isEmpty()) {
+        q->emitFinished();
+    }
+}
+
+void FileTransferJob::Private::startTransfer(const Transfer &transfer)
+{
+    Job *job = nullptr;
+    if (transfer.type == Transfer::Copy) {
+        job = new FileCopyJob(transfer.source, transfer.metadata, q->account(), q);
+    } else if (transfer.size >= resumableThreshold) {
+        auto device = new QFile(transfer.source);
+        if (!device->open(QIODevice::ReadOnly)) {
+            qCWarning(KGAPIDebug) << "Failed to open" << transfer.source << ":" << device->errorString();
+            failedTransfers.insert(transfer.source, device->errorString());
+            delete device;
+            ++finishedTransfers;
+            Q_EMIT q->fileFinished(q, transfer.source, FilePtr());
+            return;
+        }
+        auto resumableJob = new FileResumableCreateJob(device, transfer.metadata, q->account(), q);
+        resumableJob->setUploadSize(transfer.size);
+        device->setParent(resumableJob);
+        job = resumableJob;
+    } else {
+        job = new FileCreateJob(transfer.source, transfer.metadata, q->account(), q);
+    }
+
+    qCDebug(KGAPIDebug) << "Starting transfer of" << transfer.source << "," << transfer.size << "bytes";
+    running.insert(job, transfer);
+    bytesInFlight += transfer.size;
+
+    QObject::connect(job, &Job::progress, q, [this](Job *transferJob, int processed, int total) {
+        transferProgress(transferJob, processed, total);
+    });
+    QObject::connect(job, &Job::finished, q, [this](Job *transferJob) {
+        transferFinished(transferJob);
+    });
+}
+
+void FileTransferJob::Private::transferProgress(Job *job, int processed, int total)
+{
+    auto it = running.find(job);
+    if (it == running.end() || total <= 0 || it->type == Transfer::Copy) {
+        return;
+    }
+
+    // Child jobs scale their progress to fit into int, only the ratio is meaningful
+    it->sent = static_cast<qint64>(static_cast<double>(it->size) * qBound(0, processed, total) / total);
+    Q_EMIT q->fileProgress(q, it->source, it->sent, it->size);
+    emitTransferProgress();
+}
+
+void FileTransferJob::Private::transferFinished(Job *job)
+{
+    const Transfer transfer = running.take(job);
+    bytesInFlight -= transfer.size;
+    ++finishedTransfers;
+
+    FilePtr file;
+    if (job->error() != KGAPI2::NoError) {
+        failedTransfers.insert(transfer.source, job->errorString());
+    } else if (transfer.type == Transfer::Copy) {
+        file = static_cast<FileCopyJob *>(job)->files().value(0);
+    } else if (auto resumableJob = qobject_cast<FileResumableCreateJob *>(job)) {
+        file = resumableJob->metadata();
+    } else {
+        file = static_cast<FileCreateJob *>(job)->files().value(transfer.source);
+    }
+    job->deleteLater();
+
+    if (file) {
+        files.insert(transfer.source, file);
+        bytesFinished += transfer.size;
+    } else if (!failedTransfers.contains(transfer.source)) {
+        // Upload jobs skip empty and inaccessible files without an error
+        failedTransfers.insert(transfer.source, FileTransferJob::tr("File is empty or inaccessible"));
+    }
+    qCDebug(KGAPIDebug) << "Transfer of" << transfer.source << (file ? "finished" : "failed");
+
+    Q_EMIT q->fileFinished(q, transfer.source, file);
+    q->emitProgress(finishedTransfers, transfers.size());
+    emitTransferProgress();
+
+    startTransfers();
+}
+
+void FileTransferJob::Private::emitTransferProgress()
+{
+    Q_EMIT q->transferProgress(q, q->bytesTransferred(), bytesTotal, q->bytesPerSecond());
+}
+
+FileTransferJob::FileTransferJob(const AccountPtr &account, QObject *parent)
+    : Job(account, parent)
+    , d(new Private(this))
+{
+}
+
+FileTransferJob::~FileTransferJob() = default;
+
+void FileTransferJob::addUpload(const QString &filePath, const FilePtr &metadata)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called addUpload() on running job. Ignoring.";
+        return;
+    }
+
+    Private::Transfer transfer;
+    transfer.type = Private::Transfer::Upload;
+    transfer.source = filePath;
+    transfer.metadata = metadata;
+    if (!transfer.metadata) {
+        transfer.metadata = FilePtr::create();
+        transfer.metadata->setTitle(QFileInfo(filePath).fileName());
+    }
+    d->transfers.append(transfer);
+}
+
+void FileTransferJob::addCopy(const QString &sourceFileId, const FilePtr &destinationFile)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called addCopy() on running job. Ignoring.";
+        return;
+    }
+
+    Private::Transfer transfer;
+    transfer.type = Private::Transfer::Copy;
+    transfer.source = sourceFileId;
+    transfer.metadata = destinationFile;
+    d->transfers.append(transfer);
+}
+
+int FileTransferJob::maxConcurrentTransfers() const
+{
+    return d->maxConcurrentTransfers;
+}
+
+void FileTransferJob::setMaxConcurrentTransfers(int transfers)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setMaxConcurrentTransfers() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxConcurrentTransfers = qMax(1, transfers);
+}
+
+qint64 FileTransferJob::maxBytesInFlight() const
+{
+    return d->maxBytesInFlight;
+}
+
+void FileTransferJob::setMaxBytesInFlight(qint64 bytes)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setMaxBytesInFlight() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxBytesInFlight = bytes;
+}
+
+qint64 FileTransferJob::resumableThreshold() const
+{
+    return d->resumableThreshold;
+}
+
+void FileTransferJob::setResumableThreshold(qint64 bytes)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setResumableThreshold() on running job. Ignoring.";
+        return;
+    }
+
+    d->resumableThreshold = bytes;
+}
+
+QMap<QString, FilePtr> FileTransferJob::files() const
+{
+    return d->files;
+}
+
+QMap<QString, QString> FileTransferJob::failedTransfers() const
+{
+    return d->failedTransfers;
+}
+
+qint64 FileTransferJob::bytesTransferred() const
+{
+    qint64 bytes = d->bytesFinished;
+    for (const auto &transfer : std::as_const(d->running)) {
+        bytes += transfer.sent;
+    }
+    return bytes;
+}
+
+qint64 FileTransferJob::bytesPerSecond() const
+{
+    if (!d->elapsed.isValid()) {
+        return 0;
+    }
+    return bytesTransferred() * 1000 / qMax<qint64>(d->elapsed.elapsed(), 1);
+}
+
+void FileTransferJob::start()
+{
+    d->files.clear();
+    d->failedTransfers.clear();
+    d->bytesInFlight = 0;
+    d->bytesTotal = 0;
+    d->bytesFinished = 0;
+    d->finishedTransfers = 0;
+
+    d->pending = d->transfers;
+    for (auto &transfer : d->pending) {
+        if (transfer.type == Private::Transfer::Upload) {
+            transfer.size = QFileInfo(transfer.source).size();
+            d->bytesTotal += transfer.size;
+        }
+    }
+    // Small files first, so that they don't have to wait for the large ones
+    std::stable_sort(d->pending.begin(), d->pending.end(), [](const auto &a, const auto &b) {
+        return a.size < b.size;
+    });
+
+    d->elapsed.start();
+    d->startTransfers();
+}
+
+void FileTransferJob::dispatchRequest(QNetworkAccessManager *accessManager,
+                                      const QNetworkRequest &request,
+                                      const QByteArray &data,
+                                      const QString &contentType)
+{
+    // All requests are sent by the transfer jobs
+    Q_UNUSED(accessManager)
+    Q_UNUSED(request)
+    Q_UNUSED(data)
+    Q_UNUSED(contentType)
+}
+
+void FileTransferJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    Q_UNUSED(reply)
+    Q_UNUSED(rawData)
+}
+
+#include "moc_filetransferjob.cpp"
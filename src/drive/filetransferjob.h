@@ -0,0 +1,144 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "file.h"
+#include "job.h"
+#include "kgapidrive_export.h"
+
+#include <QMap>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @headerfile filetransferjob.h
+ * @brief A job to upload and copy many files concurrently
+ *
+ * FileCreateJob and FileCopyJob process their files one after another. This
+ * job instead runs up to maxConcurrentTransfers() uploads and copies at the
+ * same time, as long as the size of the files being uploaded does not exceed
+ * maxBytesInFlight(). At least one transfer is always running, even when the
+ * file alone is larger than the limit.
+ *
+ * Transfers are started smallest first, so that small files are available
+ * quickly instead of waiting behind large ones. Files of at least
+ * resumableThreshold() bytes are uploaded in chunks through a resumable
+ * session, smaller files in a single multipart request. Copies happen on the
+ * server and are treated as transfers of zero bytes.
+ *
+ * Transfers are identified by their source, that is the local file path of
+ * an upload or the ID of the copied file. Transfers that fail are reported by
+ * failedTransfers() instead of failing the whole job.
+ *
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT FileTransferJob : public KGAPI2::Job
+{
+    Q_OBJECT
+
+public:
+    explicit FileTransferJob(const AccountPtr &account, QObject *parent = nullptr);
+    ~FileTransferJob() override;
+
+    /**
+     * @brief Uploads the local file @p filePath
+     *
+     * When @p metadata is null, the file is created with the name of the
+     * local file as title.
+     */
+    void addUpload(const QString &filePath, const FilePtr &metadata = FilePtr());
+
+    /**
+     * @brief Copies the file @p sourceFileId to @p destinationFile
+     */
+    void addCopy(const QString &sourceFileId, const FilePtr &destinationFile);
+
+    /**
+     * @brief Returns the maximum number of transfers running at the same time
+     *
+     * Defaults to 4.
+     */
+    [[nodiscard]] int maxConcurrentTransfers() const;
+    void setMaxConcurrentTransfers(int transfers);
+
+    /**
+     * @brief Returns the maximum total size of the files being uploaded at the same time
+     *
+     * Defaults to 64 MiB.
+     */
+    [[nodiscard]] qint64 maxBytesInFlight() const;
+    void setMaxBytesInFlight(qint64 bytes);
+
+    /**
+     * @brief Returns the size from which files are uploaded through a resumable session
+     *
+     * Defaults to 5 MiB.
+     */
+    [[nodiscard]] qint64 resumableThreshold() const;
+    void setResumableThreshold(qint64 bytes);
+
+    /**
+     * @brief Returns the files created by successful transfers, keyed by their source
+     */
+    [[nodiscard]] QMap<QString /* source */, FilePtr /* file */> files() const;
+
+    /**
+     * @brief Returns the sources of failed transfers and the reason they failed
+     */
+    [[nodiscard]] QMap<QString /* source */, QString /* error */> failedTransfers() const;
+
+    /**
+     * @brief Returns the number of bytes uploaded so far
+     */
+    [[nodiscard]] qint64 bytesTransferred() const;
+
+    /**
+     * @brief Returns the average upload throughput since the job started
+     */
+    [[nodiscard]] qint64 bytesPerSecond() const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when the upload progress of the file @p source changes
+     */
+    void fileProgress(KGAPI2::Job *job, const QString &source, qint64 bytesSent, qint64 bytesTotal);
+
+    /**
+     * @brief Emitted when the transfer of @p source finishes
+     *
+     * @p file is null when the transfer has failed.
+     */
+    void fileFinished(KGAPI2::Job *job, const QString &source, const KGAPI2::Drive::FilePtr &file);
+
+    /**
+     * @brief Emitted when the progress of all transfers changes
+     *
+     * Job::progress() reports the number of finished transfers instead.
+     */
+    void transferProgress(KGAPI2::Job *job, qint64 bytesTransferred, qint64 bytesTotal, qint64 bytesPerSecond);
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,280 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "pathindex.h"
+#include "change.h"
+#include "file.h"
+#include "parentreference.h"
+
+#include <QHash>
+#include <QMultiHash>
+#include <QSet>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static const QString RootAlias = QStringLiteral("root");
+
+struct Node {
+    QString title;
+    QStringList parents;
+    bool folder = false;
+};
+}
+
+class Q_DECL_HIDDEN PathIndex::Private
+{
+public:
+    QString folderId(const QString &folderId) const;
+    void adoptRoot(const QString &folderId);
+    void removeNode(const QString &fileId);
+
+    QString rootFolderId;
+    QHash<QString, Node> nodes;
+    // Parent folder ID to titles and IDs of files in the folder
+    QHash<QString, QMultiHash<QString, QString>> children;
+    // Parent folder ID to titles known not to exist in the folder
+    QHash<QString, QSet<QString>> missing;
+    QSet<QString> listedFolders;
+};
+
+QString PathIndex::Private::folderId(const QString &folderId) const
+{
+    if (folderId == RootAlias && !rootFolderId.isEmpty()) {
+        return rootFolderId;
+    }
+    return folderId;
+}
+
+void PathIndex::Private::adoptRoot(const QString &folderId)
+{
+    if (folderId.isEmpty() || folderId == RootAlias || folderId == rootFolderId) {
+        return;
+    }
+    rootFolderId = folderId;
+
+    // Move whatever has been learned about the root folder through its alias
+    const auto aliasChildren = children.take(RootAlias);
+    for (auto it = aliasChildren.cbegin(), end = aliasChildren.cend(); it != end; ++it) {
+        children[folderId].insert(it.key(), it.value());
+    }
+    for (auto &node : nodes) {
+        std::replace(node.parents.begin(), node.parents.end(), RootAlias, folderId);
+    }
+    if (missing.contains(RootAlias)) {
+        missing[folderId].unite(missing.take(RootAlias));
+    }
+    if (listedFolders.remove(RootAlias)) {
+        listedFolders.insert(folderId);
+    }
+}
+
+void PathIndex::Private::removeNode(const QString &fileId)
+{
+    const auto it = nodes.constFind(fileId);
+    if (it == nodes.cend()) {
+        return;
+    }
+
+    for (const auto &parentId : it->parents) {
+        auto childrenIt = children.find(parentId);
+        if (childrenIt != children.end()) {
+            childrenIt->remove(it->title, fileId);
+            if (childrenIt->isEmpty()) {
+                children.erase(childrenIt);
+            }
+        }
+    }
+    nodes.erase(it);
+}
+
+PathIndex::PathIndex()
+    : d(new Private)
+{
+}
+
+PathIndex::~PathIndex() = default;
+
+QString PathIndex::rootFolderId() const
+{
+    return d->rootFolderId.isEmpty() ? RootAlias : d->rootFolderId;
+}
+
+void PathIndex::setRootFolderId(const QString &folderId)
+{
+    d->adoptRoot(folderId);
+}
+
+void PathIndex::insert(const FilePtr &file)
+{
+    if (!file || file->id().isEmpty()) {
+        return;
+    }
+
+    d->removeNode(file->id());
+    if (file->labels() && file->labels()->trashed()) {
+        return;
+    }
+
+    Node node;
+    node.title = file->title();
+    node.folder = file->isFolder();
+    const auto parents = file->parents();
+    for (const auto &parent : parents) {
+        if (parent->isRoot()) {
+            d->adoptRoot(parent->id());
+        }
+        const QString parentId = d->folderId(parent->id());
+        node.parents << parentId;
+        d->children[parentId].insert(node.title, file->id());
+
+        auto missingIt = d->missing.find(parentId);
+        if (missingIt != d->missing.end()) {
+            missingIt->remove(node.title);
+            if (missingIt->isEmpty()) {
+                d->missing.erase(missingIt);
+            }
+        }
+    }
+    d->nodes.insert(file->id(), node);
+}
+
+void PathIndex::remove(const QString &fileId)
+{
+    d->removeNode(fileId);
+    // The content of a removed folder can't be reached through it anymore
+    d->missing.remove(fileId);
+    d->listedFolders.remove(fileId);
+}
+
+void PathIndex::applyChanges(const ChangesList &changes)
+{
+    for (const auto &change : changes) {
+        if (change->deleted() || !change->file()) {
+            remove(change->fileId());
+        } else {
+            insert(change->file());
+        }
+    }
+}
+
+void PathIndex::insertMissing(const QString &folderId, const QString &title)
+{
+    d->missing[d->folderId(folderId)].insert(title);
+}
+
+void PathIndex::setFolderListed(const QString &folderId)
+{
+    d->listedFolders.insert(d->folderId(folderId));
+}
+
+void PathIndex::clear()
+{
+    d->rootFolderId.clear();
+    d->nodes.clear();
+    d->children.clear();
+    d->missing.clear();
+    d->listedFolders.clear();
+}
+
+bool PathIndex::contains(const QString &fileId) const
+{
+    return d->nodes.contains(fileId);
+}
+
+QStringList PathIndex::children(const QString &folderId) const
+{
+    return d->children.value(d->folderId(folderId)).values();
+}
+
+PathIndex::Lookup PathIndex::lookup(const QString &folderId, const QString &title, QString *fileId) const
+{
+    const QString parentId = d->folderId(folderId);
+    const auto childrenIt = d->children.constFind(parentId);
+    if (childrenIt != d->children.cend()) {
+        QString found;
+        for (auto it = childrenIt->constFind(title), end = childrenIt->cend(); it != end && it.key() == title; ++it) {
+            if (found.isEmpty()) {
+                found = it.value();
+            }
+            if (d->nodes.value(it.value()).folder) {
+                found = it.value();
+                break;
+            }
+        }
+        if (!found.isEmpty()) {
+            if (fileId) {
+                *fileId = found;
+            }
+            return Found;
+        }
+    }
+
+    if (d->listedFolders.contains(parentId) || d->missing.value(parentId).contains(title)) {
+        return NotFound;
+    }
+    return Unknown;
+}
+
+PathIndex::Lookup PathIndex::resolve(const QString &path, QString *fileId, int *resolvedDepth) const
+{
+    QString current = rootFolderId();
+    const QStringList titles = splitPath(path);
+    int depth = 0;
+    for (const auto &title : titles) {
+        QString child;
+        const Lookup result = lookup(current, title, &child);
+        if (result != Found) {
+            if (fileId) {
+                *fileId = current;
+            }
+            if (resolvedDepth) {
+                *resolvedDepth = depth;
+            }
+            return result;
+        }
+        current = child;
+        ++depth;
+    }
+
+    if (fileId) {
+        *fileId = current;
+    }
+    if (resolvedDepth) {
+        *resolvedDepth = depth;
+    }
+    return Found;
+}
+
+QString PathIndex::path(const QString &fileId) const
+{
+    const QString rootId = rootFolderId();
+    QStringList titles;
+    QSet<QString> visited;
+    QString id = d->folderId(fileId);
+    while (id != rootId) {
+        const auto it = d->nodes.constFind(id);
+        if (it == d->nodes.cend() || it->parents.isEmpty() || visited.contains(id)) {
+            return QString();
+        }
+        visited.insert(id);
+        titles.prepend(it->title);
+        id = it->parents.constFirst();
+    }
+
+    return QLatin1Char('/') + titles.join(QLatin1Char('/'));
+}
+
+QStringList PathIndex::splitPath(const QString &path)
+{
+    return path.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @headerfile pathindex.h
+ * @brief An index of parent folders of files to resolve paths locally
+ *
+ * Drive addresses files by their ID and a file only knows its parent
+ * folders, so resolving a path like "/Projects/2026/report.pdf" normally
+ * requires a search for each component of the path. The index remembers the
+ * titles and parents of files it has seen, so that resolving a path or
+ * computing the path of a file only takes as many hash lookups as there are
+ * components of the path.
+ *
+ * Besides files that exist, the index remembers titles that have been
+ * searched for and not found, and folders whose content has been listed
+ * completely, so that looking up a missing file does not need a request
+ * either. Both are invalidated when a matching file is inserted, for example
+ * by applyChanges().
+ *
+ * Titles of files in Drive do not need to be unique. When a folder contains
+ * more files with the same title, folders are preferred, otherwise the most
+ * recently inserted file is used.
+ *
+ * The root folder of My Drive can be referred to as "root" until its real ID
+ * is known.
+ *
+ * @see PathResolveJob
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT PathIndex
+{
+public:
+    enum Lookup {
+        Found, ///< The file exists
+        NotFound, ///< The file is known not to exist
+        Unknown, ///< The index does not know whether the file exists
+    };
+
+    PathIndex();
+    ~PathIndex();
+
+    /**
+     * @brief Returns ID of the root folder of My Drive, or "root" if not known yet
+     */
+    [[nodiscard]] QString rootFolderId() const;
+    void setRootFolderId(const QString &folderId);
+
+    /**
+     * @brief Adds or updates title and parents of @p file
+     *
+     * Trashed files are removed from the index instead.
+     */
+    void insert(const FilePtr &file);
+
+    /**
+     * @brief Removes the file @p fileId from the index
+     */
+    void remove(const QString &fileId);
+
+    /**
+     * @brief Updates the index with files added, modified or removed by @p changes
+     */
+    void applyChanges(const ChangesList &changes);
+
+    /**
+     * @brief Remembers that the folder @p folderId has no file called @p title
+     */
+    void insertMissing(const QString &folderId, const QString &title);
+
+    /**
+     * @brief Remembers that all files in the folder @p folderId have been inserted
+     *
+     * Titles that are not in the folder are then reported as NotFound.
+     */
+    void setFolderListed(const QString &folderId);
+
+    /**
+     * @brief Removes everything from the index
+     */
+    void clear();
+
+    [[nodiscard]] bool contains(const QString &fileId) const;
+
+    /**
+     * @brief Returns IDs of the files in the folder @p folderId
+     */
+    [[nodiscard]] QStringList children(const QString &folderId) const;
+
+    /**
+     * @brief Looks up the file called @p title in the folder @p folderId
+     */
+    [[nodiscard]] Lookup lookup(const QString &folderId, const QString &title, QString *fileId = nullptr) const;
+
+    /**
+     * @brief Resolves @p path, relative to the root folder, into ID of a file
+     *
+     * When the result is Unknown, @p resolvedDepth is set to the number of
+     * leading components of the path that have been resolved and @p fileId to
+     * the ID of the last of them, so that the rest can be looked up on the
+     * server.
+     */
+    [[nodiscard]] Lookup resolve(const QString &path, QString *fileId = nullptr, int *resolvedDepth = nullptr) const;
+
+    /**
+     * @brief Returns path of the file @p fileId from the root folder
+     *
+     * When a file has more parents, the first one is used. Returns an empty
+     * string when the path is not known.
+     */
+    [[nodiscard]] QString path(const QString &fileId) const;
+
+    /**
+     * @brief Splits @p path into titles of its components
+     */
+    [[nodiscard]] static QStringList splitPath(const QString &path);
+
+private:
+    Q_DISABLE_COPY(PathIndex)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,146 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "pathresolvejob.h"
+#include "debug.h"
+#include "file.h"
+#include "filefetchjob.h"
+#include "filesearchquery.h"
+#include "pathindex.h"
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+class Q_DECL_HIDDEN PathResolveJob::Private
+{
+public:
+    Private(PathResolveJob *parent);
+
+    void resolveNext();
+    void fetchChild(const QString &folderId, const QString &title);
+
+    QString path;
+    PathIndex *index = nullptr;
+    QString fileId;
+
+private:
+    PathResolveJob *const q;
+};
+
+PathResolveJob::Private::Private(PathResolveJob *parent)
+    : q(parent)
+{
+}
+
+void PathResolveJob::Private::resolveNext()
+{
+    QString resolvedId;
+    int depth = 0;
+    switch (index->resolve(path, &resolvedId, &depth)) {
+    case PathIndex::Found:
+        fileId = resolvedId;
+        q->emitFinished();
+        return;
+    case PathIndex::NotFound:
+        qCDebug(KGAPIDebug) << path << "does not exist";
+        q->emitFinished();
+        return;
+    case PathIndex::Unknown:
+        fetchChild(resolvedId, PathIndex::splitPath(path).at(depth));
+        return;
+    }
+}
+
+void PathResolveJob::Private::fetchChild(const QString &folderId, const QString &title)
+{
+    FileSearchQuery query;
+    query.addQuery(FileSearchQuery::Title, FileSearchQuery::Equals, title);
+    query.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, folderId);
+    query.addQuery(FileSearchQuery::Trashed, FileSearchQuery::Equals, false);
+
+    auto job = new FileFetchJob(query, q->account(), q);
+    job->setFields({File::Fields::Id, File::Fields::Title, File::Fields::MimeType, File::Fields::Labels, File::Fields::Parents});
+    QObject::connect(job, &Job::finished, q, [this, job, folderId, title]() {
+        job->deleteLater();
+        if (job->error() != KGAPI2::NoError) {
+            q->setError(job->error());
+            q->setErrorString(job->errorString());
+            q->emitFinished();
+            return;
+        }
+
+        const auto items = job->items();
+        for (const auto &item : items) {
+            index->insert(item.dynamicCast<File>());
+        }
+        // Also when the server matched titles differently than the index does,
+        // otherwise the same search would be repeated forever
+        if (index->lookup(folderId, title) != PathIndex::Found) {
+            index->insertMissing(folderId, title);
+        }
+        resolveNext();
+    });
+}
+
+PathResolveJob::PathResolveJob(const QString &path, PathIndex *index, const AccountPtr &account, QObject *parent)
+    : Job(account, parent)
+    , d(new Private(this))
+{
+    d->path = path;
+    d->index = index;
+}
+
+PathResolveJob::~PathResolveJob() = default;
+
+QString PathResolveJob::path() const
+{
+    return d->path;
+}
+
+PathIndex *PathResolveJob::index() const
+{
+    return d->index;
+}
+
+QString PathResolveJob::fileId() const
+{
+    return d->fileId;
+}
+
+void PathResolveJob::start()
+{
+    d->fileId.clear();
+
+    if (!d->index) {
+        qCWarning(KGAPIDebug) << "No index to resolve" << d->path << "with";
+        emitFinished();
+        return;
+    }
+
+    d->resolveNext();
+}
+
+void PathResolveJob::dispatchRequest(QNetworkAccessManager *accessManager,
+                                     const QNetworkRequest &request,
+                                     const QByteArray &data,
+                                     const QString &contentType)
+{
+    // All requests are sent by the file fetch jobs
+    Q_UNUSED(accessManager)
+    Q_UNUSED(request)
+    Q_UNUSED(data)
+    Q_UNUSED(contentType)
+}
+
+void PathResolveJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    Q_UNUSED(reply)
+    Q_UNUSED(rawData)
+}
+
+#include "moc_pathresolvejob.cpp"
@@ -0,0 +1,69 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "job.h"
+#include "kgapidrive_export.h"
+
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+class PathIndex;
+
+/**
+ * @headerfile pathresolvejob.h
+ * @brief A job to resolve a path into ID of a file
+ *
+ * The job resolves as much of the path as possible from the PathIndex and
+ * only searches for the remaining components on the server, one request per
+ * component. Files that are found are inserted into the index and titles that
+ * are not found are remembered as missing, so that resolving the same or a
+ * similar path again needs no requests at all.
+ *
+ * The job does not take ownership of the index, which must exist until the
+ * job finishes. Keep the index up to date by passing changes of files to
+ * PathIndex::applyChanges().
+ *
+ * @since 6.1
+ */
+class KGAPIDRIVE_EXPORT PathResolveJob : public KGAPI2::Job
+{
+    Q_OBJECT
+
+public:
+    explicit PathResolveJob(const QString &path, PathIndex *index, const AccountPtr &account, QObject *parent = nullptr);
+    ~PathResolveJob() override;
+
+    [[nodiscard]] QString path() const;
+    [[nodiscard]] PathIndex *index() const;
+
+    /**
+     * @brief Returns ID of the file at path(), or an empty string when there is none
+     */
+    [[nodiscard]] QString fileId() const;
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
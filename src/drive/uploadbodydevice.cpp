@@ -0,0 +1,115 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "uploadbodydevice_p.h"
+#include "debug.h"
+
+#include <QFileInfo>
+
+#include <cstring>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+UploadBodyDevice::UploadBodyDevice(const QByteArray &header, const QString &filePath, const QByteArray &footer, QObject *parent)
+    : QIODevice(parent)
+    , mHeader(header)
+    , mFile(filePath)
+    , mFooter(footer)
+{
+}
+
+UploadBodyDevice::~UploadBodyDevice() = default;
+
+qint64 UploadBodyDevice::bodySize(const QByteArray &header, const QString &filePath, const QByteArray &footer)
+{
+    const QFileInfo info(filePath);
+    if (!info.isFile() || !info.isReadable()) {
+        return -1;
+    }
+    return header.size() + info.size() + footer.size();
+}
+
+bool UploadBodyDevice::open(OpenMode mode)
+{
+    if (mode & WriteOnly) {
+        qCWarning(KGAPIDebug) << "Upload body can only be opened for reading";
+        return false;
+    }
+    if (!mFile.open(QIODevice::ReadOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to open" << mFile.fileName() << ":" << mFile.errorString();
+        setErrorString(mFile.errorString());
+        return false;
+    }
+
+    mFileSize = mFile.size();
+    mOffset = 0;
+    // The network stack buffers the body on its own, there is no need to buffer it here as well
+    return QIODevice::open(mode | Unbuffered);
+}
+
+void UploadBodyDevice::close()
+{
+    mFile.close();
+    QIODevice::close();
+}
+
+bool UploadBodyDevice::isSequential() const
+{
+    return false;
+}
+
+qint64 UploadBodyDevice::size() const
+{
+    return mHeader.size() + mFileSize + mFooter.size();
+}
+
+bool UploadBodyDevice::seek(qint64 pos)
+{
+    if (pos < 0 || pos > size() || !QIODevice::seek(pos)) {
+        return false;
+    }
+
+    mOffset = pos;
+    return mFile.seek(qBound<qint64>(0, pos - mHeader.size(), mFileSize));
+}
+
+qint64 UploadBodyDevice::readData(char *data, qint64 maxSize)
+{
+    qint64 read = 0;
+    while (read < maxSize && mOffset < size()) {
+        const qint64 fileEnd = mHeader.size() + mFileSize;
+        qint64 chunk = 0;
+        if (mOffset < mHeader.size()) {
+            chunk = qMin(maxSize - read, mHeader.size() - mOffset);
+            std::memcpy(data + read, mHeader.constData() + mOffset, chunk);
+        } else if (mOffset < fileEnd) {
+            chunk = mFile.read(data + read, qMin(maxSize - read, fileEnd - mOffset));
+            if (chunk <= 0) {
+                // The file has been truncated since the size of the body was announced
+                qCWarning(KGAPIDebug) << "Failed to read" << mFile.fileName() << ":" << mFile.errorString();
+                setErrorString(mFile.errorString());
+                return read > 0 ? read : -1;
+            }
+        } else {
+            chunk = qMin(maxSize - read, size() - mOffset);
+            std::memcpy(data + read, mFooter.constData() + (mOffset - fileEnd), chunk);
+        }
+        read += chunk;
+        mOffset += chunk;
+    }
+
+    return read;
+}
+
+qint64 UploadBodyDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI authors
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * Body of an upload request, the content of a file enclosed by a header
+ * and a footer, e.g. the parts of a multipart/related body.
+ *
+ * The file is read in small blocks as the body is being sent, so memory
+ * used by the upload does not grow with the size of the file. The size of
+ * the body is known upfront, so it can be sent with Content-Length, and
+ * the device can be rewound when the request needs to be sent again.
+ */
+class Q_DECL_HIDDEN UploadBodyDevice : public QIODevice
+{
+public:
+    UploadBodyDevice(const QByteArray &header, const QString &filePath, const QByteArray &footer, QObject *parent = nullptr);
+    ~UploadBodyDevice() override;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override;
+    qint64 size() const override;
+    bool seek(qint64 pos) override;
+
+    /**
+     * Size of the body of an upload of @p filePath, -1 when the file can't be accessed
+     */
+    static qint64 bodySize(const QByteArray &header, const QString &filePath, const QByteArray &footer);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    const QByteArray mHeader;
+    QFile mFile;
+    const QByteArray mFooter;
+    qint64 mFileSize = 0;
+    qint64 mOffset = 0;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -68,6 +68,7 @@ void ContactGroupFetchJob::start()
     QUrl url;
     if (d->resourceName.isEmpty()) {
         url = PeopleService::fetchAllContactGroupsUrl();
+        enablePipelinedPagination();
     } else {
         url = PeopleService::fetchContactGroupUrl(d->resourceName);
     }
@@ -101,10 +102,8 @@ ObjectsList ContactGroupFetchJob::handleReplyWithItems(const QNetworkReply *repl
     }
 
     if (feedData.nextPageUrl.isValid()) {
+        // The next page has already been requested by FetchJob
         emitProgress(feedData.startIndex, feedData.totalResults);
-
-        const auto request = d->createRequest(feedData.nextPageUrl);
-        enqueueRequest(request);
     } else {
         emitFinished();
     }
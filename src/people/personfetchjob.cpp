@@ -60,6 +60,7 @@ void PersonFetchJob::Private::startFetch()
     QUrl url;
     if (personResourceName.isEmpty()) {
         url = PeopleService::fetchAllContactsUrl(syncToken);
+        q->enablePipelinedPagination();
     } else {
         url = PeopleService::fetchContactUrl(personResourceName);
     }
@@ -85,10 +86,8 @@ ObjectsList PersonFetchJob::Private::processReceivedData(const QByteArray &rawDa
     }
 
     if (feedData.nextPageUrl.isValid()) {
+        // The next page has already been requested by FetchJob
         q->emitProgress(feedData.startIndex, feedData.totalResults);
-
-        const QNetworkRequest request = createRequest(feedData.nextPageUrl);
-        q->enqueueRequest(request);
     } else {
         receivedSyncToken = feedData.syncToken;
         q->emitFinished();
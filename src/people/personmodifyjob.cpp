@@ -91,7 +91,7 @@ void PersonModifyJob::dispatchRequest(QNetworkAccessManager *accessManager,
         r.setRawHeader("If-Match", "*");
     }
 
-    accessManager->sendCustomRequest(r, "PATCH", data);
+    accessManager->sendCustomRequest(r, "PATCH", compressRequestBody(r, data));
 }
 
 ObjectsList PersonModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
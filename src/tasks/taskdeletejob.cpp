@@ -69,11 +69,14 @@ void TaskDeleteJob::start()
         return;
     }
 
-    const QString taskId = d->tasksIds.current();
-    const QUrl url = TasksService::removeTaskUrl(d->taskListId, taskId);
-    QNetworkRequest request(url);
+    setBatchUrl(TasksService::batchUrl());
+    while (d->tasksIds.hasUnqueued()) {
+        const QString taskId = d->tasksIds.takeUnqueued();
+        const QUrl url = TasksService::removeTaskUrl(d->taskListId, taskId);
+        QNetworkRequest request(url);
 
-    enqueueRequest(request);
+        enqueueRequest(request);
+    }
 }
 
 void TaskDeleteJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
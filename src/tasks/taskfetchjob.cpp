@@ -189,6 +189,7 @@ void TaskFetchJob::start()
             query.addQueryItem(DueMaxParam, Utils::ts2Str(d->dueMax));
         }
         url.setQuery(query);
+        enablePipelinedPagination();
     } else {
         url = TasksService::fetchTaskUrl(d->taskListId, d->taskId);
     }
@@ -206,7 +207,9 @@ ObjectsList TaskFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
     ContentType ct = Utils::stringToContentType(contentType);
     if (ct == KGAPI2::JSON) {
-        if (d->taskId.isEmpty()) {
+        if (d->taskId.isEmpty() && parseInThreadPool()) {
+            parseItemsInThreadPool(reply, rawData, &TasksService::parseJSONFeed);
+        } else if (d->taskId.isEmpty()) {
             items = TasksService::parseJSONFeed(rawData, feedData);
         } else {
             items << TasksService::JSONToTask(rawData);
@@ -218,11 +221,6 @@ ObjectsList TaskFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
         return items;
     }
 
-    if (feedData.nextPageUrl.isValid()) {
-        const QNetworkRequest request(feedData.nextPageUrl);
-        enqueueRequest(request);
-    }
-
     return items;
 }
 
@@ -39,18 +39,20 @@ void TaskListDeleteJob::Private::processNextTaskList()
         return;
     }
 
-    const QString taskListId = taskListsIds.current();
-    const QUrl url = TasksService::removeTaskListUrl(taskListId);
-    QNetworkRequest request(url);
-
-    QStringList headers;
-    const auto rawHeaderList = request.rawHeaderList();
-    headers.reserve(rawHeaderList.size());
-    for (const QByteArray &str : std::as_const(rawHeaderList)) {
-        headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
+    while (taskListsIds.hasUnqueued()) {
+        const QString taskListId = taskListsIds.takeUnqueued();
+        const QUrl url = TasksService::removeTaskListUrl(taskListId);
+        QNetworkRequest request(url);
+
+        QStringList headers;
+        const auto rawHeaderList = request.rawHeaderList();
+        headers.reserve(rawHeaderList.size());
+        for (const QByteArray &str : std::as_const(rawHeaderList)) {
+            headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
+        }
+
+        q->enqueueRequest(request);
     }
-
-    q->enqueueRequest(request);
 }
 
 TaskListDeleteJob::TaskListDeleteJob(const TaskListPtr &taskList, const AccountPtr &account, QObject *parent)
@@ -88,6 +90,7 @@ TaskListDeleteJob::~TaskListDeleteJob() = default;
 
 void TaskListDeleteJob::start()
 {
+    setBatchUrl(TasksService::batchUrl());
     d->processNextTaskList();
 }
 
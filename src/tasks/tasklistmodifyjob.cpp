@@ -46,21 +46,24 @@ void TaskListModifyJob::start()
         return;
     }
 
-    const TaskListPtr taskList = d->taskLists.current();
+    setBatchUrl(TasksService::batchUrl());
+    while (d->taskLists.hasUnqueued()) {
+        const TaskListPtr taskList = d->taskLists.takeUnqueued();
 
-    const QUrl url = TasksService::updateTaskListUrl(taskList->uid());
-    QNetworkRequest request(url);
+        const QUrl url = TasksService::updateTaskListUrl(taskList->uid());
+        QNetworkRequest request(url);
 
-    const QByteArray rawData = TasksService::taskListToJSON(taskList);
+        const QByteArray rawData = TasksService::taskListToJSON(taskList);
 
-    QStringList headers;
-    const auto rawHeaderList = request.rawHeaderList();
-    headers.reserve(rawHeaderList.size());
-    for (const QByteArray &str : std::as_const(rawHeaderList)) {
-        headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
-    }
+        QStringList headers;
+        const auto rawHeaderList = request.rawHeaderList();
+        headers.reserve(rawHeaderList.size());
+        for (const QByteArray &str : std::as_const(rawHeaderList)) {
+            headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
+        }
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList TaskListModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
@@ -49,20 +49,23 @@ void TaskModifyJob::start()
         return;
     }
 
-    const TaskPtr task = d->tasks.current();
-    const QUrl url = TasksService::updateTaskUrl(d->taskListId, task->uid());
-    QNetworkRequest request(url);
-
-    const QByteArray rawData = TasksService::taskToJSON(task);
-
-    QStringList headers;
-    const auto rawHeaderList = request.rawHeaderList();
-    headers.reserve(rawHeaderList.size());
-    for (const QByteArray &str : std::as_const(rawHeaderList)) {
-        headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
+    setBatchUrl(TasksService::batchUrl());
+    while (d->tasks.hasUnqueued()) {
+        const TaskPtr task = d->tasks.takeUnqueued();
+        const QUrl url = TasksService::updateTaskUrl(d->taskListId, task->uid());
+        QNetworkRequest request(url);
+
+        const QByteArray rawData = TasksService::taskToJSON(task);
+
+        QStringList headers;
+        const auto rawHeaderList = request.rawHeaderList();
+        headers.reserve(rawHeaderList.size());
+        for (const QByteArray &str : std::as_const(rawHeaderList)) {
+            headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
+        }
+
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
     }
-
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
 }
 
 ObjectsList TaskModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
@@ -323,6 +323,13 @@ ObjectsList Private::parseTasksJSONFeed(const QVariantList &items)
     return list;
 }
 
+QUrl batchUrl()
+{
+    QUrl url(Private::GoogleApisUrl);
+    url.setPath(QStringLiteral("/batch/tasks/v1"));
+    return url;
+}
+
 } // namespace TasksService
 
 } // namespace KGAPI2
@@ -128,6 +128,13 @@ KGAPITASKS_EXPORT QUrl updateTaskListUrl(const QString &tasklistID);
  */
 KGAPITASKS_EXPORT QUrl removeTaskListUrl(const QString &tasklistID);
 
+/**
+ * @brief Returns URL of the Tasks API batch endpoint.
+ *
+ * @since 6.1
+ */
+KGAPITASKS_EXPORT QUrl batchUrl();
+
 } /* namespace TasksServices */
 
 } /* namespace KGAPI2 */